@@ -50,7 +50,7 @@ namespace Athena
         m_EditorCtx->ActiveScene = m_EditorScene;
 
         m_ViewportRenderer = SceneRenderer::Create();
-        m_Renderer2D = SceneRenderer2D::Create(m_ViewportRenderer->GetRender2DPass());
+        m_Renderer2D = SceneRenderer2D::Create(m_ViewportRenderer->GetRender2DPass(), m_ViewportRenderer->GetRender2DCommandBuffer());
 
         m_ViewportRenderer->SetOnRender2DCallback(
             [this]() { OnRender2D(); });
@@ -309,7 +309,7 @@ namespace Athena
                             if (target.HasComponent<SpriteComponent>())
                             {
                                 auto& sprite = target.GetComponent<SpriteComponent>();
-                                sprite.Texture = TextureImporter::Load(path, true);
+                                sprite.Texture = TextureImporter::LoadAsync(path, true);
                                 sprite.Color = LinearColor::White;
                                 m_EditorCtx->SelectedEntity = target;
                             }
@@ -318,7 +318,7 @@ namespace Athena
                     // Mesh Drag/Drop
                     else if (m_EditorCtx->SceneState == SceneState::Edit && (ext == ".obj\0" || ext == ".fbx" || ext == ".x3d" || ext == ".gltf" || ext == ".blend"))
                     {
-                        Ref<StaticMesh> mesh = StaticMesh::Create(path);
+                        Ref<StaticMesh> mesh = StaticMesh::CreateAsync(path);
                         if (mesh)
                         {
                             Entity entity = m_EditorCtx->ActiveScene->CreateEntity();
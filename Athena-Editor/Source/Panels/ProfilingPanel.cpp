@@ -1,6 +1,8 @@
 #include "ProfilingPanel.h"
 
+#include "Athena/Asset/TextureCache.h"
 #include "Athena/Core/Application.h"
+#include "Athena/Renderer/TextureStreamer.h"
 #include "Athena/UI/UI.h"
 #include "Athena/Utils/StringUtils.h"
 
@@ -131,6 +133,68 @@ namespace Athena
                             ImGui::Text("Draws saved(by instancing): %u", stats.Meshes - stats.Instances);
                             ImGui::Spacing();
                             ImGui::Text("AnimMeshes: %u", stats.AnimMeshes);
+                            ImGui::Spacing();
+                            ImGui::Text("Culled Meshes: %u", stats.CulledMeshes);
+                            ImGui::Text("Culled AnimMeshes: %u", stats.CulledAnimMeshes);
+                            ImGui::Spacing();
+                            ImGui::Text("Shadow Casters(all cascades): %u", stats.ShadowCasters);
+                            ImGui::Text("Culled Shadow Casters: %u", stats.CulledShadowCasters);
+
+                            UI::TreePop();
+                        }
+
+                        if (UI::TreeNode("Memory Statistics", false))
+                        {
+                            ImGui::Text("Dynamic Buffers: %s", Utils::MemoryBytesToString(stats.DynamicBuffersMemory).data());
+                            ImGui::Text("Dynamic Buffers Upload: %s/frame", Utils::MemoryBytesToString(stats.DynamicBuffersUpload).data());
+                            ImGui::Text("Cached Textures: %d", TextureCache::GetTexturesCount());
+
+                            UI::TreePop();
+                        }
+
+                        if (UI::TreeNode("Texture Streaming", false))
+                        {
+                            TextureStreamingStats streamingStats = TextureStreamer::GetStats();
+                            ImGui::Text("Budget: %s", Utils::MemoryBytesToString(streamingStats.Budget).data());
+                            ImGui::Text("Resident: %s", Utils::MemoryBytesToString(streamingStats.ResidentMemory).data());
+                            ImGui::Text("Requested: %s", Utils::MemoryBytesToString(streamingStats.RequestedMemory).data());
+                            ImGui::Text("Textures: %u", streamingStats.TexturesCount);
+                            ImGui::Text("Pending Loads: %u", streamingStats.PendingLoads);
+                            ImGui::Text("Mip Bias: %u", streamingStats.MipBias);
+                            ImGui::Spacing();
+
+                            std::vector<StreamedTextureInfo> textures;
+                            TextureStreamer::GetTexturesInfo(textures);
+
+                            ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+                            if (!textures.empty() && ImGui::BeginTable("StreamedTextures", 4, tableFlags, { 0, 300 }))
+                            {
+                                ImGui::TableSetupScrollFreeze(0, 1);
+                                ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+                                ImGui::TableSetupColumn("Resident");
+                                ImGui::TableSetupColumn("Requested");
+                                ImGui::TableSetupColumn("Memory");
+                                ImGui::TableHeadersRow();
+
+                                for (const auto& info : textures)
+                                {
+                                    ImGui::TableNextRow();
+
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%s", info.Name.c_str());
+
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%u (%ux%u)", info.ResidentMip, Math::Max(info.Size.x >> info.ResidentMip, 1u), Math::Max(info.Size.y >> info.ResidentMip, 1u));
+
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%u (%ux%u)", info.RequestedMip, Math::Max(info.Size.x >> info.RequestedMip, 1u), Math::Max(info.Size.y >> info.RequestedMip, 1u));
+
+                                    ImGui::TableNextColumn();
+                                    ImGui::Text("%s", Utils::MemoryBytesToString(info.ResidentMemory).data());
+                                }
+
+                                ImGui::EndTable();
+                            }
 
                             UI::TreePop();
                         }
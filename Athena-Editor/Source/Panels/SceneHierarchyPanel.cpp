@@ -369,7 +369,7 @@ namespace Athena
 				FilePath path = FileDialogs::OpenFile(TEXT("Texture\0*.png;*.jpg\0"));
 				if (!path.empty())
 				{
-					texture = TextureImporter::Load(path, texName == "u_Albedo" ? true : false);
+					texture = TextureImporter::LoadAsync(path, texName == "u_Albedo" ? true : false);
 					mat->Set(texName, texture);
 					mat->Set(useTexName, (uint32)true);
 				}
@@ -620,7 +620,7 @@ namespace Athena
 					FilePath path = (const char*)payload->Data;
 					if (path.extension() == ".png\0")
 					{
-						sprite.Texture = TextureImporter::Load(FilePath(path), true);
+						sprite.Texture = TextureImporter::LoadAsync(FilePath(path), true);
 						sprite.Color = LinearColor::White;
 					}
 				}
@@ -634,7 +634,7 @@ namespace Athena
 				FilePath path = FileDialogs::OpenFile(TEXT("Texture \0*.png;*.jpg\0"));
 				if (!path.empty())
 				{
-					sprite.Texture = TextureImporter::Load(path, true);
+					sprite.Texture = TextureImporter::LoadAsync(path, true);
 					sprite.Color = LinearColor::White;
 				}
 			}
@@ -820,6 +820,8 @@ namespace Athena
 			String meshFilename = meshComponent.Mesh->GetFilePath().filename().string();
 
 			String name = meshComponent.Mesh->GetFilePath().filename().string();
+			if (meshComponent.Mesh->IsLoading())
+				name += " (Loading)";
 
 			UI::PropertyRow("Mesh", ImGui::GetFrameHeight() + 2);
 			ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, { 10, 4 });
@@ -828,7 +830,10 @@ namespace Athena
 				FilePath filepath = FileDialogs::OpenFile(TEXT("Mesh \0*.fbx;*.gltf;*.obj;*.blend;*.x3d\0"));
 				String ext = filepath.extension().string();
 				if (!filepath.empty())
-					meshComponent.Mesh = StaticMesh::Create(filepath);
+				{
+					meshComponent.Mesh = StaticMesh::CreateAsync(filepath);
+					entity.PatchComponent<StaticMeshComponent>();
+				}
 			}
 
 			ImGui::PopStyleVar();
@@ -840,12 +845,16 @@ namespace Athena
 					FilePath filepath = (const char*)payload->Data;
 					String ext = filepath.extension().string();
 					if (ext == ".obj\0" || ext == ".fbx" || ext == ".x3d" || ext == ".gltf" || ext == ".blend")
-						meshComponent.Mesh = StaticMesh::Create(filepath);
+					{
+						meshComponent.Mesh = StaticMesh::CreateAsync(filepath);
+						entity.PatchComponent<StaticMeshComponent>();
+					}
 				}
 				ImGui::EndDragDropTarget();
 			}
 
-			UI::PropertyCheckbox("Visible", &meshComponent.Visible);
+			if (UI::PropertyCheckbox("Visible", &meshComponent.Visible))
+				entity.PatchComponent<StaticMeshComponent>();
 			UI::EndPropertyTable();
 
 			Ref<Animator> animator = meshComponent.Mesh->GetAnimator();
@@ -974,6 +983,14 @@ namespace Athena
 				envMap->SetResolution(resolution);
 			}
 
+			std::string_view irradianceModes[] = { "Cubemap", "SH" };
+			std::string_view irradianceMode = irradianceModes[envMap->GetIrradianceMode() == EnvironmentIrradianceMode::SPHERICAL_HARMONICS ? 1 : 0];
+
+			if (UI::PropertyCombo("Irradiance", irradianceModes, std::size(irradianceModes), &irradianceMode))
+			{
+				envMap->SetIrradianceMode(irradianceMode == "SH" ? EnvironmentIrradianceMode::SPHERICAL_HARMONICS : EnvironmentIrradianceMode::CUBEMAP);
+			}
+
 			std::string_view typesStrings[] = { "Static", "Preetham"};
 			std::string_view type = typeToStr(envMap->GetType());
 
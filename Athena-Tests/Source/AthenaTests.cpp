@@ -0,0 +1,93 @@
+#include "Athena/Core/Application.h"
+#include "Athena/Scene/Components.h"
+#include "Athena/Scene/Entity.h"
+#include "Athena/Scene/Scene.h"
+
+#include "TestCommon.h"
+
+using namespace Athena;
+
+
+// Play mode copy must not write changes back into editor scene
+static void SceneCopyIsIndependent()
+{
+	Ref<Scene> scene = Ref<Scene>::Create();
+
+	Entity sky = scene->CreateEntity("Sky");
+	auto& skyLight = sky.AddComponent<SkyLightComponent>();
+	skyLight.EnvironmentMap->SetPreethamParams(2.f, 0.5f, 0.5f);
+
+	Entity cube = scene->CreateEntity("Cube");
+	auto& meshComponent = cube.AddComponent<StaticMeshComponent>();
+	meshComponent.Mesh = StaticMesh::Create("Assets/Meshes/Cube.obj");
+	ATN_TEST_CHECK(meshComponent.Mesh && !meshComponent.Mesh->GetAllSubMeshes().empty());
+	if (!meshComponent.Mesh || meshComponent.Mesh->GetAllSubMeshes().empty())
+		return;
+
+	const String& materialName = meshComponent.Mesh->GetAllSubMeshes()[0].MaterialName;
+	Ref<Material> material = meshComponent.Mesh->GetMaterialTable()->Get(materialName);
+	material->Set("u_Roughness", 0.25f);
+
+	Ref<Scene> copy = Scene::Copy(scene);
+
+	// Edit copy
+	Entity skyCopy = copy->GetEntityByUUID(sky.GetID());
+	const auto& envMapCopy = skyCopy.GetComponent<SkyLightComponent>().EnvironmentMap;
+	envMapCopy->SetPreethamParams(8.f, 1.f, 1.f);
+	envMapCopy->SetIrradianceMode(EnvironmentIrradianceMode::SPHERICAL_HARMONICS);
+
+	Entity cubeCopy = copy->GetEntityByUUID(cube.GetID());
+	const auto& meshCopy = cubeCopy.GetComponent<StaticMeshComponent>().Mesh;
+	Ref<Material> materialCopy = meshCopy->GetMaterialTable()->Get(materialName);
+	materialCopy->Set("u_Roughness", 0.75f);
+
+	// Original is unchanged
+	const auto& envMap = skyLight.EnvironmentMap;
+	ATN_TEST_CHECK(envMap != envMapCopy);
+	ATN_TEST_CHECK(envMap->GetTurbidity() == 2.f);
+	ATN_TEST_CHECK(envMap->GetAzimuth() == 0.5f);
+	ATN_TEST_CHECK(envMap->GetInclination() == 0.5f);
+	ATN_TEST_CHECK(envMap->GetIrradianceMode() == EnvironmentIrradianceMode::CUBEMAP);
+
+	ATN_TEST_CHECK(meshComponent.Mesh->GetMaterialTable() != meshCopy->GetMaterialTable());
+	ATN_TEST_CHECK(material != materialCopy);
+	ATN_TEST_CHECK(material->Get<float>("u_Roughness") == 0.25f);
+	ATN_TEST_CHECK(materialCopy->Get<float>("u_Roughness") == 0.75f);
+
+	// Geometry is still shared
+	ATN_TEST_CHECK(meshComponent.Mesh->GetAllSubMeshes()[0].VertexBuffer == meshCopy->GetAllSubMeshes()[0].VertexBuffer);
+}
+
+
+int main(int argc, char** argv)
+{
+	ApplicationCreateInfo appinfo;
+
+	appinfo.AppConfig.Name = "Athena-Tests";
+	appinfo.AppConfig.EnableImGui = false;
+	appinfo.AppConfig.EnableConsole = true;
+	appinfo.AppConfig.WorkingDirectory = ".";
+	appinfo.AppConfig.EngineResourcesPath = "../Athena/EngineResources";
+	appinfo.AppConfig.CleanCacheOnLoad = false;
+
+	appinfo.RendererConfig.API = Renderer::API::Vulkan;
+	appinfo.RendererConfig.MaxFramesInFlight = 3;
+
+	appinfo.ScriptConfig.ScriptsFolder = "Assets/Scripts";
+
+	appinfo.WindowInfo.Width = 320;
+	appinfo.WindowInfo.Height = 180;
+	appinfo.WindowInfo.Title = "Athena-Tests";
+	appinfo.WindowInfo.VSync = false;
+	appinfo.WindowInfo.StartMode = WindowMode::Default;
+	appinfo.WindowInfo.CustomTitlebar = false;
+	appinfo.WindowInfo.WindowResizeable = false;
+
+	Application* app = new Application(appinfo);
+
+	SceneCopyIsIndependent();
+
+	delete app;
+
+	return Tests::ReportResults();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <atomic>
+#include <cstdio>
+
+
+namespace Athena::Tests
+{
+	// Checks may fail on other threads
+	inline std::atomic<uint32> s_FailedChecks = 0;
+
+	inline int ReportResults()
+	{
+		if (s_FailedChecks > 0)
+		{
+			std::printf("%u checks failed\n", s_FailedChecks.load());
+			return EXIT_FAILURE;
+		}
+
+		std::printf("All tests passed\n");
+		return EXIT_SUCCESS;
+	}
+}
+
+#define ATN_TEST_CHECK(x) \
+	if (!(x)) \
+	{ \
+		std::printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #x); \
+		++::Athena::Tests::s_FailedChecks; \
+	}
@@ -0,0 +1,305 @@
+#include "Athena/Asset/TextureImporter.h"
+#include "Athena/Core/FileSystem.h"
+
+#include "UnitTests.h"
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+
+namespace Athena::Tests
+{
+	// Container files are built byte by byte from format specification.
+	// Renderer is not initialized, so BC formats are reported as unsupported.
+
+	static void WriteUInt32(std::vector<byte>& data, uint64 offset, uint32 value)
+	{
+		memcpy(data.data() + offset, &value, sizeof(value));
+	}
+
+	static void WriteUInt64(std::vector<byte>& data, uint64 offset, uint64 value)
+	{
+		memcpy(data.data() + offset, &value, sizeof(value));
+	}
+
+	// Removes file when test is finished, decoded image must be released before that
+	struct TempFile
+	{
+		TempFile(const char* name, const std::vector<byte>& contents)
+		{
+			Path = std::filesystem::temp_directory_path() / name;
+			FileSystem::WriteFile(Path, (const char*)contents.data(), contents.size());
+		}
+
+		~TempFile()
+		{
+			FileSystem::Remove(Path);
+		}
+
+		FilePath Path;
+	};
+
+	static bool DecodeBytes(const std::vector<byte>& contents, const char* name, const TextureImportOptions& options = TextureImportOptions())
+	{
+		TempFile file(name, contents);
+		DecodedImage image;
+		return TextureImporter::Decode(file.Path, options, image);
+	}
+
+	static constexpr uint32 DDSDataOffset = 4 + 124;
+
+	// RGBA8 image, mips are stored after header from largest to smallest
+	static std::vector<byte> MakeDDS(uint32 width, uint32 height, uint32 mipCount, uint64 dataSize)
+	{
+		std::vector<byte> data(DDSDataOffset + dataSize, 0);
+
+		WriteUInt32(data, 0, 0x20534444);				// 'DDS '
+		WriteUInt32(data, 4, 124);						// Size
+		WriteUInt32(data, 8, 0x1 | 0x2 | 0x4 | 0x1000 | (mipCount > 1 ? 0x20000 : 0));
+		WriteUInt32(data, 12, height);
+		WriteUInt32(data, 16, width);
+		WriteUInt32(data, 20, width * 4);				// Pitch
+		WriteUInt32(data, 28, mipCount);
+
+		WriteUInt32(data, 76, 32);						// Pixel format size
+		WriteUInt32(data, 80, 0x40 | 0x1);				// RGB + alpha
+		WriteUInt32(data, 88, 32);
+		WriteUInt32(data, 92, 0x000000FF);
+		WriteUInt32(data, 96, 0x0000FF00);
+		WriteUInt32(data, 100, 0x00FF0000);
+		WriteUInt32(data, 104, 0xFF000000);
+		WriteUInt32(data, 108, 0x1000);					// Caps texture
+
+		for (uint64 i = 0; i < dataSize; ++i)
+			data[DDSDataOffset + i] = (byte)i;
+
+		return data;
+	}
+
+	static constexpr uint32 KTX2HeaderSize = 80;
+	static constexpr uint32 KTX2LevelIndexSize = 24;
+
+	// RGBA8 image, level data is stored from smallest to largest after level index
+	static std::vector<byte> MakeKTX2(uint32 width, uint32 height, uint32 levelCount)
+	{
+		static constexpr byte identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+		uint64 dataOffset = KTX2HeaderSize + levelCount * KTX2LevelIndexSize;
+		uint64 dataSize = 0;
+		for (uint32 level = 0; level < levelCount; ++level)
+			dataSize += (uint64)Math::Max(width >> level, 1u) * Math::Max(height >> level, 1u) * 4;
+
+		std::vector<byte> data(dataOffset + dataSize, 0);
+		memcpy(data.data(), identifier, sizeof(identifier));
+
+		WriteUInt32(data, 12, 37);						// VK_FORMAT_R8G8B8A8_UNORM
+		WriteUInt32(data, 16, 1);						// Type size
+		WriteUInt32(data, 20, width);
+		WriteUInt32(data, 24, height);
+		WriteUInt32(data, 36, 1);						// Face count
+		WriteUInt32(data, 40, levelCount);
+
+		uint64 offset = data.size();
+		for (uint32 level = 0; level < levelCount; ++level)
+		{
+			uint64 levelSize = (uint64)Math::Max(width >> level, 1u) * Math::Max(height >> level, 1u) * 4;
+			offset -= levelSize;
+
+			uint64 indexOffset = KTX2HeaderSize + level * KTX2LevelIndexSize;
+			WriteUInt64(data, indexOffset, offset);
+			WriteUInt64(data, indexOffset + 8, levelSize);
+			WriteUInt64(data, indexOffset + 16, levelSize);
+		}
+
+		return data;
+	}
+
+	static void DDSMipsPointIntoFile()
+	{
+		std::vector<byte> contents = MakeDDS(4, 4, 3, 64 + 16 + 4);
+		TempFile file("AthenaUnitTest.dds", contents);
+
+		DecodedImage image;
+		ATN_TEST_CHECK(TextureImporter::Decode(file.Path, TextureImportOptions(), image));
+		ATN_TEST_CHECK(image.File && image.File->Size() == contents.size());
+		ATN_TEST_CHECK(image.Width == 4 && image.Height == 4);
+		ATN_TEST_CHECK(image.Format == TextureFormat::RGBA8);
+		ATN_TEST_CHECK(image.MipLevels == 3 && image.Mips.size() == 3);
+
+		if (image.File && image.Mips.size() == 3)
+		{
+			const byte* base = image.File->Data();
+			ATN_TEST_CHECK(image.Mips[0].data() == base + DDSDataOffset && image.Mips[0].size() == 64);
+			ATN_TEST_CHECK(image.Mips[1].data() == base + DDSDataOffset + 64 && image.Mips[1].size() == 16);
+			ATN_TEST_CHECK(image.Mips[2].data() == base + DDSDataOffset + 80 && image.Mips[2].size() == 4);
+			ATN_TEST_CHECK(memcmp(image.Mips[1].data(), contents.data() + DDSDataOffset + 64, 16) == 0);
+		}
+	}
+
+	static void DDSOptions()
+	{
+		std::vector<byte> contents = MakeDDS(4, 4, 3, 64 + 16 + 4);
+		TempFile file("AthenaUnitTest.dds", contents);
+
+		// sRGB view of UNORM data
+		{
+			TextureImportOptions options;
+			options.sRGB = true;
+
+			DecodedImage image;
+			ATN_TEST_CHECK(TextureImporter::Decode(file.Path, options, image));
+			ATN_TEST_CHECK(image.Format == TextureFormat::RGBA8_SRGB);
+		}
+
+		// Only base level is kept
+		{
+			TextureImportOptions options;
+			options.GenerateMipMaps = false;
+
+			DecodedImage image;
+			ATN_TEST_CHECK(TextureImporter::Decode(file.Path, options, image));
+			ATN_TEST_CHECK(image.MipLevels == 1 && image.Mips.size() == 1 && image.Mips[0].size() == 64);
+		}
+	}
+
+	static void DDSIncompleteMipChainUsesBaseLevel()
+	{
+		std::vector<byte> contents = MakeDDS(4, 4, 2, 64 + 16);
+		TempFile file("AthenaUnitTest.dds", contents);
+
+		DecodedImage image;
+		ATN_TEST_CHECK(TextureImporter::Decode(file.Path, TextureImportOptions(), image));
+		ATN_TEST_CHECK(image.MipLevels == 1 && image.Mips.size() == 1);
+	}
+
+	static void DDSInvalidFilesAreRejected()
+	{
+		// Last byte of smallest mip is missing
+		ATN_TEST_CHECK(!DecodeBytes(MakeDDS(4, 4, 3, 64 + 16 + 3), "AthenaUnitTest.dds"));
+
+		// Header is truncated
+		std::vector<byte> contents = MakeDDS(4, 4, 1, 64);
+		contents.resize(100);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.dds"));
+
+		// More mips than 4x4 image can have
+		ATN_TEST_CHECK(!DecodeBytes(MakeDDS(4, 4, 4, 64 + 16 + 4 + 4), "AthenaUnitTest.dds"));
+
+		ATN_TEST_CHECK(!DecodeBytes(MakeDDS(0, 4, 1, 64), "AthenaUnitTest.dds"));
+		ATN_TEST_CHECK(!DecodeBytes(MakeDDS(4, 0, 1, 64), "AthenaUnitTest.dds"));
+
+		// Huge size does not overflow range check
+		ATN_TEST_CHECK(!DecodeBytes(MakeDDS(0x80000000, 0x80000000, 1, 64), "AthenaUnitTest.dds"));
+
+		// Cube map
+		contents = MakeDDS(4, 4, 1, 64 * 6);
+		WriteUInt32(contents, 112, 0x200 | 0xFC00);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.dds"));
+
+		// Unknown pixel format
+		contents = MakeDDS(4, 4, 1, 64);
+		WriteUInt32(contents, 92, 0x00FF0000);
+		WriteUInt32(contents, 100, 0x000000FF);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.dds"));
+
+		// DX10 header with BC1, device support for BC formats is not known without renderer
+		contents = MakeDDS(4, 4, 1, 20 + 8);
+		WriteUInt32(contents, 80, 0x4);
+		WriteUInt32(contents, 84, 0x30315844);			// 'DX10'
+		WriteUInt32(contents, DDSDataOffset, 71);		// DXGI_FORMAT_BC1_UNORM
+		WriteUInt32(contents, DDSDataOffset + 4, 3);	// Texture 2D
+		WriteUInt32(contents, DDSDataOffset + 12, 1);	// Array size
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.dds"));
+
+		// DX10 header is truncated
+		contents.resize(DDSDataOffset + 10);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.dds"));
+	}
+
+	static void KTX2MipsPointIntoFile()
+	{
+		std::vector<byte> contents = MakeKTX2(4, 4, 3);
+		TempFile file("AthenaUnitTest.ktx2", contents);
+
+		DecodedImage image;
+		ATN_TEST_CHECK(TextureImporter::Decode(file.Path, TextureImportOptions(), image));
+		ATN_TEST_CHECK(image.Width == 4 && image.Height == 4);
+		ATN_TEST_CHECK(image.Format == TextureFormat::RGBA8);
+		ATN_TEST_CHECK(image.MipLevels == 3 && image.Mips.size() == 3);
+
+		if (image.File && image.Mips.size() == 3)
+		{
+			// Smallest level is stored first
+			const byte* base = image.File->Data();
+			uint64 dataOffset = KTX2HeaderSize + 3 * KTX2LevelIndexSize;
+			ATN_TEST_CHECK(image.Mips[2].data() == base + dataOffset && image.Mips[2].size() == 4);
+			ATN_TEST_CHECK(image.Mips[1].data() == base + dataOffset + 4 && image.Mips[1].size() == 16);
+			ATN_TEST_CHECK(image.Mips[0].data() == base + dataOffset + 20 && image.Mips[0].size() == 64);
+		}
+	}
+
+	static void KTX2InvalidFilesAreRejected()
+	{
+		std::vector<byte> contents = MakeKTX2(4, 4, 3);
+		contents[5] = 0;
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Offset close to UINT64_MAX must not wrap around in range check
+		contents = MakeKTX2(4, 4, 3);
+		WriteUInt64(contents, KTX2HeaderSize, 0xFFFFFFFFFFFFFFF0ull);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Level is smaller than its image size
+		contents = MakeKTX2(4, 4, 3);
+		WriteUInt64(contents, KTX2HeaderSize + 8, 63);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Level data is past end of file
+		contents = MakeKTX2(4, 4, 3);
+		WriteUInt64(contents, KTX2HeaderSize, contents.size() - 32);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Level index is truncated
+		contents = MakeKTX2(4, 4, 3);
+		contents.resize(KTX2HeaderSize + KTX2LevelIndexSize);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		contents = MakeKTX2(4, 4, 3);
+		WriteUInt32(contents, 40, 4);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Cube map, array and supercompressed files are not supported
+		contents = MakeKTX2(4, 4, 1);
+		WriteUInt32(contents, 36, 6);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		contents = MakeKTX2(4, 4, 1);
+		WriteUInt32(contents, 32, 2);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		contents = MakeKTX2(4, 4, 1);
+		WriteUInt32(contents, 44, 2);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// VK_FORMAT_BC7_UNORM_BLOCK
+		contents = MakeKTX2(4, 4, 1);
+		WriteUInt32(contents, 12, 145);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+
+		// Shorter than header
+		contents = MakeKTX2(4, 4, 1);
+		contents.resize(KTX2HeaderSize - 1);
+		ATN_TEST_CHECK(!DecodeBytes(contents, "AthenaUnitTest.ktx2"));
+	}
+
+	void RunContainerImportTests()
+	{
+		DDSMipsPointIntoFile();
+		DDSOptions();
+		DDSIncompleteMipChainUsesBaseLevel();
+		DDSInvalidFilesAreRejected();
+		KTX2MipsPointIntoFile();
+		KTX2InvalidFilesAreRejected();
+	}
+}
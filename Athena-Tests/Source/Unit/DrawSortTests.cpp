@@ -0,0 +1,101 @@
+#include "Athena/Renderer/DrawList.h"
+
+#include "UnitTests.h"
+
+#include <algorithm>
+#include <random>
+
+
+namespace Athena::Tests
+{
+	static void KeyOrder()
+	{
+		// Material has priority over mesh, mesh over depth
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(1, 0, 0) > DrawSortEntry::MakeKey(0, 0xFFFFFF, 0xFFFF));
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0, 1, 0) > DrawSortEntry::MakeKey(0, 0, 0xFFFF));
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0, 0, 2) > DrawSortEntry::MakeKey(0, 0, 1));
+
+		// Out of range IDs do not leak into other fields
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0, 0, 0x1FFFF) == DrawSortEntry::MakeKey(0, 0, 0xFFFF));
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0, 0x1000001, 0) == DrawSortEntry::MakeKey(0, 1, 0));
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0x1000001, 0, 0) == DrawSortEntry::MakeKey(1, 0, 0));
+
+		ATN_TEST_CHECK(DrawSortEntry::MakeKey(0xABCDEF, 0x123456, 0x7890) == 0xABCDEF1234567890ull);
+	}
+
+	static bool IsSameOrder(const std::vector<DrawSortEntry>& a, const std::vector<DrawSortEntry>& b)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (uint64 i = 0; i < a.size(); ++i)
+		{
+			if (a[i].Key != b[i].Key || a[i].Index != b[i].Index)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void RadixSortMatchesStableSort()
+	{
+		std::mt19937_64 random(42);
+
+		// Few distinct materials and meshes, so many keys are equal and stability matters
+		std::vector<DrawSortEntry> entries(5000);
+		for (uint32 i = 0; i < entries.size(); ++i)
+		{
+			uint32 material = random() % 8;
+			uint32 mesh = random() % 16;
+			uint32 depth = random() % 4;
+			entries[i] = { DrawSortEntry::MakeKey(material, mesh, depth), i };
+		}
+
+		std::vector<DrawSortEntry> expected = entries;
+		std::stable_sort(expected.begin(), expected.end(), [](const DrawSortEntry& a, const DrawSortEntry& b) { return a.Key < b.Key; });
+
+		std::vector<DrawSortEntry> buffer;
+		DrawSortEntry::RadixSort(entries, buffer);
+		ATN_TEST_CHECK(IsSameOrder(entries, expected));
+
+		// Full 64-bit keys
+		for (uint32 i = 0; i < entries.size(); ++i)
+			entries[i] = { random(), i };
+
+		expected = entries;
+		std::stable_sort(expected.begin(), expected.end(), [](const DrawSortEntry& a, const DrawSortEntry& b) { return a.Key < b.Key; });
+
+		DrawSortEntry::RadixSort(entries, buffer);
+		ATN_TEST_CHECK(IsSameOrder(entries, expected));
+	}
+
+	static void RadixSortSmallInputs()
+	{
+		std::vector<DrawSortEntry> buffer;
+
+		std::vector<DrawSortEntry> empty;
+		DrawSortEntry::RadixSort(empty, buffer);
+		ATN_TEST_CHECK(empty.empty());
+
+		std::vector<DrawSortEntry> single = { { 7, 0 } };
+		DrawSortEntry::RadixSort(single, buffer);
+		ATN_TEST_CHECK(single.size() == 1 && single[0].Key == 7);
+
+		// All keys equal, every pass is skipped
+		std::vector<DrawSortEntry> same = { { 5, 0 }, { 5, 1 }, { 5, 2 } };
+		DrawSortEntry::RadixSort(same, buffer);
+		ATN_TEST_CHECK(same[0].Index == 0 && same[1].Index == 1 && same[2].Index == 2);
+
+		// Odd number of executed passes, result ends up in temporary buffer first
+		std::vector<DrawSortEntry> reversed = { { 3, 0 }, { 2, 1 }, { 1, 2 } };
+		DrawSortEntry::RadixSort(reversed, buffer);
+		ATN_TEST_CHECK(reversed[0].Key == 1 && reversed[1].Key == 2 && reversed[2].Key == 3);
+	}
+
+	void RunDrawSortTests()
+	{
+		KeyOrder();
+		RadixSortMatchesStableSort();
+		RadixSortSmallInputs();
+	}
+}
@@ -0,0 +1,86 @@
+#include "Athena/Renderer/Frustum.h"
+
+#include "Athena/Math/Projections.h"
+#include "Athena/Math/Transforms.h"
+#include "Athena/Math/Trigonometric.h"
+
+#include "UnitTests.h"
+
+
+namespace Athena::Tests
+{
+	static AABB MakeBox(const Vector3& center, float halfSize)
+	{
+		return AABB(center - Vector3(halfSize), center + Vector3(halfSize));
+	}
+
+	// Camera at origin looks down -Z, 90 degrees vertical FOV, square aspect,
+	// so at distance d frustum spans [-d, d] in X and Y
+	static void CheckPerspectiveCamera(const Matrix4& projection)
+	{
+		Matrix4 view = Math::LookAt(Vector3(0.f), Vector3(0.f, 0.f, -1.f), Vector3(0.f, 1.f, 0.f));
+		Frustum frustum(view * projection);
+
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 0.f, 0.f, -10.f }, 1.f)));
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 9.f, -9.f, -10.f }, 0.5f)));
+
+		// Behind camera, beyond far plane, in front of near plane
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 0.f, 10.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 0.f, -200.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 0.f, -0.05f }, 0.01f)));
+
+		// Outside of each side plane
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 13.f, 0.f, -10.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ -13.f, 0.f, -10.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 13.f, -10.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, -13.f, -10.f }, 1.f)));
+
+		// Intersects side and far planes
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 10.5f, 0.f, -10.f }, 1.f)));
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 0.f, 0.f, -100.5f }, 1.f)));
+
+		// Box that contains whole frustum
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 0.f, 0.f, 0.f }, 1000.f)));
+
+		// Local box moved into and out of frustum by transform
+		AABB local = MakeBox({ 0.f, 0.f, 0.f }, 1.f);
+		ATN_TEST_CHECK(frustum.IsVisible(local, Math::TranslateMatrix(Vector3(0.f, 0.f, -20.f))));
+		ATN_TEST_CHECK(!frustum.IsVisible(local, Math::TranslateMatrix(Vector3(0.f, 0.f, 20.f))));
+	}
+
+	static void PerspectiveCulling()
+	{
+		CheckPerspectiveCamera(Math::Perspective(Math::Radians(90.f), 1.f, 0.1f, 100.f));
+		CheckPerspectiveCamera(Math::PerspectiveReverseZ(Math::Radians(90.f), 1.f, 0.1f, 100.f));
+	}
+
+	// Orthographic light projection set up the same way as for shadow cascades,
+	// camera looks down from y = 50 and covers depth [0, 100]
+	static void OrthoCulling()
+	{
+		Matrix4 view = Math::LookAt(Vector3(0.f, 50.f, 0.f), Vector3(0.f), Vector3(0.f, 0.f, -1.f));
+		Matrix4 projection = Math::Ortho(-10.f, 10.f, -10.f, 10.f, 0.f, -100.f);
+		Frustum frustum(view * projection);
+
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 0.f, 0.f, 0.f }, 1.f)));
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 9.f, -40.f, 9.f }, 0.5f)));
+
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 15.f, 0.f, 0.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 0.f, 15.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, 60.f, 0.f }, 1.f)));
+		ATN_TEST_CHECK(!frustum.IsVisible(MakeBox({ 0.f, -60.f, 0.f }, 1.f)));
+	}
+
+	static void DefaultFrustumAcceptsEverything()
+	{
+		Frustum frustum;
+		ATN_TEST_CHECK(frustum.IsVisible(MakeBox({ 1000.f, -1000.f, 1000.f }, 1.f)));
+	}
+
+	void RunFrustumTests()
+	{
+		PerspectiveCulling();
+		OrthoCulling();
+		DefaultFrustumAcceptsEverything();
+	}
+}
@@ -0,0 +1,160 @@
+#include "Athena/Core/JobSystem.h"
+
+#include "UnitTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+namespace Athena::Tests
+{
+	static void ThreadCounts()
+	{
+		ATN_TEST_CHECK(JobSystem::GetWorkerThreadsCount() == 3);
+		ATN_TEST_CHECK(JobSystem::GetThreadsCount() == 4);
+		ATN_TEST_CHECK(JobSystem::GetCurrentThreadIndex() == 0);
+	}
+
+	static void ParallelForVisitsEachIndexOnce()
+	{
+		const uint32 count = 10007;
+		std::vector<std::atomic<uint32>> visits(count);
+
+		JobSystem::ParallelFor(count, 64, [&visits](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+				visits[i].fetch_add(1, std::memory_order_relaxed);
+		});
+
+		uint32 wrongVisits = 0;
+		for (const auto& value : visits)
+			wrongVisits += value.load() != 1 ? 1 : 0;
+
+		ATN_TEST_CHECK(wrongVisits == 0);
+
+		// Empty range and single batch are handled without jobs
+		bool called = false;
+		JobSystem::ParallelFor(0, 64, [&called](uint32, uint32) { called = true; });
+		ATN_TEST_CHECK(!called);
+
+		uint32 calls = 0;
+		JobSystem::ParallelFor(10, 64, [&calls](uint32 begin, uint32 end) { calls += begin == 0 && end == 10 ? 1 : 100; });
+		ATN_TEST_CHECK(calls == 1);
+	}
+
+	static void DependentJobRunsAfterDependency()
+	{
+		std::atomic<uint32> finished = 0;
+		std::atomic<uint32> seenByDependent = UINT32_MAX;
+
+		JobCounter first;
+		JobCounter second;
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			JobSystem::Schedule([&finished]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+				finished.fetch_add(1);
+			}, &first);
+		}
+
+		JobSystem::Schedule([&finished, &seenByDependent]() { seenByDependent = finished.load(); }, &second, first);
+
+		JobSystem::Wait(second);
+
+		ATN_TEST_CHECK(first.IsDone());
+		ATN_TEST_CHECK(seenByDependent.load() == 16);
+	}
+
+	static void NestedParallelFor()
+	{
+		const uint32 outer = 32;
+		const uint32 inner = 256;
+		std::atomic<uint64> sum = 0;
+
+		JobSystem::ParallelFor(outer, 1, [&sum](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+			{
+				JobSystem::ParallelFor(inner, 16, [&sum](uint32 innerBegin, uint32 innerEnd)
+				{
+					uint64 localSum = 0;
+					for (uint32 j = innerBegin; j < innerEnd; ++j)
+						localSum += j;
+
+					sum.fetch_add(localSum);
+				});
+			}
+		});
+
+		ATN_TEST_CHECK(sum.load() == outer * (inner * (inner - 1) / 2));
+	}
+
+	// Jobs from asset loader threads must not run on main thread or steal jobs
+	// that use per-thread resources of job system threads
+	static void ForeignThreadJobsStayOffMainThread()
+	{
+		std::atomic<bool> foreignDone = false;
+		std::atomic<uint32> foreignJobsOnMainThread = 0;
+		std::atomic<uint32> mainJobsOnForeignThread = 0;
+		std::atomic<uint64> foreignSum = 0;
+
+		std::thread loader([&]()
+		{
+			ATN_TEST_CHECK(JobSystem::GetCurrentThreadIndex() == UINT32_MAX);
+
+			for (uint32 iteration = 0; iteration < 20; ++iteration)
+			{
+				JobSystem::ParallelFor(64, 1, [&](uint32 begin, uint32 end)
+				{
+					if (JobSystem::GetCurrentThreadIndex() == 0)
+						foreignJobsOnMainThread.fetch_add(1);
+
+					std::this_thread::sleep_for(std::chrono::microseconds(50));
+					foreignSum.fetch_add(end - begin);
+				});
+			}
+
+			foreignDone = true;
+		});
+
+		while (!foreignDone.load())
+		{
+			JobCounter counter;
+			for (uint32 i = 0; i < 16; ++i)
+			{
+				JobSystem::Schedule([&mainJobsOnForeignThread]()
+				{
+					if (JobSystem::GetCurrentThreadIndex() == UINT32_MAX)
+						mainJobsOnForeignThread.fetch_add(1);
+				}, &counter);
+			}
+
+			JobSystem::Wait(counter);
+		}
+
+		loader.join();
+
+		ATN_TEST_CHECK(foreignSum.load() == 20 * 64);
+		ATN_TEST_CHECK(foreignJobsOnMainThread.load() == 0);
+		ATN_TEST_CHECK(mainJobsOnForeignThread.load() == 0);
+	}
+
+	static void BatchSize()
+	{
+		ATN_TEST_CHECK(JobSystem::GetBatchSize(100, 64) == 64);
+		ATN_TEST_CHECK(JobSystem::GetBatchSize(160000, 64) == 160000 / (4 * 4));
+	}
+
+	void RunJobSystemTests()
+	{
+		ThreadCounts();
+		ParallelForVisitsEachIndexOnce();
+		DependentJobRunsAfterDependency();
+		NestedParallelFor();
+		ForeignThreadJobsStayOffMainThread();
+		BatchSize();
+	}
+}
@@ -0,0 +1,143 @@
+#include "Athena/Core/LogQueue.h"
+
+#include "UnitTests.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Athena::Tests
+{
+	static void FullQueueRejectsPush()
+	{
+		LogQueue queue;
+		queue.Init(8);
+
+		uint32 pushed = 0;
+		for (uint32 i = 0; i < 8; ++i)
+		{
+			String message = std::to_string(i);
+			pushed += queue.TryPush(Log::Type::Core, Log::Level::Info, message) ? 1 : 0;
+		}
+
+		ATN_TEST_CHECK(pushed == 8);
+		ATN_TEST_CHECK(queue.GetPushedCount() == 8);
+
+		// Message is not moved from if push fails
+		String message = "overflow";
+		ATN_TEST_CHECK(!queue.TryPush(Log::Type::Core, Log::Level::Error, message));
+		ATN_TEST_CHECK(message == "overflow");
+
+		// Released slot can be reused
+		LogEntry* entry = nullptr;
+		ATN_TEST_CHECK(queue.TryPop(entry) && entry->Message == "0");
+		queue.Release(entry);
+
+		ATN_TEST_CHECK(queue.TryPush(Log::Type::Core, Log::Level::Error, message));
+		ATN_TEST_CHECK(message.empty());
+	}
+
+	static void PopOrderAndWrapAround()
+	{
+		LogQueue queue;
+		queue.Init(4);
+
+		LogEntry* entry = nullptr;
+		ATN_TEST_CHECK(!queue.TryPop(entry));
+
+		// Several rounds over ring buffer with different fill levels
+		uint32 next = 0;
+		uint32 expected = 0;
+		uint32 wrong = 0;
+		for (uint32 round = 0; round < 10; ++round)
+		{
+			uint32 count = round % 4 + 1;
+			for (uint32 i = 0; i < count; ++i)
+			{
+				String message = std::to_string(next++);
+				Log::Level level = next % 2 == 0 ? Log::Level::Warn : Log::Level::Trace;
+				wrong += queue.TryPush(Log::Type::Client, level, message) ? 0 : 1;
+			}
+
+			while (queue.TryPop(entry))
+			{
+				Log::Level level = (expected + 1) % 2 == 0 ? Log::Level::Warn : Log::Level::Trace;
+				wrong += entry->Message == std::to_string(expected) && entry->Level == level && entry->Type == Log::Type::Client ? 0 : 1;
+
+				queue.Release(entry);
+				expected++;
+			}
+		}
+
+		ATN_TEST_CHECK(wrong == 0);
+		ATN_TEST_CHECK(expected == next);
+		ATN_TEST_CHECK(queue.GetPushedCount() == next);
+	}
+
+	// Producers retry when queue is full, consumer runs concurrently with them
+	static void ManyProducers()
+	{
+		const uint32 producersCount = 4;
+		const uint32 messagesCount = 20000;
+
+		LogQueue queue;
+		queue.Init(16);
+
+		std::vector<std::thread> producers;
+		for (uint32 p = 0; p < producersCount; ++p)
+		{
+			producers.emplace_back([&queue, p]()
+			{
+				for (uint32 i = 0; i < messagesCount; ++i)
+				{
+					String message = std::to_string(p) + ":" + std::to_string(i);
+					while (!queue.TryPush(Log::Type::Core, Log::Level::Info, message))
+						std::this_thread::yield();
+				}
+			});
+		}
+
+		// Messages of each producer are received in order they were pushed
+		std::vector<uint32> nextMessage(producersCount, 0);
+		uint32 received = 0;
+		uint32 wrong = 0;
+
+		while (received < producersCount * messagesCount)
+		{
+			LogEntry* entry = nullptr;
+			if (!queue.TryPop(entry))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			uint64 separator = entry->Message.find(':');
+			uint32 producer = std::stoul(entry->Message.substr(0, separator));
+			uint32 index = std::stoul(entry->Message.substr(separator + 1));
+
+			if (producer < producersCount && nextMessage[producer] == index)
+				nextMessage[producer]++;
+			else
+				wrong++;
+
+			queue.Release(entry);
+			received++;
+		}
+
+		for (auto& thread : producers)
+			thread.join();
+
+		LogEntry* entry = nullptr;
+		ATN_TEST_CHECK(!queue.TryPop(entry));
+		ATN_TEST_CHECK(wrong == 0);
+		ATN_TEST_CHECK(queue.GetPushedCount() == producersCount * messagesCount);
+	}
+
+	void RunLogQueueTests()
+	{
+		FullQueueRejectsPush();
+		PopOrderAndWrapAround();
+		ManyProducers();
+	}
+}
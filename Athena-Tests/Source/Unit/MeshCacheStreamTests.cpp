@@ -0,0 +1,159 @@
+#include "Athena/Renderer/MeshCacheStream.h"
+
+#include "UnitTests.h"
+
+#include <vector>
+
+
+namespace Athena::Tests
+{
+	struct TestVertex
+	{
+		float Position[3];
+		uint32 Color;
+	};
+
+	static const std::vector<TestVertex> s_Vertices = { { { 1.f, 2.f, 3.f }, 0xFF0000FF }, { { -1.f, 0.5f, 8.f }, 0x00FF00FF } };
+	static const std::vector<uint16> s_Indices = { 0, 1, 1, 0, 1 };
+
+	static std::vector<byte> WriteTestCache()
+	{
+		MeshCacheWriter writer;
+		writer.Write<uint32>(0xCAFE);
+		writer.Write(String("Mesh"));
+		writer.WriteArray(std::span<const uint16>(s_Indices));
+		writer.Write(String());
+		writer.Write<float>(2.5f);
+		writer.WriteArray(std::span<const TestVertex>(s_Vertices));
+		writer.WriteArray(std::span<const uint64>());
+
+		return writer.GetBuffer();
+	}
+
+	// Reads everything written by WriteTestCache, returns false as soon as any read fails
+	static bool ReadTestCache(MeshCacheReader& reader, const byte* base, bool checkValues)
+	{
+		uint32 magic;
+		String name;
+		std::span<const uint16> indices;
+		String emptyName = "not empty";
+		float scale;
+		std::vector<TestVertex> vertices;
+		std::span<const uint64> empty;
+
+		if (!reader.Read(magic) || !reader.Read(name) || !reader.ReadArray(indices) || !reader.Read(emptyName) ||
+			!reader.Read(scale) || !reader.ReadArray(vertices) || !reader.ReadArray(empty))
+			return false;
+
+		if (checkValues)
+		{
+			ATN_TEST_CHECK(magic == 0xCAFE);
+			ATN_TEST_CHECK(name == "Mesh");
+			ATN_TEST_CHECK(emptyName.empty());
+			ATN_TEST_CHECK(scale == 2.5f);
+			ATN_TEST_CHECK(empty.empty());
+
+			// Views point into source buffer at aligned offsets
+			ATN_TEST_CHECK(((const byte*)indices.data() - base) % 16 == 0);
+			ATN_TEST_CHECK(indices.size() == s_Indices.size() && memcmp(indices.data(), s_Indices.data(), indices.size_bytes()) == 0);
+
+			ATN_TEST_CHECK(vertices.size() == s_Vertices.size());
+			if (vertices.size() == s_Vertices.size())
+			{
+				ATN_TEST_CHECK(vertices[1].Position[2] == 8.f);
+				ATN_TEST_CHECK(vertices[1].Color == 0x00FF00FF);
+			}
+		}
+
+		return true;
+	}
+
+	static void RoundTrip()
+	{
+		std::vector<byte> buffer = WriteTestCache();
+
+		MeshCacheReader reader(buffer.data(), buffer.size());
+		ATN_TEST_CHECK(ReadTestCache(reader, buffer.data(), true));
+
+		// Nothing left after last value
+		byte extra;
+		ATN_TEST_CHECK(!reader.Read(extra));
+	}
+
+	static void TruncatedCacheFails()
+	{
+		std::vector<byte> buffer = WriteTestCache();
+
+		// Every prefix is copied to buffer of exact size, so out of bounds read would be visible to sanitizers
+		uint32 succeeded = 0;
+		for (uint64 size = 0; size < buffer.size(); ++size)
+		{
+			std::vector<byte> truncated(buffer.begin(), buffer.begin() + size);
+			MeshCacheReader reader(truncated.data(), truncated.size());
+			succeeded += ReadTestCache(reader, truncated.data(), false) ? 1 : 0;
+		}
+
+		ATN_TEST_CHECK(succeeded == 0);
+	}
+
+	static void HugeSizesFail()
+	{
+		// count * sizeof(uint32) wraps around to 4
+		{
+			MeshCacheWriter writer;
+			writer.Write<uint64>((1ull << 62) + 1);
+			writer.Write<uint64>(0);
+			writer.Write<uint64>(0);
+
+			std::span<const uint32> view;
+			MeshCacheReader reader(writer.GetBuffer().data(), writer.GetBuffer().size());
+			ATN_TEST_CHECK(!reader.ReadArray(view));
+		}
+
+		{
+			MeshCacheWriter writer;
+			writer.Write<uint64>(UINT64_MAX);
+			writer.Write<uint64>(0);
+
+			std::vector<uint16> vec;
+			MeshCacheReader reader(writer.GetBuffer().data(), writer.GetBuffer().size());
+			ATN_TEST_CHECK(!reader.ReadArray(vec));
+		}
+
+		// String size is larger than rest of buffer
+		{
+			MeshCacheWriter writer;
+			writer.Write<uint32>(1000);
+			writer.WriteBytes("0123456789", 10);
+
+			String str;
+			MeshCacheReader reader(writer.GetBuffer().data(), writer.GetBuffer().size());
+			ATN_TEST_CHECK(!reader.Read(str));
+		}
+
+		{
+			MeshCacheWriter writer;
+			writer.Write<uint32>(UINT32_MAX);
+
+			String str;
+			MeshCacheReader reader(writer.GetBuffer().data(), writer.GetBuffer().size());
+			ATN_TEST_CHECK(!reader.Read(str));
+		}
+	}
+
+	static void AlignOffset()
+	{
+		ATN_TEST_CHECK(AlignMeshCacheOffset(0) == 0);
+		ATN_TEST_CHECK(AlignMeshCacheOffset(1) == 16);
+		ATN_TEST_CHECK(AlignMeshCacheOffset(16) == 16);
+		ATN_TEST_CHECK(AlignMeshCacheOffset(17) == 32);
+	}
+
+	void RunMeshCacheStreamTests()
+	{
+		RoundTrip();
+		TruncatedCacheFails();
+		HugeSizesFail();
+		AlignOffset();
+	}
+}
@@ -0,0 +1,403 @@
+#include "Athena/Asset/TextureCompressor.h"
+
+#include "UnitTests.h"
+
+#include <cstring>
+#include <vector>
+
+
+namespace Athena::Tests
+{
+	// Reference decoders, written from format specification independently of encoder
+
+	using DecodedBlock = byte[16][4];
+
+	struct BlockBitReader
+	{
+		const byte* Data;
+		uint32 Position = 0;
+
+		uint32 Read(uint32 count)
+		{
+			uint32 value = 0;
+			for (uint32 i = 0; i < count; ++i, ++Position)
+				value |= ((Data[Position / 8] >> (Position % 8)) & 1) << i;
+
+			return value;
+		}
+	};
+
+	static void Unpack565(uint16 color, uint32* rgb)
+	{
+		uint32 r = (color >> 11) & 31;
+		uint32 g = (color >> 5) & 63;
+		uint32 b = color & 31;
+
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	// Color block of BC3 is always decoded in 4 color mode
+	static void DecodeBC1(const byte* data, bool forceFourColors, DecodedBlock& output)
+	{
+		uint16 color0, color1;
+		uint32 indices;
+		memcpy(&color0, data, 2);
+		memcpy(&color1, data + 2, 2);
+		memcpy(&indices, data + 4, 4);
+
+		uint32 palette[4][4];
+		Unpack565(color0, palette[0]);
+		Unpack565(color1, palette[1]);
+		palette[0][3] = palette[1][3] = 255;
+
+		bool fourColors = forceFourColors || color0 > color1;
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			if (fourColors)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[2][3] = 255;
+		palette[3][3] = fourColors ? 255 : 0;
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 index = (indices >> (2 * i)) & 3;
+			for (uint32 c = 0; c < 4; ++c)
+				output[i][c] = (byte)palette[index][c];
+		}
+	}
+
+	static void DecodeBC4(const byte* data, DecodedBlock& output, uint32 channel)
+	{
+		uint32 red0 = data[0];
+		uint32 red1 = data[1];
+
+		uint32 palette[8] = { red0, red1 };
+		if (red0 > red1)
+		{
+			for (uint32 i = 2; i < 8; ++i)
+				palette[i] = ((8 - i) * red0 + (i - 1) * red1 + 3) / 7;
+		}
+		else
+		{
+			for (uint32 i = 2; i < 6; ++i)
+				palette[i] = ((6 - i) * red0 + (i - 1) * red1 + 2) / 5;
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		BlockBitReader reader = { data + 2 };
+		for (uint32 i = 0; i < 16; ++i)
+			output[i][channel] = (byte)palette[reader.Read(3)];
+	}
+
+	// Only mode 6 is supported, returns false for other modes
+	static bool DecodeBC7(const byte* data, DecodedBlock& output)
+	{
+		static constexpr uint32 weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		BlockBitReader reader = { data };
+		if (reader.Read(7) != (1 << 6))
+			return false;
+
+		uint32 endpoints[2][4];
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] = reader.Read(7) << 1;
+			endpoints[1][c] = reader.Read(7) << 1;
+		}
+
+		uint32 pbit0 = reader.Read(1);
+		uint32 pbit1 = reader.Read(1);
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] |= pbit0;
+			endpoints[1][c] |= pbit1;
+		}
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 weight = weights[reader.Read(i == 0 ? 3 : 4)];
+			for (uint32 c = 0; c < 4; ++c)
+				output[i][c] = (byte)(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+		}
+
+		return true;
+	}
+
+	static uint32 GetBytesPerBlock(TextureCompression compression)
+	{
+		return compression == TextureCompression::BC1 || compression == TextureCompression::BC4 ? 8 : 16;
+	}
+
+	// Decodes single mip level into RGBA8, channels not stored in format are left as 0
+	static std::vector<byte> DecodeImage(const byte* data, uint32 width, uint32 height, TextureCompression compression)
+	{
+		std::vector<byte> result((uint64)width * height * 4, 0);
+
+		uint32 blocksX = (width + 3) / 4;
+		uint32 blocksY = (height + 3) / 4;
+		uint32 bytesPerBlock = GetBytesPerBlock(compression);
+
+		for (uint32 by = 0; by < blocksY; ++by)
+		{
+			for (uint32 bx = 0; bx < blocksX; ++bx)
+			{
+				const byte* block = data + ((uint64)by * blocksX + bx) * bytesPerBlock;
+
+				DecodedBlock decoded = {};
+				switch (compression)
+				{
+				case TextureCompression::BC1: DecodeBC1(block, false, decoded); break;
+				case TextureCompression::BC3: DecodeBC1(block + 8, true, decoded); DecodeBC4(block, decoded, 3); break;
+				case TextureCompression::BC4: DecodeBC4(block, decoded, 0); break;
+				case TextureCompression::BC5: DecodeBC4(block, decoded, 0); DecodeBC4(block + 8, decoded, 1); break;
+				case TextureCompression::BC7: ATN_TEST_CHECK(DecodeBC7(block, decoded)); break;
+				default: break;
+				}
+
+				for (uint32 i = 0; i < 16; ++i)
+				{
+					uint32 x = bx * 4 + i % 4;
+					uint32 y = by * 4 + i / 4;
+					if (x < width && y < height)
+						memcpy(&result[((uint64)y * width + x) * 4], decoded[i], 4);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	// Max absolute difference over channels that are stored in format
+	static uint32 GetMaxError(const std::vector<byte>& expected, const std::vector<byte>& decoded, uint32 channels)
+	{
+		uint32 maxError = 0;
+		for (uint64 i = 0; i < expected.size(); ++i)
+		{
+			if (i % 4 >= channels)
+				continue;
+
+			uint32 error = expected[i] > decoded[i] ? expected[i] - decoded[i] : decoded[i] - expected[i];
+			maxError = Math::Max(maxError, error);
+		}
+
+		return maxError;
+	}
+
+	static uint32 GetChannelsCount(TextureCompression compression)
+	{
+		switch (compression)
+		{
+		case TextureCompression::BC1: return 3;
+		case TextureCompression::BC4: return 1;
+		case TextureCompression::BC5: return 2;
+		default: return 4;
+		}
+	}
+
+	static void FormatsAndMipCounts()
+	{
+		ATN_TEST_CHECK(TextureCompressor::GetCompressedFormat(TextureCompression::BC1, true) == TextureFormat::BC1_SRGB);
+		ATN_TEST_CHECK(TextureCompressor::GetCompressedFormat(TextureCompression::BC3, false) == TextureFormat::BC3);
+		ATN_TEST_CHECK(TextureCompressor::GetCompressedFormat(TextureCompression::BC4, true) == TextureFormat::BC4);
+		ATN_TEST_CHECK(TextureCompressor::GetCompressedFormat(TextureCompression::BC5, true) == TextureFormat::BC5);
+		ATN_TEST_CHECK(TextureCompressor::GetCompressedFormat(TextureCompression::BC7, true) == TextureFormat::BC7_SRGB);
+
+		ATN_TEST_CHECK(TextureCompressor::GetMipLevelsCount(1, 1) == 1);
+		ATN_TEST_CHECK(TextureCompressor::GetMipLevelsCount(8, 8) == 4);
+		ATN_TEST_CHECK(TextureCompressor::GetMipLevelsCount(16, 4) == 5);
+		ATN_TEST_CHECK(TextureCompressor::GetMipLevelsCount(7, 3) == 3);
+	}
+
+	static void OutputSizeIncludesAllMips()
+	{
+		std::vector<byte> image(8 * 8 * 4, 128);
+
+		// 4 blocks + 3 mips of single block
+		Buffer bc1 = TextureCompressor::Compress(image.data(), 8, 8, 4, TextureCompression::BC1, false);
+		ATN_TEST_CHECK(bc1.Size() == 4 * 8 + 3 * 8);
+		bc1.Release();
+
+		Buffer bc7 = TextureCompressor::Compress(image.data(), 8, 8, 4, TextureCompression::BC7, false);
+		ATN_TEST_CHECK(bc7.Size() == 4 * 16 + 3 * 16);
+		bc7.Release();
+
+		// Partial blocks are rounded up: 5x3 -> 2 blocks, 2x1 -> 1 block, 1x1 -> 1 block
+		std::vector<byte> oddImage(5 * 3 * 4, 128);
+		Buffer bc3 = TextureCompressor::Compress(oddImage.data(), 5, 3, 3, TextureCompression::BC3, false);
+		ATN_TEST_CHECK(bc3.Size() == 2 * 16 + 16 + 16);
+		bc3.Release();
+	}
+
+	static void SolidColorIsPreserved()
+	{
+		const byte color[4] = { 200, 100, 50, 180 };
+
+		std::vector<byte> image(8 * 8 * 4);
+		for (uint32 i = 0; i < 8 * 8; ++i)
+			memcpy(&image[i * 4], color, 4);
+
+		const TextureCompression formats[] = { TextureCompression::BC1, TextureCompression::BC3, TextureCompression::BC4, TextureCompression::BC5, TextureCompression::BC7 };
+		for (TextureCompression compression : formats)
+		{
+			// BC1 treats alpha < 128 as transparent, keep it opaque there
+			std::vector<byte> input = image;
+			if (compression == TextureCompression::BC1)
+			{
+				for (uint32 i = 0; i < 8 * 8; ++i)
+					input[i * 4 + 3] = 255;
+			}
+
+			Buffer compressed = TextureCompressor::Compress(input.data(), 8, 8, 1, compression, false);
+			std::vector<byte> decoded = DecodeImage(compressed.Data(), 8, 8, compression);
+			compressed.Release();
+
+			// BC1 color is quantized to 565
+			uint32 tolerance = compression == TextureCompression::BC1 || compression == TextureCompression::BC3 ? 4 : 1;
+			ATN_TEST_CHECK(GetMaxError(input, decoded, GetChannelsCount(compression)) <= tolerance);
+		}
+	}
+
+	static void GradientIsPreserved()
+	{
+		// Channels change linearly along X, so every block can be represented by single line segment
+		const uint32 width = 16;
+		const uint32 height = 8;
+
+		std::vector<byte> image(width * height * 4);
+		for (uint32 y = 0; y < height; ++y)
+		{
+			for (uint32 x = 0; x < width; ++x)
+			{
+				byte* pixel = &image[(y * width + x) * 4];
+				pixel[0] = (byte)(20 + 12 * x);
+				pixel[1] = (byte)(220 - 10 * x);
+				pixel[2] = (byte)(100 + 6 * x);
+				pixel[3] = (byte)(255 - 8 * x);
+			}
+		}
+
+		struct Case { TextureCompression Compression; uint32 Tolerance; };
+		const Case cases[] = {
+			{ TextureCompression::BC1, 10 },
+			{ TextureCompression::BC3, 10 },
+			{ TextureCompression::BC4, 4 },
+			{ TextureCompression::BC5, 4 },
+			{ TextureCompression::BC7, 4 } };
+
+		for (const Case& test : cases)
+		{
+			Buffer compressed = TextureCompressor::Compress(image.data(), width, height, 1, test.Compression, false);
+			std::vector<byte> decoded = DecodeImage(compressed.Data(), width, height, test.Compression);
+			compressed.Release();
+
+			ATN_TEST_CHECK(GetMaxError(image, decoded, GetChannelsCount(test.Compression)) <= test.Tolerance);
+		}
+	}
+
+	static void BC1TransparentPixels()
+	{
+		// Left half of block is transparent
+		std::vector<byte> image(4 * 4 * 4);
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			byte* pixel = &image[i * 4];
+			pixel[0] = (byte)(40 + 10 * i);
+			pixel[1] = 90;
+			pixel[2] = 160;
+			pixel[3] = i % 4 < 2 ? 0 : 255;
+		}
+
+		Buffer compressed = TextureCompressor::Compress(image.data(), 4, 4, 1, TextureCompression::BC1, false);
+
+		uint16 color0, color1;
+		uint32 indices;
+		memcpy(&color0, compressed.Data(), 2);
+		memcpy(&color1, compressed.Data() + 2, 2);
+		memcpy(&indices, compressed.Data() + 4, 4);
+
+		// 3 color mode is selected by color0 <= color1
+		ATN_TEST_CHECK(color0 <= color1);
+
+		uint32 wrongIndices = 0;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			bool transparent = i % 4 < 2;
+			bool transparentIndex = ((indices >> (2 * i)) & 3) == 3;
+			wrongIndices += transparent != transparentIndex ? 1 : 0;
+		}
+		ATN_TEST_CHECK(wrongIndices == 0);
+
+		std::vector<byte> decoded = DecodeImage(compressed.Data(), 4, 4, TextureCompression::BC1);
+		compressed.Release();
+
+		for (uint32 i = 0; i < 16; ++i)
+			ATN_TEST_CHECK(decoded[i * 4 + 3] == image[i * 4 + 3]);
+	}
+
+	static void MipsAreFilteredInLinearSpace()
+	{
+		// Black and white checkerboard, average is 0.5 in linear space
+		std::vector<byte> image(2 * 2 * 4, 255);
+		image[0] = image[1] = image[2] = 0;
+		image[12] = image[13] = image[14] = 0;
+
+		Buffer srgb = TextureCompressor::Compress(image.data(), 2, 2, 2, TextureCompression::BC7, true);
+		std::vector<byte> srgbMip = DecodeImage(srgb.Data() + 16, 1, 1, TextureCompression::BC7);
+		srgb.Release();
+
+		Buffer unorm = TextureCompressor::Compress(image.data(), 2, 2, 2, TextureCompression::BC7, false);
+		std::vector<byte> unormMip = DecodeImage(unorm.Data() + 16, 1, 1, TextureCompression::BC7);
+		unorm.Release();
+
+		// Linear 0.5 is 188 in sRGB
+		ATN_TEST_CHECK(srgbMip[0] >= 186 && srgbMip[0] <= 190);
+		ATN_TEST_CHECK(unormMip[0] >= 126 && unormMip[0] <= 130);
+		// Mode 6 shares p-bit between all channels, so alpha can be off by one
+		ATN_TEST_CHECK(srgbMip[3] >= 254 && unormMip[3] >= 254);
+	}
+
+	static void NormalMapMipsAreRenormalized()
+	{
+		// Columns alternate between normals (0.8, 0, 0.6) and (0, 0, 1), their average (0.4, 0, 0.8) is not unit length
+		std::vector<byte> image(2 * 2 * 4, 255);
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			byte* pixel = &image[i * 4];
+			pixel[0] = i % 2 == 0 ? 230 : 128;
+			pixel[1] = 128;
+			pixel[2] = i % 2 == 0 ? 204 : 255;
+		}
+
+		Buffer compressed = TextureCompressor::Compress(image.data(), 2, 2, 2, TextureCompression::BC5, false);
+		std::vector<byte> mip = DecodeImage(compressed.Data() + 16, 1, 1, TextureCompression::BC5);
+		compressed.Release();
+
+		// Renormalized X is 0.447 (185), plain average would give 0.4 (179)
+		ATN_TEST_CHECK(mip[0] >= 184 && mip[0] <= 187);
+		ATN_TEST_CHECK(mip[1] >= 127 && mip[1] <= 130);
+	}
+
+	void RunTextureCompressorTests()
+	{
+		FormatsAndMipCounts();
+		OutputSizeIncludesAllMips();
+		SolidColorIsPreserved();
+		GradientIsPreserved();
+		BC1TransparentPixels();
+		MipsAreFilteredInLinearSpace();
+		NormalMapMipsAreRenormalized();
+	}
+}
@@ -0,0 +1,30 @@
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Core/Log.h"
+
+#include "UnitTests.h"
+
+using namespace Athena;
+
+
+int main(int argc, char** argv)
+{
+	Log::Init(false);
+
+	// Fixed number of workers, so tests behave the same on every machine
+	JobSystemConfig jobSystemConfig;
+	jobSystemConfig.WorkerThreadsCount = 3;
+	JobSystem::Init(jobSystemConfig);
+
+	Tests::RunJobSystemTests();
+	Tests::RunDrawSortTests();
+	Tests::RunFrustumTests();
+	Tests::RunTextureCompressorTests();
+	Tests::RunContainerImportTests();
+	Tests::RunMeshCacheStreamTests();
+	Tests::RunLogQueueTests();
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+
+	return Tests::ReportResults();
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "TestCommon.h"
+
+
+namespace Athena::Tests
+{
+	void RunJobSystemTests();
+	void RunDrawSortTests();
+	void RunFrustumTests();
+	void RunTextureCompressorTests();
+	void RunContainerImportTests();
+	void RunMeshCacheStreamTests();
+	void RunLogQueueTests();
+}
@@ -1,9 +1,11 @@
 //////////////////////// Athena Directional Light Shadow Map Shader////////////////////////
 
 #version 460 core
+#extension GL_ARB_shader_viewport_layer_array : require
 #pragma stage : vertex
 
 #include "Include/Buffers.glslh"
+#include "Include/Shadows.glslh"
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoords;
@@ -16,30 +18,17 @@ layout(location = 6) in vec3 a_TRow1;
 layout(location = 7) in vec3 a_TRow2;
 layout(location = 8) in vec3 a_TRow3;
 
+layout(push_constant) uniform u_MaterialData
+{
+    uint u_CascadeIndex;
+};
+
 
 void main()
 {
+    int cascade = int(u_CascadeIndex);
+
     mat4 transform = GetTransform(a_TRow0, a_TRow1, a_TRow2, a_TRow3);
-    gl_Position = transform * vec4(a_Position, 1.0);
+    gl_Position = u_DirLightViewProjection[cascade] * transform * vec4(a_Position, 1.0);
+    gl_Layer = cascade;
 }
-
-#version 460 core
-#pragma stage : geometry
-
-#include "Include/Shadows.glslh"
-
-layout(triangles, invocations = SHADOW_CASCADES_COUNT) in;
-layout(triangle_strip, max_vertices = 3) out;
-    
-
-void main()
-{          
-    for (int i = 0; i < 3; ++i)
-    {
-        gl_Position = u_DirLightViewProjection[gl_InvocationID] * gl_in[i].gl_Position;
-        gl_Layer = gl_InvocationID;
-        EmitVertex();
-    }
-
-    EndPrimitive();
-} 
@@ -18,15 +18,10 @@ layout(location = 8) in vec3 a_TRow1;
 layout(location = 9) in vec3 a_TRow2;
 layout(location = 10) in vec3 a_TRow3;
 
-layout(push_constant) uniform u_MaterialData
-{
-    uint u_BonesOffset;
-};
-
 void main()
 {
     mat4 worldTransform = GetTransform(a_TRow0, a_TRow1, a_TRow2, a_TRow3);
-    mat4 transform = worldTransform * GetBonesTransform(u_BonesOffset, a_BoneIDs, a_Weights);
+    mat4 transform = worldTransform * GetBonesTransform(g_BonesOffsets[gl_InstanceIndex], a_BoneIDs, a_Weights);
 
     vec4 worldPos = transform * vec4(a_Position, 1.0);
     gl_Position = u_Camera.ViewProjection * worldPos;
@@ -0,0 +1,101 @@
+//////////////////////// Athena Environment Irradiance SH Shader ////////////////////////
+
+// References:
+// https://cseweb.ucsd.edu/~ravir/papers/envmap/envmap.pdf
+// https://www.ppsloan.org/publications/StupidSH36.pdf
+
+
+#version 460 core
+#pragma stage : compute
+
+#include "Include/Common.glslh"
+#include "Include/SphericalHarmonics.glslh"
+
+// Cubemap is projected from grid of FACE_SAMPLES x FACE_SAMPLES samples per face,
+// all faces are reduced by single work group
+#define FACE_SAMPLES 64
+#define GROUP_SIZE 64
+
+layout (local_size_x = GROUP_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 1, binding = 0) uniform samplerCube u_EnvironmentMap;
+
+layout(std430, set = 1, binding = 1) writeonly buffer u_IrradianceSHData
+{
+    vec4 g_IrradianceSH[SH_L2_COEFFICIENT_COUNT];
+};
+
+shared vec3 s_Coefficients[GROUP_SIZE][SH_L2_COEFFICIENT_COUNT];
+shared float s_Weights[GROUP_SIZE];
+
+
+void main()
+{
+    uint index = gl_LocalInvocationIndex;
+
+    vec3 coefficients[SH_L2_COEFFICIENT_COUNT];
+    for (int i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        coefficients[i] = vec3(0.0);
+
+    float weightSum = 0.0;
+
+    // Sample mip with about one texel per sample, so each sample averages its whole footprint
+    float lod = max(log2(float(textureSize(u_EnvironmentMap, 0).x) / FACE_SAMPLES), 0.0);
+
+    const uint samplesPerFace = FACE_SAMPLES * FACE_SAMPLES;
+    for (uint i = index; i < 6 * samplesPerFace; i += GROUP_SIZE)
+    {
+        int face = int(i / samplesPerFace);
+        uint texel = i % samplesPerFace;
+
+        vec2 texCoords = (vec2(texel % FACE_SAMPLES, texel / FACE_SAMPLES) + 0.5) / FACE_SAMPLES;
+        texCoords = texCoords * 2.0 - 1.0;
+
+        // Solid angle of texel, projected area falls off with distance from face center
+        float distSq = 1.0 + dot(texCoords, texCoords);
+        float weight = 4.0 / (FACE_SAMPLES * FACE_SAMPLES * distSq * sqrt(distSq));
+
+        vec3 dir = GetWorldDirectionFromCubeFace(face, texCoords);
+        vec3 radiance = textureLod(u_EnvironmentMap, dir, lod).rgb;
+
+        float basis[SH_L2_COEFFICIENT_COUNT];
+        GetSHBasisL2(dir, basis);
+
+        for (int j = 0; j < SH_L2_COEFFICIENT_COUNT; ++j)
+            coefficients[j] += radiance * basis[j] * weight;
+
+        weightSum += weight;
+    }
+
+    for (int i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        s_Coefficients[index][i] = coefficients[i];
+
+    s_Weights[index] = weightSum;
+
+    barrier();
+
+    for (uint stride = GROUP_SIZE / 2; stride > 0; stride /= 2)
+    {
+        if (index < stride)
+        {
+            for (int i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+                s_Coefficients[index][i] += s_Coefficients[index + stride][i];
+
+            s_Weights[index] += s_Weights[index + stride];
+        }
+
+        barrier();
+    }
+
+    if (index == 0)
+    {
+        // Sum of texel solid angles is close to 4 PI, normalize to remove discretization error
+        float normalization = 4.0 * PI / s_Weights[0];
+
+        for (int i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        {
+            vec3 coefficient = s_Coefficients[0][i] * normalization * GetSHCosineLobeBand(i);
+            g_IrradianceSH[i] = vec4(coefficient, 0.0);
+        }
+    }
+}
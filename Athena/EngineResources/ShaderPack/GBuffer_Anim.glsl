@@ -29,17 +29,14 @@ layout(location = 0) out VertexInterpolators Interpolators;
 
 layout(push_constant) uniform u_MaterialData
 {
-    uint u_BonesOffset;
-
-    uint u_UseAlbedoMap;
-    uint u_UseNormalMap;
-    uint u_UseRoughnessMap;
-
     vec4 u_Albedo;
     float u_Roughness;
     float u_Metalness;
     float u_Emission;
 
+    uint u_UseAlbedoMap;
+    uint u_UseNormalMap;
+    uint u_UseRoughnessMap;
     uint u_UseMetalnessMap;
 };
 
@@ -47,7 +44,7 @@ layout(push_constant) uniform u_MaterialData
 void main()
 {
     mat4 worldTransform = GetTransform(a_TRow0, a_TRow1, a_TRow2, a_TRow3);
-    mat4 transform = worldTransform * GetBonesTransform(u_BonesOffset, a_BoneIDs, a_Weights);
+    mat4 transform = worldTransform * GetBonesTransform(g_BonesOffsets[gl_InstanceIndex], a_BoneIDs, a_Weights);
 
     mat4 viewTransform = u_Camera.View * transform;
 
@@ -84,17 +81,14 @@ layout(location = 2) out vec2 o_RoughnessMetalness;
 
 layout(push_constant) uniform u_MaterialData
 {
-    uint u_BonesOffset;
-
-    uint u_UseAlbedoMap;
-    uint u_UseNormalMap;
-    uint u_UseRoughnessMap;
-
     vec4 u_Albedo;
     float u_Roughness;
     float u_Metalness;
     float u_Emission;
 
+    uint u_UseAlbedoMap;
+    uint u_UseNormalMap;
+    uint u_UseRoughnessMap;
     uint u_UseMetalnessMap;
 };
 
@@ -113,8 +107,9 @@ void main()
     vec3 normal = normalize(Interpolators.Normal);
     if(bool(u_UseNormalMap))
     {
-        normal = texture(u_NormalMap, Interpolators.TexCoords).rgb;
-        normal = normal * 2 - 1;
+        // Normal maps may be BC5 compressed, so Z is reconstructed from XY
+        vec2 normalXY = texture(u_NormalMap, Interpolators.TexCoords).rg * 2 - 1;
+        normal = vec3(normalXY, sqrt(max(1 - dot(normalXY, normalXY), 0.0)));
         normal = normalize(Interpolators.TBN * normal);
     }
     
@@ -90,8 +90,9 @@ void main()
     vec3 normal = normalize(Interpolators.Normal);
     if(bool(u_UseNormalMap))
     {
-        normal = texture(u_NormalMap, Interpolators.TexCoords).rgb;
-        normal = normal * 2 - 1;
+        // Normal maps may be BC5 compressed, so Z is reconstructed from XY
+        vec2 normalXY = texture(u_NormalMap, Interpolators.TexCoords).rg * 2 - 1;
+        normal = vec3(normalXY, sqrt(max(1 - dot(normalXY, normalXY), 0.0)));
         normal = normalize(Interpolators.TBN * normal);
     }
     
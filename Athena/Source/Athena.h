@@ -5,6 +5,7 @@
 // --------Core--------------------
 #include "Athena/Core/Application.h"
 #include "Athena/Core/FileSystem.h"
+#include "Athena/Core/JobSystem.h"
 #include "Athena/Core/Layer.h"
 #include "Athena/Core/UUID.h"
 #include "Athena/Core/Log.h"
@@ -0,0 +1,165 @@
+#include "AssetLoader.h"
+
+#include "Athena/Core/Log.h"
+#include "Athena/Core/Time.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace Athena
+{
+	// Loads block on file IO, so they run on own threads instead of job system,
+	// main thread could pick up long import while it waits for other jobs
+	static constexpr uint32 LoaderThreadsCount = 2;
+	// Main thread time spent per frame on finishing loaded assets, at least one asset is finished every frame
+	static constexpr double FinishTimeBudgetMs = 2.0;
+
+	struct AssetLoadRequest
+	{
+		AssetLoader::LoadFunc Load;
+		AssetLoader::FinishFunc Finish;
+	};
+
+	struct AssetLoaderData
+	{
+		std::vector<std::thread> Threads;
+		std::mutex Mutex;
+		std::condition_variable WakeCondition;
+		bool Running = false;
+
+		// Waiting for loader thread
+		std::deque<AssetLoadRequest> Requests;
+		// Waiting for main thread
+		std::deque<AssetLoader::FinishFunc> Loaded;
+
+		// Submitted and not finished yet
+		std::atomic<uint32> PendingCount = 0;
+	};
+
+	static AssetLoaderData s_Data;
+
+
+	static void LoaderThreadLoop(uint32 index)
+	{
+		String threadName = std::format("AssetLoader {}", index);
+		ATN_PROFILE_THREAD(threadName.c_str());
+
+		while (true)
+		{
+			AssetLoadRequest request;
+			{
+				std::unique_lock lock(s_Data.Mutex);
+				s_Data.WakeCondition.wait(lock, []() { return !s_Data.Requests.empty() || !s_Data.Running; });
+
+				if (!s_Data.Running)
+					break;
+
+				request = std::move(s_Data.Requests.front());
+				s_Data.Requests.pop_front();
+			}
+
+			request.Load();
+
+			std::unique_lock lock(s_Data.Mutex);
+			s_Data.Loaded.push_back(std::move(request.Finish));
+		}
+	}
+
+	static bool FinishNextAsset()
+	{
+		AssetLoader::FinishFunc finish;
+		{
+			std::unique_lock lock(s_Data.Mutex);
+			if (s_Data.Loaded.empty())
+				return false;
+
+			finish = std::move(s_Data.Loaded.front());
+			s_Data.Loaded.pop_front();
+		}
+
+		finish();
+		s_Data.PendingCount.fetch_sub(1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	void AssetLoader::Init()
+	{
+		s_Data.Running = true;
+		s_Data.PendingCount = 0;
+
+		s_Data.Threads.reserve(LoaderThreadsCount);
+		for (uint32 i = 0; i < LoaderThreadsCount; ++i)
+			s_Data.Threads.emplace_back(LoaderThreadLoop, i);
+	}
+
+	void AssetLoader::Shutdown()
+	{
+		// Requests that are not started yet are dropped, loads in progress are completed
+		{
+			std::unique_lock lock(s_Data.Mutex);
+			s_Data.Running = false;
+			s_Data.Requests.clear();
+		}
+		s_Data.WakeCondition.notify_all();
+
+		for (auto& thread : s_Data.Threads)
+			thread.join();
+
+		s_Data.Threads.clear();
+		s_Data.Loaded.clear();
+		s_Data.PendingCount = 0;
+	}
+
+	void AssetLoader::Submit(const LoadFunc& load, const FinishFunc& finish)
+	{
+		// Before Init or after Shutdown load synchronously
+		if (s_Data.Threads.empty())
+		{
+			load();
+			finish();
+			return;
+		}
+
+		s_Data.PendingCount.fetch_add(1, std::memory_order_release);
+
+		{
+			std::unique_lock lock(s_Data.Mutex);
+			s_Data.Requests.push_back({ load, finish });
+		}
+		s_Data.WakeCondition.notify_one();
+	}
+
+	void AssetLoader::Update()
+	{
+		ATN_PROFILE_FUNC();
+
+		Timer timer;
+		while (FinishNextAsset())
+		{
+			if (timer.ElapsedTime().AsMilliseconds() > FinishTimeBudgetMs)
+				break;
+		}
+	}
+
+	void AssetLoader::Flush()
+	{
+		ATN_PROFILE_FUNC();
+
+		while (GetPendingLoadsCount() > 0)
+		{
+			if (!FinishNextAsset())
+				std::this_thread::yield();
+		}
+	}
+
+	uint32 AssetLoader::GetPendingLoadsCount()
+	{
+		return s_Data.PendingCount.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <functional>
+
+
+namespace Athena
+{
+	// Imports assets on background threads, so load requests return immediately.
+	// Loaded assets are finished on main thread at the beginning of frame, where their GPU resources are created.
+	class ATHENA_API AssetLoader
+	{
+	public:
+		using LoadFunc = std::function<void()>;
+		using FinishFunc = std::function<void()>;
+
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// 'load' runs on loader thread, 'finish' runs on main thread in Update after 'load' has returned
+		static void Submit(const LoadFunc& load, const FinishFunc& finish);
+
+		// Finishes loaded assets until frame time budget is spent, called by Renderer at the beginning of frame
+		static void Update();
+		// Blocks until all submitted assets are loaded and finished, main thread only
+		static void Flush();
+
+		static uint32 GetPendingLoadsCount();
+	};
+}
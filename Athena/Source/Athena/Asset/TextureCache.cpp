@@ -0,0 +1,104 @@
+#include "TextureCache.h"
+
+#include "Athena/Asset/TextureImporter.h"
+#include "Athena/Core/FileSystem.h"
+#include "Athena/Utils/HashUtils.h"
+
+#include <mutex>
+
+
+namespace Athena
+{
+	struct TextureCacheData
+	{
+		std::unordered_map<uint64, Texture2D*> Textures;
+		std::mutex Mutex;
+	};
+
+	static TextureCacheData s_Data;
+
+	static uint64 HashImportOptions(const TextureImportOptions& options, uint64 seed)
+	{
+		uint64 hash = seed;
+		hash = Utils::HashFNV1a(&options.Usage, sizeof(options.Usage), hash);
+		hash = Utils::HashFNV1a(&options.sRGB, sizeof(options.sRGB), hash);
+		hash = Utils::HashFNV1a(&options.GenerateMipMaps, sizeof(options.GenerateMipMaps), hash);
+		hash = Utils::HashFNV1a(&options.MaxChannelsNum, sizeof(options.MaxChannelsNum), hash);
+		hash = Utils::HashFNV1a(&options.Compression, sizeof(options.Compression), hash);
+		hash = Utils::HashFNV1a(&options.Streaming, sizeof(options.Streaming), hash);
+		hash = Utils::HashFNV1a(&options.Sampler.Filter, sizeof(options.Sampler.Filter), hash);
+		hash = Utils::HashFNV1a(&options.Sampler.Wrap, sizeof(options.Sampler.Wrap), hash);
+		hash = Utils::HashFNV1a(&options.Sampler.Compare, sizeof(options.Sampler.Compare), hash);
+
+		return hash;
+	}
+
+	uint64 TextureCache::GetKey(const FilePath& path, const TextureImportOptions& options)
+	{
+		std::error_code error;
+		FilePath canonicalPath = std::filesystem::weakly_canonical(path, error);
+		if (error)
+			canonicalPath = path;
+
+		String pathString = canonicalPath.string();
+		int64 writeTime = FileSystem::GetLastWriteTime(path);
+
+		uint64 hash = Utils::HashFNV1a(pathString);
+		hash = Utils::HashFNV1a(&writeTime, sizeof(writeTime), hash);
+
+		return HashImportOptions(options, hash);
+	}
+
+	uint64 TextureCache::GetKey(const void* data, uint64 size, const TextureImportOptions& options)
+	{
+		uint64 hash = Utils::HashFNV1a(data, size);
+		return HashImportOptions(options, hash);
+	}
+
+	Ref<Texture2D> TextureCache::Find(uint64 key)
+	{
+		std::unique_lock lock(s_Data.Mutex);
+
+		auto iter = s_Data.Textures.find(key);
+		if (iter == s_Data.Textures.end())
+			return nullptr;
+
+		// Texture can not be freed while mutex is locked, because its destructor calls Remove
+		return Ref<Texture2D>::TryAcquire(iter->second);
+	}
+
+	Ref<Texture2D> TextureCache::Add(uint64 key, const Ref<Texture2D>& texture)
+	{
+		std::unique_lock lock(s_Data.Mutex);
+
+		auto iter = s_Data.Textures.find(key);
+		if (iter != s_Data.Textures.end())
+		{
+			Ref<Texture2D> existing = Ref<Texture2D>::TryAcquire(iter->second);
+			if (existing)
+				return existing;
+		}
+
+		// If previous texture is being destroyed, Remove compares pointers and keeps new entry
+
+		s_Data.Textures[key] = texture.Raw();
+		texture->m_CacheKey = key;
+
+		return texture;
+	}
+
+	uint32 TextureCache::GetTexturesCount()
+	{
+		std::unique_lock lock(s_Data.Mutex);
+		return (uint32)s_Data.Textures.size();
+	}
+
+	void TextureCache::Remove(uint64 key, Texture2D* texture)
+	{
+		std::unique_lock lock(s_Data.Mutex);
+
+		auto iter = s_Data.Textures.find(key);
+		if (iter != s_Data.Textures.end() && iter->second == texture)
+			s_Data.Textures.erase(iter);
+	}
+}
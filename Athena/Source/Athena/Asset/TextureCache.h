@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+#include "Athena/Renderer/Texture.h"
+
+
+namespace Athena
+{
+	struct TextureImportOptions;
+
+	// Deduplicates imported textures by source and import options.
+	// Cache does not own textures, texture removes itself from cache when last reference is released.
+	class ATHENA_API TextureCache
+	{
+	public:
+		// Key depends on file path and last write time
+		static uint64 GetKey(const FilePath& path, const TextureImportOptions& options);
+		// Key depends on encoded image data
+		static uint64 GetKey(const void* data, uint64 size, const TextureImportOptions& options);
+
+		// Returns nullptr if texture is not cached
+		static Ref<Texture2D> Find(uint64 key);
+		// If alive texture with this key already exists, returns it instead
+		static Ref<Texture2D> Add(uint64 key, const Ref<Texture2D>& texture);
+
+		static uint32 GetTexturesCount();
+
+	private:
+		static void Remove(uint64 key, Texture2D* texture);
+
+		friend class Texture2D;
+	};
+}
@@ -0,0 +1,532 @@
+#include "TextureCompressor.h"
+
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Math/Common.h"
+#include "Athena/Math/Exponential.h"
+#include "Athena/Math/Limits.h"
+#include "Athena/Math/Vector.h"
+
+#include <array>
+
+
+namespace Athena
+{
+	using PixelBlock = byte[16][4];
+
+	static constexpr uint32 BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	struct BlockBitWriter
+	{
+		uint64 Bits[2] = { 0, 0 };
+		uint32 Position = 0;
+
+		void Write(uint32 value, uint32 count)
+		{
+			for (uint32 i = 0; i < count; ++i, ++Position)
+			{
+				if ((value >> i) & 1)
+					Bits[Position / 64] |= 1ull << (Position % 64);
+			}
+		}
+	};
+
+	static float SRGBToLinear(byte value)
+	{
+		static const auto table = []()
+		{
+			std::array<float, 256> result;
+			for (uint32 i = 0; i < 256; ++i)
+			{
+				float c = i / 255.f;
+				result[i] = c <= 0.04045f ? c / 12.92f : Math::Pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			return result;
+		}();
+
+		return table[value];
+	}
+
+	static byte LinearToSRGB(float value)
+	{
+		float c = value <= 0.0031308f ? value * 12.92f : 1.055f * Math::Pow(value, 1.f / 2.4f) - 0.055f;
+		return (byte)Math::Clamp(c * 255.f + 0.5f, 0.f, 255.f);
+	}
+
+	// Principal axis of pixels, endpoints are extremes of pixels projected on it
+	static void ComputeEndpoints(const Vector4* pixels, uint32 count, Vector4& endpoint0, Vector4& endpoint1)
+	{
+		Vector4 mean = Vector4(0.f);
+		Vector4 min = pixels[0];
+		Vector4 max = pixels[0];
+		for (uint32 i = 0; i < count; ++i)
+		{
+			mean += pixels[i];
+			for (uint32 c = 0; c < 4; ++c)
+			{
+				min[c] = Math::Min(min[c], pixels[i][c]);
+				max[c] = Math::Max(max[c], pixels[i][c]);
+			}
+		}
+		mean /= (float)count;
+
+		float covariance[4][4] = {};
+		for (uint32 i = 0; i < count; ++i)
+		{
+			Vector4 diff = pixels[i] - mean;
+			for (uint32 r = 0; r < 4; ++r)
+			{
+				for (uint32 c = 0; c < 4; ++c)
+					covariance[r][c] += diff[r] * diff[c];
+			}
+		}
+
+		// Power iteration, starting from diagonal of bounding box
+		Vector4 axis = max - min;
+		for (uint32 iter = 0; iter < 8; ++iter)
+		{
+			Vector4 next = Vector4(0.f);
+			for (uint32 r = 0; r < 4; ++r)
+			{
+				for (uint32 c = 0; c < 4; ++c)
+					next[r] += covariance[r][c] * axis[c];
+			}
+
+			float scale = Math::Max(Math::Abs(next.x), Math::Abs(next.y), Math::Abs(next.z), Math::Abs(next.w));
+			if (scale < 1e-6f)
+				break;
+
+			axis = next / scale;
+		}
+
+		float axisLength = Math::Dot(axis, axis);
+		if (axisLength < 1e-6f)
+		{
+			endpoint0 = mean;
+			endpoint1 = mean;
+			return;
+		}
+
+		float minProj = Math::MaxValue<float>();
+		float maxProj = Math::MinValue<float>();
+		for (uint32 i = 0; i < count; ++i)
+		{
+			float proj = Math::Dot(pixels[i] - mean, axis) / axisLength;
+			minProj = Math::Min(minProj, proj);
+			maxProj = Math::Max(maxProj, proj);
+		}
+
+		endpoint0 = mean + axis * minProj;
+		endpoint1 = mean + axis * maxProj;
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoint0[c] = Math::Clamp(endpoint0[c], 0.f, 255.f);
+			endpoint1[c] = Math::Clamp(endpoint1[c], 0.f, 255.f);
+		}
+	}
+
+	static uint16 PackRGB565(const Vector4& color)
+	{
+		uint32 r = (uint32)(color.x * 31.f / 255.f + 0.5f);
+		uint32 g = (uint32)(color.y * 63.f / 255.f + 0.5f);
+		uint32 b = (uint32)(color.z * 31.f / 255.f + 0.5f);
+
+		return (uint16)((r << 11) | (g << 5) | b);
+	}
+
+	static Vector4 UnpackRGB565(uint16 color)
+	{
+		uint32 r = (color >> 11) & 31;
+		uint32 g = (color >> 5) & 63;
+		uint32 b = color & 31;
+
+		return Vector4((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0.f);
+	}
+
+	// Pixels with alpha < 128 are encoded as transparent (3 color mode) if 'allowTransparent' is set
+	static void EncodeBC1(const PixelBlock& block, bool allowTransparent, byte* output)
+	{
+		Vector4 pixels[16];
+		bool transparent[16];
+		uint32 opaqueCount = 0;
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			transparent[i] = allowTransparent && block[i][3] < 128;
+			if (!transparent[i])
+				pixels[opaqueCount++] = Vector4(block[i][0], block[i][1], block[i][2], 0.f);
+		}
+
+		bool threeColorMode = opaqueCount != 16;
+		uint16 color0 = 0;
+		uint16 color1 = 0;
+
+		if (opaqueCount != 0)
+		{
+			Vector4 endpoint0, endpoint1;
+			ComputeEndpoints(pixels, opaqueCount, endpoint0, endpoint1);
+
+			color0 = PackRGB565(endpoint1);
+			color1 = PackRGB565(endpoint0);
+		}
+
+		// Mode is selected by order of endpoints: color0 > color1 - 4 colors, otherwise 3 colors + transparent
+		if ((threeColorMode && color0 > color1) || (!threeColorMode && color0 < color1))
+			Math::Swap(color0, color1);
+
+		Vector4 palette[4];
+		palette[0] = UnpackRGB565(color0);
+		palette[1] = UnpackRGB565(color1);
+
+		uint32 paletteSize = 0;
+		if (threeColorMode)
+		{
+			palette[2] = (palette[0] + palette[1]) / 2.f;
+			paletteSize = 3;
+		}
+		else if (color0 != color1)
+		{
+			palette[2] = (palette[0] * 2.f + palette[1]) / 3.f;
+			palette[3] = (palette[0] + palette[1] * 2.f) / 3.f;
+			paletteSize = 4;
+		}
+		else
+		{
+			paletteSize = 1;
+		}
+
+		uint32 indices = 0;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 bestIndex = 3;
+			if (!transparent[i])
+			{
+				Vector4 color = Vector4(block[i][0], block[i][1], block[i][2], 0.f);
+				float bestError = Math::MaxValue<float>();
+				bestIndex = 0;
+
+				for (uint32 p = 0; p < paletteSize; ++p)
+				{
+					Vector4 diff = color - palette[p];
+					float error = Math::Dot(diff, diff);
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = p;
+					}
+				}
+			}
+
+			indices |= bestIndex << (2 * i);
+		}
+
+		memcpy(output, &color0, 2);
+		memcpy(output + 2, &color1, 2);
+		memcpy(output + 4, &indices, 4);
+	}
+
+	// 8 interpolated values mode, red0 > red1
+	static void EncodeBC4(const byte (&values)[16], byte* output)
+	{
+		byte max = values[0];
+		byte min = values[0];
+		for (uint32 i = 1; i < 16; ++i)
+		{
+			max = Math::Max(max, values[i]);
+			min = Math::Min(min, values[i]);
+		}
+
+		uint64 indices = 0;
+		if (max != min)
+		{
+			float scale = 7.f / (max - min);
+			for (uint32 i = 0; i < 16; ++i)
+			{
+				// Position between endpoints: 0 - max, 7 - min
+				uint32 t = (uint32)((max - values[i]) * scale + 0.5f);
+				uint64 code = t == 0 ? 0 : t == 7 ? 1 : t + 1;
+				indices |= code << (3 * i);
+			}
+		}
+
+		output[0] = max;
+		output[1] = min;
+		memcpy(output + 2, &indices, 6);
+	}
+
+	// Mode 6 only: single subset, RGBA 7 bit endpoints with unique p-bits, 4 bit indices
+	static void EncodeBC7(const PixelBlock& block, byte* output)
+	{
+		Vector4 pixels[16];
+		for (uint32 i = 0; i < 16; ++i)
+			pixels[i] = Vector4(block[i][0], block[i][1], block[i][2], block[i][3]);
+
+		Vector4 endpoints[2];
+		ComputeEndpoints(pixels, 16, endpoints[0], endpoints[1]);
+
+		uint32 quantized[2][4];
+		uint32 pbits[2];
+		uint32 colors[2][4];
+
+		for (uint32 e = 0; e < 2; ++e)
+		{
+			float bestError = Math::MaxValue<float>();
+			for (uint32 p = 0; p < 2; ++p)
+			{
+				float error = 0.f;
+				uint32 q[4];
+				for (uint32 c = 0; c < 4; ++c)
+				{
+					q[c] = (uint32)Math::Clamp((endpoints[e][c] - p) / 2.f + 0.5f, 0.f, 127.f);
+					float diff = (float)((q[c] << 1) | p) - endpoints[e][c];
+					error += diff * diff;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					pbits[e] = p;
+					for (uint32 c = 0; c < 4; ++c)
+					{
+						quantized[e][c] = q[c];
+						colors[e][c] = (q[c] << 1) | p;
+					}
+				}
+			}
+		}
+
+		uint32 indices[16];
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			float bestError = Math::MaxValue<float>();
+			for (uint32 w = 0; w < 16; ++w)
+			{
+				float error = 0.f;
+				for (uint32 c = 0; c < 4; ++c)
+				{
+					uint32 value = ((64 - BC7Weights[w]) * colors[0][c] + BC7Weights[w] * colors[1][c] + 32) >> 6;
+					float diff = (float)value - block[i][c];
+					error += diff * diff;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = w;
+				}
+			}
+		}
+
+		// MSB of anchor index is implicit zero
+		if (indices[0] >= 8)
+		{
+			for (uint32 c = 0; c < 4; ++c)
+				Math::Swap(quantized[0][c], quantized[1][c]);
+
+			Math::Swap(pbits[0], pbits[1]);
+
+			for (uint32 i = 0; i < 16; ++i)
+				indices[i] = 15 - indices[i];
+		}
+
+		BlockBitWriter writer;
+		writer.Write(1 << 6, 7);
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			writer.Write(quantized[0][c], 7);
+			writer.Write(quantized[1][c], 7);
+		}
+
+		writer.Write(pbits[0], 1);
+		writer.Write(pbits[1], 1);
+
+		writer.Write(indices[0], 3);
+		for (uint32 i = 1; i < 16; ++i)
+			writer.Write(indices[i], 4);
+
+		memcpy(output, writer.Bits, 16);
+	}
+
+	static void EncodeBlock(const PixelBlock& block, TextureCompression compression, byte* output)
+	{
+		switch (compression)
+		{
+		case TextureCompression::BC1:
+		{
+			EncodeBC1(block, true, output);
+			break;
+		}
+		case TextureCompression::BC3:
+		{
+			byte alpha[16];
+			for (uint32 i = 0; i < 16; ++i)
+				alpha[i] = block[i][3];
+
+			EncodeBC4(alpha, output);
+			EncodeBC1(block, false, output + 8);
+			break;
+		}
+		case TextureCompression::BC4:
+		{
+			byte red[16];
+			for (uint32 i = 0; i < 16; ++i)
+				red[i] = block[i][0];
+
+			EncodeBC4(red, output);
+			break;
+		}
+		case TextureCompression::BC5:
+		{
+			byte red[16], green[16];
+			for (uint32 i = 0; i < 16; ++i)
+			{
+				red[i] = block[i][0];
+				green[i] = block[i][1];
+			}
+
+			EncodeBC4(red, output);
+			EncodeBC4(green, output + 8);
+			break;
+		}
+		case TextureCompression::BC7:
+		{
+			EncodeBC7(block, output);
+			break;
+		}
+		}
+	}
+
+	static void EncodeImage(const byte* rgba, uint32 width, uint32 height, TextureCompression compression, uint32 bytesPerBlock, byte* output)
+	{
+		uint32 blocksX = (width + 3) / 4;
+		uint32 blocksY = (height + 3) / 4;
+
+		JobSystem::ParallelFor(blocksY, JobSystem::GetBatchSize(blocksY, 4), [=](uint32 begin, uint32 end)
+		{
+			PixelBlock block;
+			for (uint32 by = begin; by < end; ++by)
+			{
+				for (uint32 bx = 0; bx < blocksX; ++bx)
+				{
+					// Edge pixels are repeated for blocks that are out of image bounds
+					for (uint32 i = 0; i < 16; ++i)
+					{
+						uint32 x = Math::Min(bx * 4 + i % 4, width - 1);
+						uint32 y = Math::Min(by * 4 + i / 4, height - 1);
+						memcpy(block[i], rgba + ((uint64)y * width + x) * 4, 4);
+					}
+
+					EncodeBlock(block, compression, output + ((uint64)by * blocksX + bx) * bytesPerBlock);
+				}
+			}
+		});
+	}
+
+	static void Downsample(const byte* src, uint32 srcWidth, uint32 srcHeight, byte* dst, uint32 dstWidth, uint32 dstHeight, bool sRGB, bool normalMap)
+	{
+		JobSystem::ParallelFor(dstHeight, JobSystem::GetBatchSize(dstHeight, 16), [=](uint32 begin, uint32 end)
+		{
+			for (uint32 y = begin; y < end; ++y)
+			{
+				for (uint32 x = 0; x < dstWidth; ++x)
+				{
+					uint32 x0 = Math::Min(x * 2, srcWidth - 1);
+					uint32 x1 = Math::Min(x * 2 + 1, srcWidth - 1);
+					uint32 y0 = Math::Min(y * 2, srcHeight - 1);
+					uint32 y1 = Math::Min(y * 2 + 1, srcHeight - 1);
+
+					const byte* texels[4] = {
+						src + ((uint64)y0 * srcWidth + x0) * 4,
+						src + ((uint64)y0 * srcWidth + x1) * 4,
+						src + ((uint64)y1 * srcWidth + x0) * 4,
+						src + ((uint64)y1 * srcWidth + x1) * 4 };
+
+					Vector4 sum = Vector4(0.f);
+					for (const byte* texel : texels)
+					{
+						for (uint32 c = 0; c < 4; ++c)
+							sum[c] += sRGB && c < 3 ? SRGBToLinear(texel[c]) : texel[c] / 255.f;
+					}
+
+					Vector4 average = sum / 4.f;
+					if (normalMap)
+					{
+						Vector3 normal = Vector3(average.x, average.y, average.z) * 2.f - 1.f;
+						float length = normal.Length();
+						normal = length > 1e-6f ? normal / length : Vector3(0.f, 0.f, 1.f);
+						average = Vector4(normal * 0.5f + 0.5f, average.w);
+					}
+
+					byte* output = dst + ((uint64)y * dstWidth + x) * 4;
+					for (uint32 c = 0; c < 4; ++c)
+						output[c] = sRGB && c < 3 ? LinearToSRGB(average[c]) : (byte)Math::Clamp(average[c] * 255.f + 0.5f, 0.f, 255.f);
+				}
+			}
+		});
+	}
+
+	TextureFormat TextureCompressor::GetCompressedFormat(TextureCompression compression, bool sRGB)
+	{
+		switch (compression)
+		{
+		case TextureCompression::BC1: return sRGB ? TextureFormat::BC1_SRGB : TextureFormat::BC1;
+		case TextureCompression::BC3: return sRGB ? TextureFormat::BC3_SRGB : TextureFormat::BC3;
+		case TextureCompression::BC4: return TextureFormat::BC4;
+		case TextureCompression::BC5: return TextureFormat::BC5;
+		case TextureCompression::BC7: return sRGB ? TextureFormat::BC7_SRGB : TextureFormat::BC7;
+		}
+
+		ATN_CORE_ASSERT(false);
+		return TextureFormat::NONE;
+	}
+
+	uint32 TextureCompressor::GetMipLevelsCount(uint32 width, uint32 height)
+	{
+		return Math::Floor(Math::Log2(Math::Max<float>(width, height))) + 1;
+	}
+
+	Buffer TextureCompressor::Compress(const byte* rgba, uint32 width, uint32 height, uint32 mipLevels, TextureCompression compression, bool sRGB)
+	{
+		ATN_PROFILE_FUNC();
+
+		TextureFormat format = GetCompressedFormat(compression, sRGB);
+		uint32 bytesPerBlock = Texture::BytesPerBlock(format);
+		bool normalMap = compression == TextureCompression::BC5;
+
+		uint64 size = 0;
+		for (uint32 mip = 0; mip < mipLevels; ++mip)
+			size += Texture::GetImageSize(format, Math::Max(width >> mip, 1u), Math::Max(height >> mip, 1u));
+
+		Buffer result(size);
+		byte* output = result.Data();
+
+		std::vector<byte> mipData;
+		std::vector<byte> nextMipData;
+		const byte* src = rgba;
+		uint32 srcWidth = width;
+		uint32 srcHeight = height;
+
+		for (uint32 mip = 0; mip < mipLevels; ++mip)
+		{
+			uint32 mipWidth = Math::Max(width >> mip, 1u);
+			uint32 mipHeight = Math::Max(height >> mip, 1u);
+
+			if (mip != 0)
+			{
+				nextMipData.resize((uint64)mipWidth * mipHeight * 4);
+				Downsample(src, srcWidth, srcHeight, nextMipData.data(), mipWidth, mipHeight, sRGB, normalMap);
+
+				mipData.swap(nextMipData);
+				src = mipData.data();
+				srcWidth = mipWidth;
+				srcHeight = mipHeight;
+			}
+
+			EncodeImage(src, mipWidth, mipHeight, compression, bytesPerBlock, output);
+			output += Texture::GetImageSize(format, mipWidth, mipHeight);
+		}
+
+		return result;
+	}
+}
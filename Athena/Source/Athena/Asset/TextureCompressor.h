@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+#include "Athena/Core/Buffer.h"
+#include "Athena/Renderer/Texture.h"
+
+
+namespace Athena
+{
+	enum class TextureCompression
+	{
+		NONE = 0,
+		BC1,	// RGB + 1 bit alpha, 4 bpp
+		BC3,	// RGBA, 8 bpp
+		BC4,	// R, 4 bpp
+		BC5,	// RG, 8 bpp, used for tangent space normal maps
+		BC7		// RGBA, 8 bpp, best quality
+	};
+
+	// CPU block compression of RGBA8 images, blocks are encoded in parallel on job system
+	class ATHENA_API TextureCompressor
+	{
+	public:
+		static TextureFormat GetCompressedFormat(TextureCompression compression, bool sRGB);
+		// Same as number of mips of texture with GenerateMipMap flag
+		static uint32 GetMipLevelsCount(uint32 width, uint32 height);
+
+		// Returns all mip levels one after another, mips are downsampled from RGBA8 input with box filter.
+		// BC5 input is treated as normal map, its mips are renormalized.
+		static Buffer Compress(const byte* rgba, uint32 width, uint32 height, uint32 mipLevels, TextureCompression compression, bool sRGB);
+	};
+}
@@ -1,12 +1,20 @@
 #include "TextureImporter.h"
 
+#include "Athena/Asset/AssetLoader.h"
+#include "Athena/Asset/TextureCache.h"
+#include "Athena/Core/Application.h"
 #include "Athena/Core/FileSystem.h"
 #include "Athena/Core/Log.h"
 #include "Athena/Math/Common.h"
+#include "Athena/Renderer/Renderer.h"
+#include "Athena/Renderer/TextureStreamer.h"
+#include "Athena/Utils/HashUtils.h"
 
 #include <stb_image/stb_image.h>
 #include <stb_image/stb_image_write.h>
 
+#include <atomic>
+
 
 
 namespace Athena
@@ -21,6 +29,385 @@ namespace Athena
 		}
 	}
 
+	// Increment when layout of cooked data or compressor changes
+	static constexpr uint32 TextureCacheVersion = 1;
+	static constexpr uint32 TextureCacheMagic = 0x58544E41;	// 'ATNX'
+
+	struct TextureCacheHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint64 Key;
+		TextureFormat Format;
+		uint32 Width;
+		uint32 Height;
+		uint32 MipLevels;
+		uint64 DataSize;
+	};
+
+	static bool IsCompressionEnabled(const TextureImportOptions& options)
+	{
+		return options.Compression != TextureCompression::NONE && Renderer::GetRenderCaps().TextureCompressionBC;
+	}
+
+	static FilePath GetTextureCachePath(uint64 key)
+	{
+		FilePath cacheFolder = Application::Get().GetConfig().EngineResourcesPath / "Cache/Textures";
+		return cacheFolder / std::format("{}.atex", Utils::HashToString(key));
+	}
+
+	static bool ReadTextureCache(uint64 key, DecodedImage& image)
+	{
+		ATN_PROFILE_FUNC();
+
+		Ref<MappedFile> file = MappedFile::Create(GetTextureCachePath(key));
+		if (!file || file->Size() < sizeof(TextureCacheHeader))
+			return false;
+
+		TextureCacheHeader header;
+		memcpy(&header, file->Data(), sizeof(header));
+
+		if (header.Magic != TextureCacheMagic || header.Version != TextureCacheVersion || header.Key != key)
+			return false;
+
+		if (file->Size() - sizeof(header) < header.DataSize)
+			return false;
+
+		const byte* data = file->Data() + sizeof(header);
+		std::vector<std::span<const byte>> mips(header.MipLevels);
+
+		uint64 offset = 0;
+		for (uint32 mip = 0; mip < header.MipLevels; ++mip)
+		{
+			uint64 mipSize = Texture::GetImageSize(header.Format, Math::Max(header.Width >> mip, 1u), Math::Max(header.Height >> mip, 1u));
+			if (offset + mipSize > header.DataSize)
+				return false;
+
+			mips[mip] = std::span<const byte>(data + offset, mipSize);
+			offset += mipSize;
+		}
+
+		// Mips point into mapped file, so they can be streamed without keeping copy in memory
+		image.File = file;
+		image.Mips = std::move(mips);
+		image.Width = header.Width;
+		image.Height = header.Height;
+		image.Format = header.Format;
+		image.MipLevels = header.MipLevels;
+
+		return true;
+	}
+
+	static std::atomic<uint32> s_TextureCacheTempCounter = 0;
+
+	static void WriteTextureCache(uint64 key, const DecodedImage& image)
+	{
+		ATN_PROFILE_FUNC();
+
+		TextureCacheHeader header;
+		header.Magic = TextureCacheMagic;
+		header.Version = TextureCacheVersion;
+		header.Key = key;
+		header.Format = image.Format;
+		header.Width = image.Width;
+		header.Height = image.Height;
+		header.MipLevels = image.MipLevels;
+		header.DataSize = image.Pixels.Size();
+
+		std::vector<byte> buffer(sizeof(header) + image.Pixels.Size());
+		memcpy(buffer.data(), &header, sizeof(header));
+		memcpy(buffer.data() + sizeof(header), image.Pixels.Data(), image.Pixels.Size());
+
+		FilePath cachePath = GetTextureCachePath(key);
+
+		// Other threads may have cache file mapped, so it is replaced instead of rewritten in place
+		FilePath tempPath = cachePath;
+		tempPath += std::format(".{}.tmp", s_TextureCacheTempCounter.fetch_add(1, std::memory_order_relaxed));
+
+		if (!FileSystem::WriteFile(tempPath, (const char*)buffer.data(), buffer.size()))
+		{
+			ATN_CORE_WARN_TAG("Asset", "Failed to write texture cache '{}'", cachePath);
+			return;
+		}
+
+		// Cache with same key has same content, so failure to replace it is not an error
+		if (!FileSystem::Rename(tempPath, cachePath))
+			FileSystem::Remove(tempPath);
+	}
+
+	static constexpr uint32 DDSMagic = 0x20534444;	// 'DDS '
+	static constexpr uint32 DDSFlagMipMapCount = 0x20000;
+	static constexpr uint32 DDSPixelFormatFourCC = 0x4;
+	static constexpr uint32 DDSPixelFormatRGB = 0x40;
+	static constexpr uint32 DDSPixelFormatLuminance = 0x20000;
+	static constexpr uint32 DDSCaps2CubeMap = 0x200;
+	static constexpr uint32 DDSCaps2Volume = 0x200000;
+	static constexpr uint32 DDSDimensionTexture2D = 3;
+	static constexpr uint32 DDSMiscTextureCube = 0x4;
+
+	struct DDSPixelFormat
+	{
+		uint32 Size;
+		uint32 Flags;
+		uint32 FourCC;
+		uint32 RGBBitCount;
+		uint32 RBitMask;
+		uint32 GBitMask;
+		uint32 BBitMask;
+		uint32 ABitMask;
+	};
+
+	struct DDSHeader
+	{
+		uint32 Size;
+		uint32 Flags;
+		uint32 Height;
+		uint32 Width;
+		uint32 PitchOrLinearSize;
+		uint32 Depth;
+		uint32 MipMapCount;
+		uint32 Reserved1[11];
+		DDSPixelFormat PixelFormat;
+		uint32 Caps;
+		uint32 Caps2;
+		uint32 Caps3;
+		uint32 Caps4;
+		uint32 Reserved2;
+	};
+
+	struct DDSHeaderDX10
+	{
+		uint32 DXGIFormat;
+		uint32 ResourceDimension;
+		uint32 MiscFlag;
+		uint32 ArraySize;
+		uint32 MiscFlags2;
+	};
+
+	static constexpr byte KTX2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+	struct KTX2Header
+	{
+		byte Identifier[12];
+		uint32 VkFormat;
+		uint32 TypeSize;
+		uint32 PixelWidth;
+		uint32 PixelHeight;
+		uint32 PixelDepth;
+		uint32 LayerCount;
+		uint32 FaceCount;
+		uint32 LevelCount;
+		uint32 SupercompressionScheme;
+		uint32 DFDByteOffset;
+		uint32 DFDByteLength;
+		uint32 KVDByteOffset;
+		uint32 KVDByteLength;
+		uint64 SGDByteOffset;
+		uint64 SGDByteLength;
+	};
+
+	struct KTX2LevelIndex
+	{
+		uint64 ByteOffset;
+		uint64 ByteLength;
+		uint64 UncompressedByteLength;
+	};
+
+	static constexpr uint32 MakeFourCC(char a, char b, char c, char d)
+	{
+		return (uint32)a | ((uint32)b << 8) | ((uint32)c << 16) | ((uint32)d << 24);
+	}
+
+	static TextureFormat GetFormatFromDXGI(uint32 format)
+	{
+		switch (format)
+		{
+		case 2:  return TextureFormat::RGBA32F;		// DXGI_FORMAT_R32G32B32A32_FLOAT
+		case 10: return TextureFormat::RGBA16F;		// DXGI_FORMAT_R16G16B16A16_FLOAT
+		case 26: return TextureFormat::R11G11B10F;	// DXGI_FORMAT_R11G11B10_FLOAT
+		case 28: return TextureFormat::RGBA8;		// DXGI_FORMAT_R8G8B8A8_UNORM
+		case 29: return TextureFormat::RGBA8_SRGB;	// DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+		case 34: return TextureFormat::RG16F;		// DXGI_FORMAT_R16G16_FLOAT
+		case 41: return TextureFormat::R32F;		// DXGI_FORMAT_R32_FLOAT
+		case 49: return TextureFormat::RG8;			// DXGI_FORMAT_R8G8_UNORM
+		case 61: return TextureFormat::R8;			// DXGI_FORMAT_R8_UNORM
+		case 71: return TextureFormat::BC1;			// DXGI_FORMAT_BC1_UNORM
+		case 72: return TextureFormat::BC1_SRGB;	// DXGI_FORMAT_BC1_UNORM_SRGB
+		case 77: return TextureFormat::BC3;			// DXGI_FORMAT_BC3_UNORM
+		case 78: return TextureFormat::BC3_SRGB;	// DXGI_FORMAT_BC3_UNORM_SRGB
+		case 80: return TextureFormat::BC4;			// DXGI_FORMAT_BC4_UNORM
+		case 83: return TextureFormat::BC5;			// DXGI_FORMAT_BC5_UNORM
+		case 98: return TextureFormat::BC7;			// DXGI_FORMAT_BC7_UNORM
+		case 99: return TextureFormat::BC7_SRGB;	// DXGI_FORMAT_BC7_UNORM_SRGB
+		}
+
+		return TextureFormat::NONE;
+	}
+
+	static TextureFormat GetFormatFromVulkan(uint32 format)
+	{
+		switch (format)
+		{
+		case 9:   return TextureFormat::R8;			// VK_FORMAT_R8_UNORM
+		case 15:  return TextureFormat::R8_SRGB;	// VK_FORMAT_R8_SRGB
+		case 16:  return TextureFormat::RG8;		// VK_FORMAT_R8G8_UNORM
+		case 22:  return TextureFormat::RG8_SRGB;	// VK_FORMAT_R8G8_SRGB
+		case 37:  return TextureFormat::RGBA8;		// VK_FORMAT_R8G8B8A8_UNORM
+		case 43:  return TextureFormat::RGBA8_SRGB;	// VK_FORMAT_R8G8B8A8_SRGB
+		case 83:  return TextureFormat::RG16F;		// VK_FORMAT_R16G16_SFLOAT
+		case 97:  return TextureFormat::RGBA16F;	// VK_FORMAT_R16G16B16A16_SFLOAT
+		case 100: return TextureFormat::R32F;		// VK_FORMAT_R32_SFLOAT
+		case 109: return TextureFormat::RGBA32F;	// VK_FORMAT_R32G32B32A32_SFLOAT
+		case 122: return TextureFormat::R11G11B10F;	// VK_FORMAT_B10G11R11_UFLOAT_PACK32
+		case 131: return TextureFormat::BC1;		// VK_FORMAT_BC1_RGB_UNORM_BLOCK
+		case 132: return TextureFormat::BC1_SRGB;	// VK_FORMAT_BC1_RGB_SRGB_BLOCK
+		case 133: return TextureFormat::BC1;		// VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+		case 134: return TextureFormat::BC1_SRGB;	// VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+		case 137: return TextureFormat::BC3;		// VK_FORMAT_BC3_UNORM_BLOCK
+		case 138: return TextureFormat::BC3_SRGB;	// VK_FORMAT_BC3_SRGB_BLOCK
+		case 139: return TextureFormat::BC4;		// VK_FORMAT_BC4_UNORM_BLOCK
+		case 141: return TextureFormat::BC5;		// VK_FORMAT_BC5_UNORM_BLOCK
+		case 145: return TextureFormat::BC7;		// VK_FORMAT_BC7_UNORM_BLOCK
+		case 146: return TextureFormat::BC7_SRGB;	// VK_FORMAT_BC7_SRGB_BLOCK
+		}
+
+		return TextureFormat::NONE;
+	}
+
+	// Containers often store color data in UNORM formats, sRGB option selects sRGB view of the same data
+	static TextureFormat ApplySRGB(TextureFormat format, bool sRGB)
+	{
+		if (!sRGB)
+			return format;
+
+		switch (format)
+		{
+		case TextureFormat::R8:	   return TextureFormat::R8_SRGB;
+		case TextureFormat::RG8:   return TextureFormat::RG8_SRGB;
+		case TextureFormat::RGBA8: return TextureFormat::RGBA8_SRGB;
+		case TextureFormat::BC1:   return TextureFormat::BC1_SRGB;
+		case TextureFormat::BC3:   return TextureFormat::BC3_SRGB;
+		case TextureFormat::BC7:   return TextureFormat::BC7_SRGB;
+		}
+
+		return format;
+	}
+
+	static bool IsContainerFile(const FilePath& path)
+	{
+		String extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return std::tolower(c); });
+
+		return extension == ".dds" || extension == ".ktx2";
+	}
+
+	// Larger than any device supports, keeps level sizes far from uint64 overflow
+	static constexpr uint32 MaxContainerImageDimension = 65536;
+
+	// Checked before any mip is read from container file
+	static bool ValidateContainerImage(std::string_view container, const String& name, TextureFormat format, uint32 width, uint32 height, uint32 levelCount)
+	{
+		if (width == 0 || height == 0 || width > MaxContainerImageDimension || height > MaxContainerImageDimension)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Invalid {} file '{}', size is {}x{}", container, name, width, height);
+			return false;
+		}
+
+		uint32 fullMipChain = TextureCompressor::GetMipLevelsCount(width, height);
+		if (levelCount > fullMipChain)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Invalid {} file '{}', {} mip levels for size {}x{}", container, name, levelCount, width, height);
+			return false;
+		}
+
+		// Compressed data is uploaded as is, there is no fallback decoder
+		if (Texture::IsCompressedFormat(format) && !Renderer::GetRenderCaps().TextureCompressionBC)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Failed to load {} file '{}', BC compressed textures are not supported by device", container, name);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Overflow safe check that range lies inside file
+	static bool IsRangeInFile(uint64 offset, uint64 size, uint64 fileSize)
+	{
+		return size <= fileSize && offset <= fileSize - size;
+	}
+
+	// Mips that are not used by GPU are dropped, partial chains can not be completed for compressed formats
+	static void SetContainerMips(const Ref<MappedFile>& file, TextureFormat format, uint32 width, uint32 height,
+		std::vector<std::span<const byte>>&& mips, const TextureImportOptions& options, DecodedImage& image)
+	{
+		uint32 fullMipChain = TextureCompressor::GetMipLevelsCount(width, height);
+		if (!options.GenerateMipMaps)
+		{
+			mips.resize(1);
+		}
+		else if (mips.size() != 1 && mips.size() != fullMipChain)
+		{
+			ATN_CORE_WARN_TAG("Asset", "Texture '{}' has incomplete mip chain ({} of {} levels), only base level is used", options.Name, mips.size(), fullMipChain);
+			mips.resize(1);
+		}
+
+		image.File = file;
+		image.Mips = std::move(mips);
+		image.Width = width;
+		image.Height = height;
+		image.Format = format;
+		image.MipLevels = image.Mips.size();
+	}
+
+	static void ReleaseImage(DecodedImage& image)
+	{
+		image.Pixels.Release();
+		image.File = nullptr;
+		image.Mips.clear();
+	}
+
+	// Replaces RGBA8 pixels with block compressed mip chain
+	static void CompressImage(DecodedImage& image, const TextureImportOptions& options)
+	{
+		uint32 mipLevels = options.GenerateMipMaps ? TextureCompressor::GetMipLevelsCount(image.Width, image.Height) : 1;
+		Buffer compressed = TextureCompressor::Compress(image.Pixels.Data(), image.Width, image.Height, mipLevels, options.Compression, options.sRGB);
+
+		image.Pixels.Release();
+		image.Pixels = compressed;
+		image.Format = TextureCompressor::GetCompressedFormat(options.Compression, options.sRGB);
+		image.MipLevels = mipLevels;
+	}
+
+
+	// Compressed image is replaced with mapped cache file, so it is created the same way as on later loads
+	static void CompressAndCache(uint64 key, DecodedImage& image, const TextureImportOptions& options)
+	{
+		CompressImage(image, options);
+		WriteTextureCache(key, image);
+
+		DecodedImage cached;
+		if (ReadTextureCache(key, cached))
+		{
+			cached.CacheKey = image.CacheKey;
+			ReleaseImage(image);
+			image = std::move(cached);
+		}
+	}
+
+
+	// Filled on loader thread, used on main thread to replace placeholder image
+	struct TextureLoadRequest : public RefCounted
+	{
+		// Image is released when texture is created, unless load is dropped by AssetLoader::Shutdown
+		~TextureLoadRequest()
+		{
+			Image.Pixels.Release();
+		}
+
+		DecodedImage Image;
+		bool Decoded = false;
+	};
+
 
 	Ref<Texture2D> TextureImporter::Load(const FilePath& filepath, bool sRGB)
 	{
@@ -31,12 +418,131 @@ namespace Athena
 	}
 
 	Ref<Texture2D> TextureImporter::Load(const FilePath& filepath, const TextureImportOptions& options)
+	{
+		uint64 cacheKey = TextureCache::GetKey(filepath, options);
+		if (Ref<Texture2D> cached = TextureCache::Find(cacheKey))
+			return cached;
+
+		DecodedImage image;
+		if (!Decode(filepath, options, image))
+		{
+			ATN_CORE_VERIFY(false);
+			return nullptr;
+		}
+
+		image.CacheKey = cacheKey;
+		return Create(image, options, filepath);
+	}
+
+	Ref<Texture2D> TextureImporter::LoadAsync(const FilePath& filepath, bool sRGB)
+	{
+		TextureImportOptions options;
+		options.sRGB = sRGB;
+
+		return LoadAsync(filepath, options);
+	}
+
+	Ref<Texture2D> TextureImporter::LoadAsync(const FilePath& filepath, const TextureImportOptions& options)
+	{
+		if (!FileSystem::Exists(filepath))
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Failed to load texture '{}', file does not exist", filepath);
+			return nullptr;
+		}
+
+		// Material records streamed textures when they are bound, placeholder is bound before image is loaded
+		TextureImportOptions loadOptions = options;
+		loadOptions.Streaming = false;
+
+		uint64 cacheKey = TextureCache::GetKey(filepath, loadOptions);
+		if (Ref<Texture2D> cached = TextureCache::Find(cacheKey))
+			return cached;
+
+		uint32 whiteTextureData = 0xffffffff;
+
+		TextureCreateInfo info;
+		info.Name = loadOptions.Name.empty() ? filepath.filename().string() : loadOptions.Name;
+		info.Format = loadOptions.sRGB ? TextureFormat::RGBA8_SRGB : TextureFormat::RGBA8;
+		info.Usage = loadOptions.Usage;
+		info.Width = 1;
+		info.Height = 1;
+		info.Layers = 1;
+		info.GenerateMipMap = false;
+		info.Sampler = loadOptions.Sampler;
+
+		Ref<Texture2D> placeholder = Texture2D::Create(info, Buffer::Move(&whiteTextureData, sizeof(uint32)));
+		placeholder->m_FilePath = filepath;
+		placeholder = TextureCache::Add(cacheKey, placeholder);
+
+		Ref<TextureLoadRequest> request = Ref<TextureLoadRequest>::Create();
+
+		AssetLoader::Submit([request, filepath, loadOptions]()
+		{
+			request->Decoded = Decode(filepath, loadOptions, request->Image);
+		},
+		[request, filepath, loadOptions, placeholder]()
+		{
+			if (!request->Decoded)
+			{
+				ATN_CORE_ERROR_TAG("Asset", "Failed to load texture '{}'", filepath);
+				return;
+			}
+
+			CreateTexture(request->Image, loadOptions, filepath, placeholder);
+		});
+
+		return placeholder;
+	}
+
+	Ref<Texture2D> TextureImporter::Load(const void* inputData, uint32 inputWidth, uint32 inputHeight, const TextureImportOptions& options)
+	{
+		uint64 cacheKey = TextureCache::GetKey(inputData, GetEncodedSize(inputWidth, inputHeight), options);
+		if (Ref<Texture2D> cached = TextureCache::Find(cacheKey))
+			return cached;
+
+		DecodedImage image;
+		if (!Decode(inputData, inputWidth, inputHeight, options, image))
+		{
+			ATN_CORE_ASSERT(false);
+			return nullptr;
+		}
+
+		image.CacheKey = cacheKey;
+		return Create(image, options);
+	}
+
+	bool TextureImporter::Decode(const FilePath& filepath, const TextureImportOptions& options, DecodedImage& image)
 	{
 		ATN_CORE_VERIFY(FileSystem::Exists(filepath));
 		ATN_CORE_VERIFY(options.MaxChannelsNum != 0 && options.MaxChannelsNum <= 4);
 
+		if (IsContainerFile(filepath))
+		{
+			Ref<MappedFile> file = MappedFile::Create(filepath);
+			if (!file)
+			{
+				ATN_CORE_ERROR_TAG("Asset", "Failed to map texture file '{}'", filepath);
+				return false;
+			}
+
+			TextureImportOptions containerOptions = options;
+			if (containerOptions.Name.empty())
+				containerOptions.Name = filepath.filename().string();
+
+			bool isDDS = file->Size() >= 4 && memcmp(file->Data(), &DDSMagic, 4) == 0;
+			return isDDS ? DecodeDDS(file, containerOptions, image) : DecodeKTX2(file, containerOptions, image);
+		}
+
+		uint64 cookedKey = 0;
+		if (IsCompressionEnabled(options))
+		{
+			cookedKey = TextureCache::GetKey(filepath, options);
+			if (ReadTextureCache(cookedKey, image))
+				return true;
+		}
+
 		uint32 maxChannels = options.MaxChannelsNum;
-		if (maxChannels == 3) // image tiling optimal
+		if (maxChannels == 3 || cookedKey != 0) // image tiling optimal, compressor expects RGBA
 			maxChannels = 4;
 
 		int width, height, channels;
@@ -60,11 +566,11 @@ namespace Athena
 		if (data == nullptr || format == TextureFormat::NONE)
 		{
 			ATN_CORE_ERROR("Failed to load image from {}, width = {}, height = {}, channels = {}", filepath, width, height, channels);
-			ATN_CORE_VERIFY(false);
-			return nullptr;
+			return false;
 		}
 
-		bool extract = channels == 3 || maxChannels < channels;
+		bool compress = cookedKey != 0 && !HDR;
+		bool extract = channels == 3 || maxChannels < channels || (compress && channels != 4);
 		if (HDR == false && extract)
 		{
 			data = ExtractChannels((byte*)data, width, height, channels, maxChannels);
@@ -77,37 +583,38 @@ namespace Athena
 		}
 
 		uint64 size = width * height * Texture::BytesPerPixel(format);
-		Buffer buffer = Buffer::Move(data, size);
+		image.Pixels = Buffer::Move(data, size);
+		image.Width = width;
+		image.Height = height;
+		image.Format = format;
 
-		TextureCreateInfo info;
-		info.Name = options.Name.empty() ? filepath.filename().string() : options.Name;
-		info.Format = format;
-		info.Usage = options.Usage;
-		info.Width = width;
-		info.Height = height;
-		info.Layers = 1;
-		info.GenerateMipMap = options.GenerateMipMaps;
-		info.Sampler = options.Sampler;
-
-		Ref<Texture2D> result = Texture2D::Create(info, buffer);
-		result->m_FilePath = filepath;
+		if (compress)
+			CompressAndCache(cookedKey, image, options);
 
-		buffer.Release();
-		return result;
+		return true;
 	}
 
-	Ref<Texture2D> TextureImporter::Load(const void* inputData, uint32 inputWidth, uint32 inputHeight, const TextureImportOptions& options)
+	bool TextureImporter::Decode(const void* inputData, uint32 inputWidth, uint32 inputHeight, const TextureImportOptions& options, DecodedImage& image)
 	{
 		ATN_CORE_VERIFY(options.MaxChannelsNum != 0 && options.MaxChannelsNum <= 4);
 
+		const uint32 size = GetEncodedSize(inputWidth, inputHeight);
+
+		uint64 cookedKey = 0;
+		if (IsCompressionEnabled(options))
+		{
+			cookedKey = TextureCache::GetKey(inputData, size, options);
+			if (ReadTextureCache(cookedKey, image))
+				return true;
+		}
+
 		uint32 maxChannels = options.MaxChannelsNum;
-		if (maxChannels == 3) // image tiling optimal
+		if (maxChannels == 3 || cookedKey != 0) // image tiling optimal, compressor expects RGBA
 			maxChannels = 4;
 
 		int width, height, channels;
 		void* data = nullptr;
 
-		const uint32 size = inputHeight == 0 ? inputWidth : inputWidth * inputHeight;
 		data = stbi_load_from_memory((const stbi_uc*)inputData, size, &width, &height, &channels, 0);
 
 		TextureFormat format = GetFormat(channels, options.sRGB);
@@ -115,34 +622,251 @@ namespace Athena
 		if (data == nullptr || format == TextureFormat::NONE)
 		{
 			ATN_CORE_ERROR("Failed to load image from memory '{}', width = {}, height = {}, channels = {}", options.Name, width, height, channels);
-			ATN_CORE_ASSERT(false);
-			return nullptr;
+			return false;
 		}
 
-		if (channels == 3 || maxChannels < channels)
+		if (channels == 3 || maxChannels < channels || (cookedKey != 0 && channels != 4))
 		{
 			data = ExtractChannels((byte*)data, width, height, channels, maxChannels);
 			format = GetFormat(maxChannels, options.sRGB);
 		}
 
 		uint64 dataSize = width * height * Texture::BytesPerPixel(format);
-		Buffer buffer = Buffer::Move(data, dataSize);
+		image.Pixels = Buffer::Move(data, dataSize);
+		image.Width = width;
+		image.Height = height;
+		image.Format = format;
+
+		if (cookedKey != 0)
+			CompressAndCache(cookedKey, image, options);
+
+		return true;
+	}
+
+	bool TextureImporter::DecodeDDS(const Ref<MappedFile>& file, const TextureImportOptions& options, DecodedImage& image)
+	{
+		const byte* data = file->Data();
+		uint64 offset = sizeof(DDSMagic) + sizeof(DDSHeader);
+
+		if (file->Size() < offset)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Invalid DDS file '{}'", options.Name);
+			return false;
+		}
+
+		DDSHeader header;
+		memcpy(&header, data + sizeof(DDSMagic), sizeof(header));
+
+		const DDSPixelFormat& pixelFormat = header.PixelFormat;
+		bool supported = (header.Caps2 & (DDSCaps2CubeMap | DDSCaps2Volume)) == 0;
+		TextureFormat format = TextureFormat::NONE;
+
+		if ((pixelFormat.Flags & DDSPixelFormatFourCC) && pixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0'))
+		{
+			if (file->Size() < offset + sizeof(DDSHeaderDX10))
+			{
+				ATN_CORE_ERROR_TAG("Asset", "Invalid DDS file '{}'", options.Name);
+				return false;
+			}
+
+			DDSHeaderDX10 headerDX10;
+			memcpy(&headerDX10, data + offset, sizeof(headerDX10));
+			offset += sizeof(headerDX10);
+
+			supported = supported && headerDX10.ResourceDimension == DDSDimensionTexture2D && headerDX10.ArraySize <= 1 && (headerDX10.MiscFlag & DDSMiscTextureCube) == 0;
+			format = GetFormatFromDXGI(headerDX10.DXGIFormat);
+		}
+		else if (pixelFormat.Flags & DDSPixelFormatFourCC)
+		{
+			switch (pixelFormat.FourCC)
+			{
+			case MakeFourCC('D', 'X', 'T', '1'): format = TextureFormat::BC1; break;
+			case MakeFourCC('D', 'X', 'T', '5'): format = TextureFormat::BC3; break;
+			case MakeFourCC('A', 'T', 'I', '1'): format = TextureFormat::BC4; break;
+			case MakeFourCC('B', 'C', '4', 'U'): format = TextureFormat::BC4; break;
+			case MakeFourCC('A', 'T', 'I', '2'): format = TextureFormat::BC5; break;
+			case MakeFourCC('B', 'C', '5', 'U'): format = TextureFormat::BC5; break;
+			}
+		}
+		else if ((pixelFormat.Flags & DDSPixelFormatRGB) && pixelFormat.RGBBitCount == 32 &&
+			pixelFormat.RBitMask == 0x000000FF && pixelFormat.GBitMask == 0x0000FF00 && pixelFormat.BBitMask == 0x00FF0000)
+		{
+			format = TextureFormat::RGBA8;
+		}
+		else if ((pixelFormat.Flags & DDSPixelFormatLuminance) && pixelFormat.RGBBitCount == 8)
+		{
+			format = TextureFormat::R8;
+		}
+
+		if (!supported || format == TextureFormat::NONE)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Unsupported DDS file '{}' (only 2D textures in BC1-5, BC7, R8, RG8, RGBA8 and float formats are supported)", options.Name);
+			return false;
+		}
+
+		format = ApplySRGB(format, options.sRGB);
+		uint32 width = header.Width;
+		uint32 height = header.Height;
+		uint32 levelCount = (header.Flags & DDSFlagMipMapCount) ? Math::Max(header.MipMapCount, 1u) : 1;
+
+		if (!ValidateContainerImage("DDS", options.Name, format, width, height, levelCount))
+			return false;
+
+		// Mips are stored from largest to smallest without padding
+		std::vector<std::span<const byte>> mips(levelCount);
+		for (uint32 level = 0; level < levelCount; ++level)
+		{
+			uint64 levelSize = Texture::GetImageSize(format, Math::Max(width >> level, 1u), Math::Max(height >> level, 1u));
+			if (!IsRangeInFile(offset, levelSize, file->Size()))
+			{
+				ATN_CORE_ERROR_TAG("Asset", "DDS file '{}' is truncated", options.Name);
+				return false;
+			}
+
+			mips[level] = std::span<const byte>(data + offset, levelSize);
+			offset += levelSize;
+		}
+
+		SetContainerMips(file, format, width, height, std::move(mips), options, image);
+		return true;
+	}
+
+	bool TextureImporter::DecodeKTX2(const Ref<MappedFile>& file, const TextureImportOptions& options, DecodedImage& image)
+	{
+		const byte* data = file->Data();
+
+		if (file->Size() < sizeof(KTX2Header) || memcmp(data, KTX2Identifier, sizeof(KTX2Identifier)) != 0)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Invalid KTX2 file '{}'", options.Name);
+			return false;
+		}
+
+		KTX2Header header;
+		memcpy(&header, data, sizeof(header));
+
+		TextureFormat format = GetFormatFromVulkan(header.VkFormat);
+		bool supported = header.PixelDepth == 0 && header.LayerCount <= 1 && header.FaceCount == 1 && header.SupercompressionScheme == 0;
+
+		if (!supported || format == TextureFormat::NONE)
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Unsupported KTX2 file '{}' (only 2D textures without supercompression in BC1-5, BC7, R8, RG8, RGBA8 and float formats are supported)", options.Name);
+			return false;
+		}
+
+		format = ApplySRGB(format, options.sRGB);
+		uint32 width = header.PixelWidth;
+		uint32 height = header.PixelHeight;
+		uint32 levelCount = Math::Max(header.LevelCount, 1u);
+
+		if (!ValidateContainerImage("KTX2", options.Name, format, width, height, levelCount))
+			return false;
+
+		if (file->Size() < sizeof(KTX2Header) + levelCount * sizeof(KTX2LevelIndex))
+		{
+			ATN_CORE_ERROR_TAG("Asset", "Invalid KTX2 file '{}'", options.Name);
+			return false;
+		}
+
+		// Level index starts from base level, data of levels is stored from smallest to largest
+		std::vector<std::span<const byte>> mips(levelCount);
+		for (uint32 level = 0; level < levelCount; ++level)
+		{
+			KTX2LevelIndex index;
+			memcpy(&index, data + sizeof(KTX2Header) + level * sizeof(KTX2LevelIndex), sizeof(index));
+
+			uint64 levelSize = Texture::GetImageSize(format, Math::Max(width >> level, 1u), Math::Max(height >> level, 1u));
+			if (index.ByteLength < levelSize || !IsRangeInFile(index.ByteOffset, levelSize, file->Size()))
+			{
+				ATN_CORE_ERROR_TAG("Asset", "KTX2 file '{}' is truncated", options.Name);
+				return false;
+			}
+
+			mips[level] = std::span<const byte>(data + index.ByteOffset, levelSize);
+		}
+
+		SetContainerMips(file, format, width, height, std::move(mips), options, image);
+		return true;
+	}
+
+	Ref<Texture2D> TextureImporter::Create(DecodedImage& image, const TextureImportOptions& options, const FilePath& filepath)
+	{
+		return CreateTexture(image, options, filepath, nullptr);
+	}
+
+	Ref<Texture2D> TextureImporter::CreateTexture(DecodedImage& image, const TextureImportOptions& options, const FilePath& filepath, const Ref<Texture2D>& target)
+	{
+		// Target is already registered in cache
+		if (target)
+			image.CacheKey = 0;
+
+		if (image.CacheKey != 0)
+		{
+			if (Ref<Texture2D> cached = TextureCache::Find(image.CacheKey))
+			{
+				ReleaseImage(image);
+				return cached;
+			}
+		}
 
 		TextureCreateInfo info;
-		info.Name = options.Name;
-		info.Format = format;
+		info.Name = options.Name.empty() ? filepath.filename().string() : options.Name;
+		info.Format = image.Format;
 		info.Usage = options.Usage;
-		info.Width = width;
-		info.Height = height;
+		info.Width = image.Width;
+		info.Height = image.Height;
 		info.Layers = 1;
-		info.GenerateMipMap = options.GenerateMipMaps;
+		// Compressed formats can not be blitted, their mips are generated on CPU or stored in file
+		info.GenerateMipMap = options.GenerateMipMaps && image.MipLevels == 1 && !Texture::IsCompressedFormat(image.Format);
+		info.PrecomputedMips = image.MipLevels > 1;
 		info.Sampler = options.Sampler;
 
-		Ref<Texture2D> result = Texture2D::Create(info, buffer);
-		buffer.Release();
+		// Streamed texture starts with small mips, larger mips are loaded when they are visible on screen
+		bool streamed = options.Streaming && image.File && image.MipLevels > 1 && TextureStreamer::IsEnabled();
+		if (streamed)
+		{
+			info.FirstResidentMip = TextureStreamer::GetTailMip(image.Width, image.Height, image.MipLevels);
+			streamed = info.FirstResidentMip != 0;
+		}
+
+		Ref<Texture2D> result = target;
+		if (image.File)
+		{
+			// Mips are copied into staging memory straight from mapped file
+			if (result)
+				result->Recreate(info, Buffer());
+			else
+				result = Texture2D::Create(info);
+
+			for (uint32 mip = info.FirstResidentMip; mip < image.Mips.size(); ++mip)
+				result->UploadMips(image.Mips[mip].data(), image.Mips[mip].size(), mip - info.FirstResidentMip);
+
+			if (streamed)
+				TextureStreamer::Register(result, image.File, image.Mips);
+		}
+		else if (result)
+		{
+			result->Recreate(info, image.Pixels);
+		}
+		else
+		{
+			result = Texture2D::Create(info, image.Pixels);
+		}
+
+		result->m_FilePath = filepath;
+
+		ReleaseImage(image);
+
+		if (image.CacheKey != 0)
+			result = TextureCache::Add(image.CacheKey, result);
+
 		return result;
 	}
 
+	uint32 TextureImporter::GetEncodedSize(uint32 width, uint32 height)
+	{
+		return height == 0 ? width : width * height;
+	}
+
 	TextureFormat TextureImporter::GetFormat(uint32 channels, bool sRGB)
 	{
 		switch (channels)
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "Athena/Core/Core.h"
+#include "Athena/Core/FileSystem.h"
+#include "Athena/Asset/TextureCompressor.h"
 #include "Athena/Renderer/Texture.h"
 
+#include <span>
+
 
 namespace Athena
 {
@@ -13,10 +17,31 @@ namespace Athena
 		bool sRGB = false;
 		bool GenerateMipMaps = true;
 		uint32 MaxChannelsNum = 4;	 // 3 is not supported
+		// Compressed images are cached on disk, ignored for HDR images and if device does not support BC formats
+		TextureCompression Compression = TextureCompression::NONE;
+		// Mips of DDS, KTX2 and compressed images are loaded by TextureStreamer depending on screen size of materials
+		bool Streaming = false;
 
 		TextureSamplerCreateInfo Sampler;
 	};
 
+	// CPU side image, produced by TextureImporter::Decode
+	struct DecodedImage
+	{
+		Buffer Pixels;
+		uint32 Width = 0;
+		uint32 Height = 0;
+		TextureFormat Format = TextureFormat::NONE;
+		// If more than 1, pixels contain all mip levels one after another
+		uint32 MipLevels = 1;
+		// Set for container formats (DDS, KTX2) instead of pixels,
+		// mips point into mapped file and are uploaded without intermediate copies
+		Ref<MappedFile> File;
+		std::vector<std::span<const byte>> Mips;
+		// If not 0, texture created from this image is shared through TextureCache
+		uint64 CacheKey = 0;
+	};
+
 	class ATHENA_API TextureImporter
 	{
 	public:
@@ -25,10 +50,31 @@ namespace Athena
 
 		static Ref<Texture2D> Load(const void* data, uint32 width, uint32 height, const TextureImportOptions& options = TextureImportOptions());
 
+		// Returns immediately, texture is white placeholder until image is decoded on AssetLoader thread
+		// and uploaded at the beginning of frame. Texture is shared through TextureCache while it loads, it is never streamed.
+		static Ref<Texture2D> LoadAsync(const FilePath& path, bool sRGB = false);
+		static Ref<Texture2D> LoadAsync(const FilePath& path, const TextureImportOptions& options);
+
+		// Decode functions do not touch GPU and can be called from any thread.
+		// DDS and KTX2 files are mapped and their stored mip chains are used as is.
+		static bool Decode(const FilePath& path, const TextureImportOptions& options, DecodedImage& image);
+		static bool Decode(const void* data, uint32 width, uint32 height, const TextureImportOptions& options, DecodedImage& image);
+		// Creates texture from decoded image and releases image memory
+		static Ref<Texture2D> Create(DecodedImage& image, const TextureImportOptions& options, const FilePath& path = FilePath());
+
+		// Size of encoded image in memory, height is 0 for compressed data
+		static uint32 GetEncodedSize(uint32 width, uint32 height);
+
 	private:
+		// If 'target' is set, its image is replaced instead of creating new texture
+		static Ref<Texture2D> CreateTexture(DecodedImage& image, const TextureImportOptions& options, const FilePath& path, const Ref<Texture2D>& target);
+
 		static TextureFormat GetFormat(uint32 channels, bool sRGB);
 		static TextureFormat GetHDRFormat(uint32 channels);
 
+		static bool DecodeDDS(const Ref<MappedFile>& file, const TextureImportOptions& options, DecodedImage& image);
+		static bool DecodeKTX2(const Ref<MappedFile>& file, const TextureImportOptions& options, DecodedImage& image);
+
 		static void* ExtractChannels(byte* data, uint32 width, uint32 height, uint32 channels, uint32 desiredChannels);
 		static void* ExtractChannelsHDR(float* data, uint32 width, uint32 height, uint32 channels, uint32 desiredChannels);
 	};
@@ -15,6 +15,8 @@ namespace Athena
 		ATN_CORE_VERIFY(s_Instance == nullptr, "Application already exists!");
 		s_Instance = this;
 
+		Timer timer;
+
 		m_Config = appinfo.AppConfig;
 
 		if (m_Config.WorkingDirectory != FilePath())
@@ -23,12 +25,15 @@ namespace Athena
 		if (m_Config.CleanCacheOnLoad)
 			FileSystem::Remove(m_Config.EngineResourcesPath / "Cache");
 
-		Log::Init(m_Config.EnableConsole);
+		Log::Init(m_Config.EnableConsole, appinfo.LogConfig);
+		JobSystem::Init(appinfo.JobSystemConfig);
 		Renderer::Init(appinfo.RendererConfig);
 		CreateMainWindow(appinfo.WindowInfo);
 		Platform::Init();
 		InitImGui();
 		ScriptEngine::Init(appinfo.ScriptConfig);
+
+		ATN_CORE_TIMING_TAG("Application", "Startup took {}", timer.ElapsedTime());
 	}
 
 	Application::~Application()
@@ -44,6 +49,9 @@ namespace Athena
 
 		ScriptEngine::Shutdown();
 		m_Window.Release();
+
+		JobSystem::Shutdown();
+		Log::Shutdown();
 	}
 
 	void Application::Run()
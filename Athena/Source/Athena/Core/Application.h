@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Athena/Core/Core.h"
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Core/Log.h"
 #include "Athena/Core/Time.h"
 #include "Athena/Core/LayerStack.h"
 #include "Athena/Core/Window.h"
@@ -28,6 +30,8 @@ namespace Athena
 	struct ApplicationCreateInfo
 	{
 		AppConfig AppConfig;
+		LogConfig LogConfig;
+		JobSystemConfig JobSystemConfig;
 		RendererConfig RendererConfig;
 		ScriptConfig ScriptConfig;
 		WindowCreateInfo WindowInfo;
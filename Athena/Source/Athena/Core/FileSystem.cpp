@@ -2,6 +2,16 @@
 
 #include <filesystem>
 
+#ifdef ATN_PLATFORM_WINDOWS
+	#include <Windows.h>
+	#undef CreateDirectory
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
 
 namespace Athena
 {
@@ -74,6 +84,14 @@ namespace Athena
 		return std::filesystem::remove_all(path);
 	}
 
+	bool FileSystem::Rename(const FilePath& oldPath, const FilePath& newPath)
+	{
+		std::error_code error;
+		std::filesystem::rename(oldPath, newPath, error);
+
+		return !error;
+	}
+
 	FilePath FileSystem::GetWorkingDirectory()
 	{
 		return std::filesystem::current_path();
@@ -93,4 +111,87 @@ namespace Athena
 	{
 		return std::filesystem::exists(path);
 	}
+
+	int64 FileSystem::GetLastWriteTime(const FilePath& path)
+	{
+		std::error_code error;
+		auto time = std::filesystem::last_write_time(path, error);
+
+		if (error)
+			return 0;
+
+		return time.time_since_epoch().count();
+	}
+
+	Ref<MappedFile> MappedFile::Create(const FilePath& path)
+	{
+		Ref<MappedFile> result = Ref<MappedFile>::Create();
+
+#ifdef ATN_PLATFORM_WINDOWS
+		// Share delete, so file can be replaced while it is mapped
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		result->m_FileHandle = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			return nullptr;
+
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+			return nullptr;
+
+		result->m_MappingHandle = mapping;
+		result->m_Data = (const byte*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		result->m_Size = size.QuadPart;
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file == -1)
+			return nullptr;
+
+		// Descriptor is stored with +1 offset, so that null handle means no file
+		result->m_FileHandle = (void*)(intptr_t)(file + 1);
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+			return nullptr;
+
+		void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED)
+			return nullptr;
+
+		result->m_Data = (const byte*)data;
+		result->m_Size = fileStat.st_size;
+#endif
+
+		if (result->m_Data == nullptr)
+		{
+			ATN_CORE_ERROR_TAG("[FileSystem]", "Failed to map file {}", path);
+			return nullptr;
+		}
+
+		return result;
+	}
+
+	MappedFile::~MappedFile()
+	{
+#ifdef ATN_PLATFORM_WINDOWS
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+#else
+		if (m_Data)
+			munmap((void*)m_Data, m_Size);
+
+		if (m_FileHandle)
+			close((int)(intptr_t)m_FileHandle - 1);
+#endif
+	}
 }
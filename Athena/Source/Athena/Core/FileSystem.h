@@ -18,11 +18,35 @@ namespace Athena
 
 		static bool WriteFile(const FilePath& path, const char* bytes, uint64 size);
 		static bool Remove(const FilePath& path);
+		// Replaces 'newPath' if it exists
+		static bool Rename(const FilePath& oldPath, const FilePath& newPath);
 
 		static FilePath GetWorkingDirectory();
 		static void SetWorkingDirectory(const FilePath& path);
 
 		static void CreateDirectory(const FilePath& path);
 		static bool Exists(const FilePath& path);
+		// Returns 0 if file does not exist
+		static int64 GetLastWriteTime(const FilePath& path);
+	};
+
+	// Read-only view of file contents mapped into address space,
+	// pages are loaded by OS on first access
+	class ATHENA_API MappedFile : public RefCounted
+	{
+	public:
+		// Returns nullptr if file does not exist or is empty
+		static Ref<MappedFile> Create(const FilePath& path);
+		~MappedFile();
+
+		const byte* Data() const { return m_Data; }
+		uint64 Size() const { return m_Size; }
+
+	private:
+		const byte* m_Data = nullptr;
+		uint64 m_Size = 0;
+
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
 	};
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <mutex>
+#include <vector>
+
+
+namespace Athena
+{
+	// Thread safe allocator of small integer IDs, released IDs are reused
+	// so IDs stay below capacity while live objects fit in it
+	class IDPool
+	{
+	public:
+		IDPool(uint32 capacity)
+			: m_Capacity(capacity)
+		{
+
+		}
+
+		uint32 Allocate()
+		{
+			std::scoped_lock lock(m_Mutex);
+
+			if (!m_FreeIDs.empty())
+			{
+				uint32 id = m_FreeIDs.back();
+				m_FreeIDs.pop_back();
+				return id;
+			}
+
+			ATN_CORE_ASSERT(m_NextID < m_Capacity, "IDPool is out of IDs");
+			return m_NextID++;
+		}
+
+		void Release(uint32 id)
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_FreeIDs.push_back(id);
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::vector<uint32> m_FreeIDs;
+		uint32 m_NextID = 0;
+		uint32 m_Capacity;
+	};
+}
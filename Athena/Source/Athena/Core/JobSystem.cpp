@@ -0,0 +1,397 @@
+#include "JobSystem.h"
+
+#include "Athena/Core/Log.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+
+namespace Athena
+{
+	struct Job
+	{
+		JobFunc Func;
+		JobCounter* Counter = nullptr;
+		bool Background = false;
+	};
+
+	// Chase-Lev deque with fixed capacity.
+	// Owner thread pushes and pops from the bottom, other threads steal from the top.
+	class WorkStealingQueue
+	{
+	public:
+		static constexpr int64 Capacity = 4096;
+
+	public:
+		bool Push(Job* job)
+		{
+			int64 bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64 top = m_Top.load(std::memory_order_acquire);
+
+			if (bottom - top >= Capacity)
+				return false;
+
+			m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		Job* Pop()
+		{
+			int64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64 top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+
+			// Last job in the queue, race with thieves
+			if (top == bottom)
+			{
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return job;
+		}
+
+		Job* Steal()
+		{
+			int64 top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return job;
+		}
+
+	private:
+		alignas(64) std::atomic<int64> m_Top = 0;
+		alignas(64) std::atomic<int64> m_Bottom = 0;
+		std::atomic<Job*> m_Jobs[Capacity] = {};
+	};
+
+	// Unbounded queue shared by all threads
+	class SharedJobQueue
+	{
+	public:
+		void Push(Job* job)
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Jobs.push_back(job);
+			m_Size.fetch_add(1, std::memory_order_release);
+		}
+
+		Job* Pop()
+		{
+			if (m_Size.load(std::memory_order_acquire) == 0)
+				return nullptr;
+
+			std::lock_guard lock(m_Mutex);
+			if (m_Jobs.empty())
+				return nullptr;
+
+			Job* job = m_Jobs.front();
+			m_Jobs.pop_front();
+			m_Size.fetch_sub(1, std::memory_order_release);
+
+			return job;
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::deque<Job*> m_Jobs;
+		std::atomic<uint32> m_Size = 0;
+	};
+
+	struct JobSystemData
+	{
+		JobSystemConfig Config;
+		uint32 ThreadsCount = 0;
+
+		std::vector<std::thread> Workers;
+		// [0] - main thread, [1, ThreadsCount) - workers
+		std::unique_ptr<WorkStealingQueue[]> Queues;
+
+		// Dependents released by other threads or jobs submitted when thread deque is full
+		SharedJobQueue SharedQueue;
+		// Jobs submitted from non-job threads and jobs scheduled by them
+		SharedJobQueue BackgroundQueue;
+
+		std::mutex WakeMutex;
+		std::condition_variable WakeCondition;
+		std::atomic<uint32> PendingJobs = 0;
+		std::atomic<bool> Running = false;
+	};
+
+	static JobSystemData s_Data;
+	static thread_local uint32 s_ThreadIndex = UINT32_MAX;
+	static thread_local bool s_InBackgroundJob = false;
+
+
+	bool JobSystem::IsBackgroundContext()
+	{
+		return s_ThreadIndex == UINT32_MAX || s_InBackgroundJob;
+	}
+
+	void JobSystem::Submit(Job* job)
+	{
+		// Counted before job becomes visible, otherwise thread that takes it
+		// could decrement first and counter would wrap below zero
+		s_Data.PendingJobs.fetch_add(1, std::memory_order_release);
+
+		uint32 index = s_ThreadIndex;
+		if (job->Background)
+			s_Data.BackgroundQueue.Push(job);
+		else if (index == UINT32_MAX || !s_Data.Queues[index].Push(job))
+			s_Data.SharedQueue.Push(job);
+
+		{
+			std::lock_guard lock(s_Data.WakeMutex);
+		}
+		s_Data.WakeCondition.notify_one();
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		// Jobs scheduled from background job are background too
+		bool wasInBackgroundJob = s_InBackgroundJob;
+		s_InBackgroundJob = job->Background;
+		job->Func();
+		s_InBackgroundJob = wasInBackgroundJob;
+
+		JobCounter* counter = job->Counter;
+		delete job;
+
+		if (counter)
+			FinishJob(counter);
+	}
+
+	Job* JobSystem::FetchJob()
+	{
+		Job* job = nullptr;
+		uint32 index = s_ThreadIndex;
+
+		// Other threads (e.g. asset loaders) execute only background jobs,
+		// jobs from thread deques may use per-thread resources indexed by GetCurrentThreadIndex
+		if (index == UINT32_MAX)
+		{
+			job = s_Data.BackgroundQueue.Pop();
+		}
+		else
+		{
+			job = s_Data.Queues[index].Pop();
+
+			if (!job)
+				job = s_Data.SharedQueue.Pop();
+
+			for (uint32 i = 1; i < s_Data.ThreadsCount && !job; ++i)
+			{
+				uint32 victim = (index + i) % s_Data.ThreadsCount;
+				job = s_Data.Queues[victim].Steal();
+			}
+
+			// Main thread does not execute background jobs, so frame waits are not delayed by asset imports
+			if (!job && index != 0)
+				job = s_Data.BackgroundQueue.Pop();
+		}
+
+		if (job)
+			s_Data.PendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+
+		return job;
+	}
+
+	bool JobSystem::ExecuteNextJob()
+	{
+		Job* job = FetchJob();
+		if (!job)
+			return false;
+
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::FinishJob(JobCounter* counter)
+	{
+		uint32 value = counter->m_Value.load(std::memory_order_relaxed);
+		while (value > 1)
+		{
+			if (counter->m_Value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+				return;
+		}
+
+		// Possibly last job, dependents are taken under lock,
+		// waiting thread may destroy counter right after it becomes zero
+		std::vector<Job*> dependents;
+		{
+			std::lock_guard lock(counter->m_DependentsMutex);
+			if (counter->m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				dependents.swap(counter->m_Dependents);
+		}
+
+		for (Job* job : dependents)
+			Submit(job);
+	}
+
+	void JobSystem::WorkerThreadLoop(uint32 index)
+	{
+		s_ThreadIndex = index;
+
+		String threadName = std::format("Worker {}", index);
+		ATN_PROFILE_THREAD(threadName.c_str());
+
+		while (s_Data.Running.load(std::memory_order_acquire))
+		{
+			if (ExecuteNextJob())
+				continue;
+
+			std::unique_lock lock(s_Data.WakeMutex);
+			s_Data.WakeCondition.wait(lock, []()
+			{
+				return s_Data.PendingJobs.load(std::memory_order_acquire) > 0 || !s_Data.Running.load(std::memory_order_acquire);
+			});
+		}
+	}
+
+
+	JobCounter::~JobCounter()
+	{
+		ATN_CORE_ASSERT(IsDone(), "JobCounter destroyed before all jobs are finished!");
+
+		// Wait until last finished job releases the lock
+		std::lock_guard lock(m_DependentsMutex);
+	}
+
+	void JobSystem::Init(const JobSystemConfig& config)
+	{
+		ATN_CORE_VERIFY(!s_Data.Running, "JobSystem already exists!");
+
+		s_Data.Config = config;
+
+		uint32 workersCount = config.WorkerThreadsCount;
+		if (workersCount == 0)
+		{
+			uint32 hardwareThreads = std::thread::hardware_concurrency();
+			workersCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		s_Data.ThreadsCount = workersCount + 1;
+		s_Data.Queues = std::make_unique<WorkStealingQueue[]>(s_Data.ThreadsCount);
+		s_Data.Running = true;
+
+		s_ThreadIndex = 0;
+
+		s_Data.Workers.reserve(workersCount);
+		for (uint32 i = 1; i < s_Data.ThreadsCount; ++i)
+			s_Data.Workers.emplace_back(WorkerThreadLoop, i);
+
+		ATN_CORE_INFO_TAG("JobSystem", "Init JobSystem with {} worker threads", workersCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		// Finish remaining jobs, so no counter is left waiting
+		while (ExecuteNextJob());
+
+		s_Data.Running = false;
+		{
+			std::lock_guard lock(s_Data.WakeMutex);
+		}
+		s_Data.WakeCondition.notify_all();
+
+		for (auto& worker : s_Data.Workers)
+			worker.join();
+
+		while (ExecuteNextJob());
+
+		// Background jobs left by other threads
+		while (Job* job = s_Data.BackgroundQueue.Pop())
+		{
+			s_Data.PendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+			Execute(job);
+		}
+
+		s_Data.Workers.clear();
+		s_Data.Queues.reset();
+		s_Data.ThreadsCount = 0;
+		s_ThreadIndex = UINT32_MAX;
+	}
+
+	uint32 JobSystem::GetWorkerThreadsCount()
+	{
+		return (uint32)s_Data.Workers.size();
+	}
+
+	uint32 JobSystem::GetThreadsCount()
+	{
+		return s_Data.ThreadsCount;
+	}
+
+	uint32 JobSystem::GetCurrentThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+	void JobSystem::Schedule(const JobFunc& func, JobCounter* counter)
+	{
+		if (counter)
+			counter->m_Value.fetch_add(1, std::memory_order_acq_rel);
+
+		Submit(new Job{ func, counter, IsBackgroundContext() });
+	}
+
+	void JobSystem::Schedule(const JobFunc& func, JobCounter* counter, JobCounter& dependency)
+	{
+		if (counter)
+			counter->m_Value.fetch_add(1, std::memory_order_acq_rel);
+
+		Job* job = new Job{ func, counter, IsBackgroundContext() };
+
+		{
+			std::lock_guard lock(dependency.m_DependentsMutex);
+			if (!dependency.IsDone())
+			{
+				dependency.m_Dependents.push_back(job);
+				return;
+			}
+		}
+
+		Submit(job);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		ATN_PROFILE_FUNC();
+
+		while (!counter.IsDone())
+		{
+			if (!ExecuteNextJob())
+				std::this_thread::yield();
+		}
+	}
+
+	uint32 JobSystem::GetBatchSize(uint32 count, uint32 minBatchSize)
+	{
+		// ~4 batches per thread
+		uint32 batchSize = count / (GetThreadsCount() * 4);
+		return batchSize > minBatchSize ? batchSize : minBatchSize;
+	}
+}
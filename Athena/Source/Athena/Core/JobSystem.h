@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace Athena
+{
+	using JobFunc = std::function<void()>;
+
+	struct Job;
+
+	// Tracks completion of a group of jobs.
+	// Each scheduled job increments counter, each finished job decrements it.
+	// Jobs that depend on counter are launched when it reaches zero.
+	class ATHENA_API JobCounter
+	{
+	public:
+		JobCounter() = default;
+		~JobCounter();
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		uint32 GetValue() const { return m_Value.load(std::memory_order_acquire); }
+		bool IsDone() const { return GetValue() == 0; }
+
+	private:
+		friend class JobSystem;
+
+	private:
+		std::atomic<uint32> m_Value = 0;
+		std::mutex m_DependentsMutex;
+		std::vector<Job*> m_Dependents;
+	};
+
+	struct JobSystemConfig
+	{
+		// 0 - use (logical processors - 1)
+		uint32 WorkerThreadsCount = 0;
+	};
+
+	// Fixed pool of worker threads with per-thread work-stealing deques.
+	// Main thread owns deque too and executes jobs while waiting.
+	// Jobs scheduled from other threads (e.g. asset loaders), and jobs scheduled by those jobs,
+	// are background jobs: other threads execute only them, main thread never executes them.
+	class ATHENA_API JobSystem
+	{
+	public:
+		static void Init(const JobSystemConfig& config);
+		static void Shutdown();
+
+		static uint32 GetWorkerThreadsCount();
+		// Main thread + workers
+		static uint32 GetThreadsCount();
+		// 0 - main thread, [1, GetThreadsCount()) - worker threads, UINT32_MAX - other threads
+		static uint32 GetCurrentThreadIndex();
+
+		static void Schedule(const JobFunc& func, JobCounter* counter = nullptr);
+		// Job will be launched after 'dependency' reaches zero
+		static void Schedule(const JobFunc& func, JobCounter* counter, JobCounter& dependency);
+
+		// Executes other jobs until counter reaches zero
+		static void Wait(JobCounter& counter);
+
+		// Splits [0, count) into batches of 'batchSize' and calls func(begin, end) for each batch in parallel.
+		// Returns when all batches are finished.
+		template <typename FuncT>
+		static void ParallelFor(uint32 count, uint32 batchSize, FuncT&& func)
+		{
+			if (count == 0)
+				return;
+
+			batchSize = batchSize == 0 ? 1 : batchSize;
+
+			if (count <= batchSize || GetWorkerThreadsCount() == 0)
+			{
+				func(0u, count);
+				return;
+			}
+
+			JobCounter counter;
+			for (uint32 begin = batchSize; begin < count; begin += batchSize)
+			{
+				uint32 end = begin + batchSize < count ? begin + batchSize : count;
+				Schedule([&func, begin, end]() { func(begin, end); }, &counter);
+			}
+
+			// First batch executed on calling thread
+			func(0u, batchSize);
+
+			Wait(counter);
+		}
+
+		// Batch size that gives each thread several batches to balance uneven work
+		static uint32 GetBatchSize(uint32 count, uint32 minBatchSize = 64);
+
+	private:
+		static bool IsBackgroundContext();
+		static void Submit(Job* job);
+		static Job* FetchJob();
+		static bool ExecuteNextJob();
+		static void Execute(Job* job);
+		static void FinishJob(JobCounter* counter);
+		static void WorkerThreadLoop(uint32 index);
+	};
+}
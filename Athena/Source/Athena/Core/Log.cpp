@@ -1,4 +1,5 @@
 #include "Log.h"
+#include "LogQueue.h"
 
 #if defined(_MSC_VER)
 	#pragma warning(push, 0)
@@ -11,6 +12,10 @@
 	#pragma warning(pop)
 #endif
 
+#include <atomic>
+#include <memory>
+#include <thread>
+
 
 #ifdef ATN_PLATFORM_WINDOWS
 #include <Windows.h>
@@ -60,12 +65,135 @@ static void CreateConsole()
 
 namespace Athena
 {
+	struct LogData
+	{
+		LogConfig Config;
+		LogQueue Queue;
+
+		std::thread Worker;
+		std::atomic<bool> Running = false;
+
+		// Worker sleeps on 'WakeSignal' when queue is empty
+		std::atomic<bool> WorkerSleeping = false;
+		std::atomic<uint32> WakeSignal = 0;
+
+		// Number of written messages, used by Flush
+		std::atomic<uint64> ProcessedCount = 0;
+		std::atomic<uint64> DroppedCount = 0;
+	};
+
+	static LogData s_Data;
+
+
+	class LogWorker
+	{
+	public:
+		static void Write(Log::Type type, Log::Level level, const String& message)
+		{
+			auto& logger = type == Log::Type::Core ? Log::s_CoreLogger : Log::s_ClientLogger;
+
+			switch (level)
+			{
+			case Log::Level::Trace:
+				logger->trace(message);
+				break;
+			case Log::Level::Info:
+				logger->info(message);
+				break;
+			case Log::Level::Warn:
+				logger->warn(message);
+				break;
+			case Log::Level::Error:
+				logger->error(message);
+				break;
+			case Log::Level::Fatal:
+				logger->critical(message);
+				break;
+			}
+		}
+
+		static void FlushSinks()
+		{
+			Log::s_CoreLogger->flush();
+			Log::s_ClientLogger->flush();
+		}
+
+		// Returns number of written messages
+		static uint64 Drain()
+		{
+			uint64 count = 0;
+			LogEntry* entry = nullptr;
+
+			while (s_Data.Queue.TryPop(entry))
+			{
+				Write(entry->Type, entry->Level, entry->Message);
+				s_Data.Queue.Release(entry);
+
+				s_Data.ProcessedCount.fetch_add(1, std::memory_order_release);
+				count++;
+			}
+
+			uint64 dropped = s_Data.DroppedCount.exchange(0, std::memory_order_acq_rel);
+			if (dropped > 0)
+				Write(Log::Type::Core, Log::Level::Warn, std::format("[Log] Queue overflow, dropped {} messages", dropped));
+
+			return count;
+		}
+
+		static void ThreadLoop()
+		{
+			ATN_PROFILE_THREAD("Log");
+
+			while (true)
+			{
+				bool running = s_Data.Running.load(std::memory_order_acquire);
+
+				if (Drain() > 0)
+				{
+					// Write to disk in batches instead of every message
+					FlushSinks();
+					continue;
+				}
+
+				if (!running)
+					break;
+
+				uint32 signal = s_Data.WakeSignal.load(std::memory_order_acquire);
+				s_Data.WorkerSleeping.store(true, std::memory_order_seq_cst);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				// Recheck after announcing sleep, producer may have pushed in between
+				LogEntry* entry = nullptr;
+				if (!s_Data.Queue.TryPop(entry) && s_Data.Running.load(std::memory_order_acquire))
+					s_Data.WakeSignal.wait(signal, std::memory_order_acquire);
+
+				s_Data.WorkerSleeping.store(false, std::memory_order_relaxed);
+			}
+
+			FlushSinks();
+		}
+
+		static void Wake()
+		{
+			// Pairs with fence in ThreadLoop, either worker sees new entry or producer sees sleeping worker
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (s_Data.WorkerSleeping.load(std::memory_order_seq_cst))
+			{
+				s_Data.WakeSignal.fetch_add(1, std::memory_order_release);
+				s_Data.WakeSignal.notify_one();
+			}
+		}
+	};
+
+
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
 
 
-	void Log::Init(bool createConsole)
+	void Log::Init(bool createConsole, const LogConfig& config)
 	{
+		s_Data.Config = config;
+
 		if(createConsole)
 			CreateConsole();
 
@@ -89,14 +217,92 @@ namespace Athena
 		loglevel = spdlog::level::info;
 #endif
 
+		// Sinks are flushed by log thread after each batch
 		s_CoreLogger = std::make_shared<spdlog::logger>("ATHENA", begin(logSinks), end(logSinks));
 		spdlog::register_logger(s_CoreLogger);
 		s_CoreLogger->set_level(loglevel);
-		s_CoreLogger->flush_on(loglevel);
 
 		s_ClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
 		spdlog::register_logger(s_ClientLogger);
 		s_ClientLogger->set_level(loglevel);
-		s_ClientLogger->flush_on(loglevel);
+
+		s_Data.Queue.Init(config.QueueCapacity);
+		s_Data.ProcessedCount = 0;
+		s_Data.DroppedCount = 0;
+		s_Data.Running = true;
+		s_Data.Worker = std::thread(LogWorker::ThreadLoop);
+	}
+
+	void Log::Shutdown()
+	{
+		if (!s_Data.Running)
+			return;
+
+		s_Data.Running.store(false, std::memory_order_release);
+		s_Data.WakeSignal.fetch_add(1, std::memory_order_release);
+		s_Data.WakeSignal.notify_one();
+
+		s_Data.Worker.join();
+
+		// Messages pushed while log thread was exiting
+		LogWorker::Drain();
+		LogWorker::FlushSinks();
+	}
+
+	void Log::Flush()
+	{
+		if (!s_Data.Running.load(std::memory_order_acquire))
+			return;
+
+		uint64 target = s_Data.Queue.GetPushedCount();
+
+		LogWorker::Wake();
+		while (s_Data.ProcessedCount.load(std::memory_order_acquire) < target)
+		{
+			// Log thread may exit before reaching target, Shutdown writes the rest
+			if (!s_Data.Running.load(std::memory_order_acquire))
+				return;
+
+			std::this_thread::yield();
+		}
+
+		LogWorker::FlushSinks();
+	}
+
+	void Log::Enqueue(Type type, Level level, String&& message)
+	{
+		// Before Init or after Shutdown write directly
+		if (!s_Data.Running.load(std::memory_order_acquire))
+		{
+			if (s_CoreLogger)
+			{
+				LogWorker::Write(type, level, message);
+				LogWorker::FlushSinks();
+			}
+
+			return;
+		}
+
+		bool important = level == Level::Error || level == Level::Fatal;
+		bool canDrop = !important && s_Data.Config.OverflowPolicy == LogOverflowPolicy::DropVerbose;
+
+		while (!s_Data.Queue.TryPush(type, level, message))
+		{
+			if (canDrop)
+			{
+				s_Data.DroppedCount.fetch_add(1, std::memory_order_relaxed);
+				LogWorker::Wake();
+				return;
+			}
+
+			LogWorker::Wake();
+			std::this_thread::yield();
+		}
+
+		LogWorker::Wake();
+
+		// Errors usually precede asserts and crashes, make sure they reach the file
+		if (important)
+			Flush();
 	}
 }
@@ -17,6 +17,23 @@
 
 namespace Athena
 {
+	enum class LogOverflowPolicy
+	{
+		// Trace, info and warn messages are dropped when queue is full, errors always wait for free slot
+		DropVerbose = 1,
+		// Every message waits for free slot
+		Block
+	};
+
+	struct LogConfig
+	{
+		// Max number of messages waiting for background thread, must be power of 2
+		uint32 QueueCapacity = 8192;
+		LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::DropVerbose;
+	};
+
+	// Messages are formatted on calling thread and pushed to lock-free queue,
+	// background thread writes them to sinks. Errors are flushed before returning.
 	class Log
 	{
 	public:
@@ -31,18 +48,26 @@ namespace Athena
 		};
 
 	public:
-		static void Init(bool createConsole);
+		ATHENA_API static void Init(bool createConsole, const LogConfig& config = LogConfig());
+		ATHENA_API static void Shutdown();
+
+		// Blocks until all queued messages are written
+		ATHENA_API static void Flush();
 
 		template <typename... Args>
 		static void Message(Type type, Level level, std::string_view tag, Args&&... args);
 
 	private:
+		ATHENA_API static void Enqueue(Type type, Level level, String&& message);
+
 		static inline String FormatMessage(const String& msg);
 
 		template <typename... Args>
 		static inline String FormatMessage(const String& msg, Args&&... args);
 
 	private:
+		friend class LogWorker;
+
 		ATHENA_API static std::shared_ptr<spdlog::logger> s_CoreLogger;
 		ATHENA_API static std::shared_ptr<spdlog::logger> s_ClientLogger;
 	};
@@ -51,30 +76,12 @@ namespace Athena
 	template <typename... Args>
 	void Log::Message(Log::Type type, Log::Level level, std::string_view tag, Args&&... args)
 	{
-		auto logger = type == Log::Type::Core ? s_CoreLogger : s_ClientLogger;
 		std::string_view logTemplate = tag.empty() ? "{0}{1}" : "[{0}] {1}";
 
 		String msg = FormatMessage(args...);
-		auto finalMsg = fmt::vformat(logTemplate, fmt::make_format_args(tag, msg));
+		String finalMsg = fmt::vformat(logTemplate, fmt::make_format_args(tag, msg));
 
-		switch (level)
-		{
-		case Log::Level::Trace:
-			logger->trace(finalMsg);
-			break;
-		case Log::Level::Info:
-			logger->info(finalMsg);
-			break;
-		case Log::Level::Warn:
-			logger->warn(finalMsg);
-			break;
-		case Log::Level::Error:
-			logger->error(finalMsg);
-			break;
-		case Log::Level::Fatal:
-			logger->critical(finalMsg);
-			break;
-		}
+		Enqueue(type, level, std::move(finalMsg));
 	}
 
 	inline String Log::FormatMessage(const String& msg)
@@ -120,37 +127,65 @@ namespace fmt
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Messages below ATN_LOG_MIN_LEVEL are compiled out, arguments are not evaluated
+// 1 - Trace, 2 - Info, 3 - Warn, 4 - Error, 5 - Fatal
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ATN_LOG_MIN_LEVEL
+	#ifdef ATN_LOG_LEVEL_DEBUG
+		#define ATN_LOG_MIN_LEVEL 1
+	#else
+		#define ATN_LOG_MIN_LEVEL 3
+	#endif
+#endif
+
+#if ATN_LOG_MIN_LEVEL <= 1
+	#define ATN_INTERNAL_LOG_TRACE(type, tag, ...) ::Athena::Log::Message(type, ::Athena::Log::Level::Trace, tag, __VA_ARGS__)
+#else
+	#define ATN_INTERNAL_LOG_TRACE(type, tag, ...) ((void)0)
+#endif
+
+#if ATN_LOG_MIN_LEVEL <= 2
+	#define ATN_INTERNAL_LOG_INFO(type, tag, ...) ::Athena::Log::Message(type, ::Athena::Log::Level::Info, tag, __VA_ARGS__)
+#else
+	#define ATN_INTERNAL_LOG_INFO(type, tag, ...) ((void)0)
+#endif
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tagged logs (prefer using these)
 // Example with tag: ATN_TRACE_TAG("Editor", "Fatal error") "[Editor] Fatal error"
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Core logging
-#define ATN_CORE_TRACE_TAG(tag, ...)	::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Trace, tag, __VA_ARGS__)
-#define ATN_CORE_INFO_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Info, tag, __VA_ARGS__)
+#define ATN_CORE_TRACE_TAG(tag, ...)	ATN_INTERNAL_LOG_TRACE(::Athena::Log::Type::Core, tag, __VA_ARGS__)
+#define ATN_CORE_INFO_TAG(tag, ...)		ATN_INTERNAL_LOG_INFO(::Athena::Log::Type::Core, tag, __VA_ARGS__)
 #define ATN_CORE_WARN_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Warn, tag, __VA_ARGS__)
 #define ATN_CORE_ERROR_TAG(tag, ...)	::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Error, tag, __VA_ARGS__)
 #define ATN_CORE_FATAL_TAG(tag, ...)	::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Fatal, tag, __VA_ARGS__)
 
 // Client logging
-#define ATN_TRACE_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Trace, tag, __VA_ARGS__)
-#define ATN_INFO_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Info, tag, __VA_ARGS__)
+#define ATN_TRACE_TAG(tag, ...)		ATN_INTERNAL_LOG_TRACE(::Athena::Log::Type::Client, tag, __VA_ARGS__)
+#define ATN_INFO_TAG(tag, ...)		ATN_INTERNAL_LOG_INFO(::Athena::Log::Type::Client, tag, __VA_ARGS__)
 #define ATN_WARN_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Warn, tag, __VA_ARGS__)
 #define ATN_ERROR_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Error, tag, __VA_ARGS__)
 #define ATN_FATAL_TAG(tag, ...)		::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Fatal, tag, __VA_ARGS__)
 
+// Startup and loading timings, written at info level and never compiled out
+#define ATN_CORE_TIMING_TAG(tag, ...)	::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Info, tag, __VA_ARGS__)
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Core logging
-#define ATN_CORE_TRACE(...)		::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Trace, "", __VA_ARGS__)
-#define ATN_CORE_INFO(...)	    ::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Info, "", __VA_ARGS__)
+#define ATN_CORE_TRACE(...)		ATN_INTERNAL_LOG_TRACE(::Athena::Log::Type::Core, "", __VA_ARGS__)
+#define ATN_CORE_INFO(...)	    ATN_INTERNAL_LOG_INFO(::Athena::Log::Type::Core, "", __VA_ARGS__)
 #define ATN_CORE_WARN(...)      ::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Warn, "", __VA_ARGS__)
 #define ATN_CORE_ERROR(...)     ::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Error, "", __VA_ARGS__)
 #define ATN_CORE_FATAL(...)     ::Athena::Log::Message(::Athena::Log::Type::Core, ::Athena::Log::Level::Fatal, "", __VA_ARGS__)
 
 // Client logging
-#define ATN_TRACE(...)		  ::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Trace, "", __VA_ARGS__)
-#define ATN_INFO(...)	      ::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Info, "", __VA_ARGS__)
+#define ATN_TRACE(...)		  ATN_INTERNAL_LOG_TRACE(::Athena::Log::Type::Client, "", __VA_ARGS__)
+#define ATN_INFO(...)	      ATN_INTERNAL_LOG_INFO(::Athena::Log::Type::Client, "", __VA_ARGS__)
 #define ATN_WARN(...)         ::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Warn, "", __VA_ARGS__)
 #define ATN_ERROR(...)        ::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Error, "", __VA_ARGS__)
 #define ATN_FATAL(...)        ::Athena::Log::Message(::Athena::Log::Type::Client, ::Athena::Log::Level::Fatal, "", __VA_ARGS__)
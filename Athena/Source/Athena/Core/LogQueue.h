@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+#include "Athena/Core/Log.h"
+
+#include <atomic>
+#include <memory>
+
+
+namespace Athena
+{
+	struct LogEntry
+	{
+		std::atomic<uint64> Sequence;
+		Log::Type Type;
+		Log::Level Level;
+		String Message;
+	};
+
+	// Bounded lock-free queue, many producers and single consumer.
+	// Each slot has sequence number, producers claim slots with CAS on tail.
+	class LogQueue
+	{
+	public:
+		void Init(uint32 capacity)
+		{
+			ATN_CORE_VERIFY((capacity & (capacity - 1)) == 0, "Log queue capacity must be power of 2");
+
+			m_Capacity = capacity;
+			m_Entries = std::make_unique<LogEntry[]>(capacity);
+
+			for (uint64 i = 0; i < capacity; ++i)
+				m_Entries[i].Sequence.store(i, std::memory_order_relaxed);
+
+			m_Head = 0;
+			m_Tail.store(0, std::memory_order_relaxed);
+		}
+
+		bool TryPush(Log::Type type, Log::Level level, String& message)
+		{
+			uint64 tail = m_Tail.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				LogEntry& entry = m_Entries[tail & (m_Capacity - 1)];
+				uint64 sequence = entry.Sequence.load(std::memory_order_acquire);
+				int64 diff = (int64)sequence - (int64)tail;
+
+				if (diff == 0)
+				{
+					if (m_Tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+					{
+						entry.Type = type;
+						entry.Level = level;
+						entry.Message = std::move(message);
+						entry.Sequence.store(tail + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					// Queue is full
+					return false;
+				}
+				else
+				{
+					tail = m_Tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool TryPop(LogEntry*& result)
+		{
+			LogEntry& entry = m_Entries[m_Head & (m_Capacity - 1)];
+			uint64 sequence = entry.Sequence.load(std::memory_order_acquire);
+
+			if (sequence != m_Head + 1)
+				return false;
+
+			result = &entry;
+			return true;
+		}
+
+		// Must be called after entry returned from TryPop is processed
+		void Release(LogEntry* entry)
+		{
+			entry->Message.clear();
+			entry->Sequence.store(m_Head + m_Capacity, std::memory_order_release);
+			m_Head++;
+		}
+
+		uint64 GetPushedCount() const { return m_Tail.load(std::memory_order_acquire); }
+
+	private:
+		std::unique_ptr<LogEntry[]> m_Entries;
+		uint64 m_Capacity = 0;
+		alignas(64) std::atomic<uint64> m_Tail = 0;
+		alignas(64) uint64 m_Head = 0;
+	};
+}
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 
 namespace Athena
 {
-	// Base class for reference counting objects
+	// Base class for reference counting objects.
+	// Counter is atomic, so references can be copied from worker threads
 	class RefCounted
 	{
 	public:
@@ -15,20 +17,46 @@ namespace Athena
 
 		}
 
+		// Copy is a new object, references are not copied
+		RefCounted(const RefCounted&)
+			: m_Count(0)
+		{
+
+		}
+
+		RefCounted& operator=(const RefCounted&)
+		{
+			return *this;
+		}
+
 		int32_t GetCount() const
 		{
-			return m_Count;
+			return m_Count.load(std::memory_order_relaxed);
 		}
 
 	private:
 		void Increment() const
 		{
-			m_Count++;
+			m_Count.fetch_add(1, std::memory_order_relaxed);
 		}
 
-		void Decrement() const
+		// Returns new value of counter
+		int32_t Decrement() const
 		{
-			m_Count--;
+			return m_Count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		}
+
+		// Fails if object is already being destroyed
+		bool TryIncrement() const
+		{
+			int32_t count = m_Count.load(std::memory_order_relaxed);
+			while (count > 0)
+			{
+				if (m_Count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+					return true;
+			}
+
+			return false;
 		}
 
 	private:
@@ -36,7 +64,7 @@ namespace Athena
 		friend class Ref;
 
 	private:
-		mutable int32_t m_Count;
+		mutable std::atomic<int32_t> m_Count;
 	};
 
 
@@ -62,6 +90,17 @@ namespace Athena
 
 		}
 
+		// Used to implement weak references: returns null if last reference is already released.
+		// Caller must guarantee that memory of object is not freed during this call.
+		static Ref TryAcquire(T* ptr)
+		{
+			Ref result;
+			if (ptr && static_cast<const RefCounted*>(ptr)->TryIncrement())
+				result.m_Object = ptr;
+
+			return result;
+		}
+
 		explicit Ref(T* ptr)
 		{
 			Acquire(ptr);
@@ -162,9 +201,7 @@ namespace Athena
 			if (m_Object)
 			{
 				RefCounted* objectBase = m_Object;
-				objectBase->Decrement();
-
-				if (objectBase->GetCount() == 0)
+				if (objectBase->Decrement() == 0)
 				{
 					delete m_Object;
 				}
@@ -272,6 +309,7 @@ namespace Athena
 			if (m_Object == other.m_Object)
 				return *this;
 
+			Release();
 			m_Object = static_cast<T*>(other.m_Object);
 			other.m_Object = nullptr;
 
@@ -23,6 +23,13 @@ namespace Athena
 		vmaUnmapMemory(VulkanContext::GetAllocator()->GetInternalAllocator(), m_Allocation);
 	}
 
+	void* VulkanBufferAllocation::GetMappedData() const
+	{
+		VmaAllocationInfo info;
+		vmaGetAllocationInfo(VulkanContext::GetAllocator()->GetInternalAllocator(), m_Allocation, &info);
+		return info.pMappedData;
+	}
+
 	VulkanAllocator::VulkanAllocator(uint32 vulkanVersion)
 	{
 		VmaVulkanFunctions vulkanFunctions = {};
@@ -176,6 +183,21 @@ namespace Athena
 		return result;
 	}
 
+	uint64 VulkanAllocator::GetMemoryBudget()
+	{
+		VmaBudget heaps[VK_MAX_MEMORY_HEAPS] = { 0 };
+		vmaGetHeapBudgets(m_Allocator, heaps);
+
+		uint64 result = 0;
+		for (uint32 i = 0; i < m_MemoryProps.memoryHeapCount; i++)
+		{
+			if (m_MemoryProps.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+				result += heaps[i].budget;
+		}
+
+		return result;
+	}
+
 
 	DescriptorSetAllocator::DescriptorSetAllocator()
 	{
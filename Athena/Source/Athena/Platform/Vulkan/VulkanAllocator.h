@@ -23,6 +23,8 @@ namespace Athena
 
 		void* MapMemory();
 		void UnmapMemory();
+		// Only for allocations created with VMA_ALLOCATION_CREATE_MAPPED_BIT
+		void* GetMappedData() const;
 
 		operator bool() const { return !(m_Buffer == VK_NULL_HANDLE && m_Allocation == VK_NULL_HANDLE); }
 
@@ -59,6 +61,11 @@ namespace Athena
 
 	class VulkanAllocator : public RefCounted
 	{
+	public:
+		// Host writeable memory that stays mapped for the whole lifetime of allocation
+		static constexpr VmaAllocationCreateFlagBits PersistentMappingFlags =
+			VmaAllocationCreateFlagBits(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+
 	public:
 		VulkanAllocator(uint32 vulkanVersion);
 		~VulkanAllocator();
@@ -78,6 +85,8 @@ namespace Athena
 
 		// return in Kb
 		uint64 GetMemoryUsage();
+		// Device local memory that process can use, reported by driver through memory budget extension
+		uint64 GetMemoryBudget();
 
 	private:
 		VmaAllocator m_Allocator;
@@ -112,7 +112,7 @@ namespace Athena
 		pipelineInfo.stage = vkShader->GetPipelineStages()[0];
 		pipelineInfo.layout = m_PipelineLayout;
 
-		VK_CHECK(vkCreateComputePipelines(VulkanContext::GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_VulkanPipeline));
+		VK_CHECK(vkCreateComputePipelines(VulkanContext::GetLogicalDevice(), VulkanContext::GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_VulkanPipeline));
 		Vulkan::SetObjectDebugName(m_VulkanPipeline, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT, m_Name);
 	}
 }
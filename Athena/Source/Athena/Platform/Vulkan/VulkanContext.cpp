@@ -1,7 +1,10 @@
 #include "VulkanContext.h"
 
 #include "Athena/Core/Application.h"
+#include "Athena/Core/FileSystem.h"
+#include "Athena/Core/JobSystem.h"
 #include "Athena/Platform/Vulkan/VulkanUtils.h"
+#include "Athena/Utils/StringUtils.h"
 
 
 namespace Athena
@@ -150,6 +153,30 @@ namespace Athena
 
 			return missingLayers.empty();
 		}
+
+		static FilePath GetPipelineCachePath()
+		{
+			return Application::Get().GetConfig().EngineResourcesPath / "Cache/VulkanPipelineCache.bin";
+		}
+
+		// Cache created by another device or driver version must be discarded
+		static bool IsPipelineCacheCompatible(const Buffer& data)
+		{
+			if (data.Size() < sizeof(VkPipelineCacheHeaderVersionOne))
+				return false;
+
+			VkPipelineCacheHeaderVersionOne header;
+			memcpy(&header, data.Data(), sizeof(header));
+
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(VulkanContext::GetPhysicalDevice(), &properties);
+
+			return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+				header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+				header.vendorID == properties.vendorID &&
+				header.deviceID == properties.deviceID &&
+				memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+		}
 	}
 
 
@@ -243,6 +270,11 @@ namespace Athena
 			s_Data.DescriptorSetAllocator = Ref<DescriptorSetAllocator>::Create();
 		}
 
+		// Create Uploader
+		{
+			s_Data.Uploader = Ref<VulkanUploader>::Create();
+		}
+
 		// Create synchronization primitives
 		{
 			s_Data.FrameSyncData.resize(Renderer::GetFramesInFlight());
@@ -270,12 +302,45 @@ namespace Athena
 			commandPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 			VK_CHECK(vkCreateCommandPool(VulkanContext::GetLogicalDevice(), &commandPoolCI, nullptr, &s_Data.CommandPool));
 		}
+
+		CreatePipelineCache();
+
+		// Create per thread command pools
+		{
+			VkCommandPoolCreateInfo commandPoolCI = {};
+			commandPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			commandPoolCI.queueFamilyIndex = VulkanContext::GetDevice()->GetQueueFamily();
+			commandPoolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+			s_Data.ThreadCommandPools.resize(Renderer::GetFramesInFlight());
+
+			for (auto& framePools : s_Data.ThreadCommandPools)
+			{
+				framePools.resize(JobSystem::GetThreadsCount());
+
+				for (auto& threadPool : framePools)
+					VK_CHECK(vkCreateCommandPool(VulkanContext::GetLogicalDevice(), &commandPoolCI, nullptr, &threadPool.CommandPool));
+			}
+		}
 	}
 
 	void VulkanContext::Shutdown()
 	{
+		s_Data.Uploader.Release();
+
+		SavePipelineCache();
+		vkDestroyPipelineCache(VulkanContext::GetLogicalDevice(), s_Data.PipelineCache, nullptr);
+
 		vkDestroyCommandPool(VulkanContext::GetLogicalDevice(), s_Data.CommandPool, nullptr);
 
+		for (const auto& framePools : s_Data.ThreadCommandPools)
+		{
+			for (const auto& threadPool : framePools)
+				vkDestroyCommandPool(VulkanContext::GetLogicalDevice(), threadPool.CommandPool, nullptr);
+		}
+
+		s_Data.ThreadCommandPools.clear();
+
 		for (uint32_t i = 0; i < Renderer::GetFramesInFlight(); i++)
 		{
 			vkDestroySemaphore(VulkanContext::GetLogicalDevice(), s_Data.FrameSyncData[i].ImageAcquiredSemaphore, nullptr);
@@ -295,4 +360,98 @@ namespace Athena
 		
 		vkDestroyInstance(VulkanContext::GetInstance(), nullptr);
 	}
+
+	VkCommandBuffer VulkanContext::AllocateSecondaryCommandBuffer()
+	{
+		uint32 threadIndex = JobSystem::GetCurrentThreadIndex();
+		ATN_CORE_ASSERT(threadIndex < JobSystem::GetThreadsCount(), "Secondary command buffers can be recorded only from job system threads");
+
+		ThreadCommandPool& threadPool = s_Data.ThreadCommandPools[Renderer::GetCurrentFrameIndex()][threadIndex];
+
+		if (threadPool.UsedCount == threadPool.SecondaryCommandBuffers.size())
+		{
+			VkCommandBufferAllocateInfo cmdBufAllocInfo = {};
+			cmdBufAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cmdBufAllocInfo.commandPool = threadPool.CommandPool;
+			cmdBufAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			cmdBufAllocInfo.commandBufferCount = 1;
+
+			VkCommandBuffer commandBuffer;
+			VK_CHECK(vkAllocateCommandBuffers(VulkanContext::GetLogicalDevice(), &cmdBufAllocInfo, &commandBuffer));
+			threadPool.SecondaryCommandBuffers.push_back(commandBuffer);
+		}
+
+		return threadPool.SecondaryCommandBuffers[threadPool.UsedCount++];
+	}
+
+	void VulkanContext::ResetThreadCommandPools(uint32 frameIndex)
+	{
+		for (auto& threadPool : s_Data.ThreadCommandPools[frameIndex])
+		{
+			if (threadPool.UsedCount == 0)
+				continue;
+
+			VK_CHECK(vkResetCommandPool(VulkanContext::GetLogicalDevice(), threadPool.CommandPool, 0));
+			threadPool.UsedCount = 0;
+		}
+	}
+
+	void VulkanContext::CreatePipelineCache()
+	{
+		Timer timer;
+
+		FilePath path = Utils::GetPipelineCachePath();
+		Buffer cacheData;
+
+		if (FileSystem::Exists(path))
+		{
+			cacheData = FileSystem::ReadFileBinary(path);
+
+			if (!Utils::IsPipelineCacheCompatible(cacheData))
+			{
+				ATN_CORE_WARN_TAG("Vulkan", "Pipeline cache '{}' was created by another device or driver, discarding", path);
+				cacheData.Release();
+			}
+		}
+
+		VkPipelineCacheCreateInfo pipelineCacheCI = {};
+		pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		pipelineCacheCI.initialDataSize = cacheData.Size();
+		pipelineCacheCI.pInitialData = cacheData.Data();
+
+		VkResult result = vkCreatePipelineCache(VulkanContext::GetLogicalDevice(), &pipelineCacheCI, nullptr, &s_Data.PipelineCache);
+
+		// Driver can still reject data that passed header validation
+		if (result != VK_SUCCESS && cacheData.Size() != 0)
+		{
+			ATN_CORE_WARN_TAG("Vulkan", "Failed to create pipeline cache from '{}', creating empty cache", path);
+
+			pipelineCacheCI.initialDataSize = 0;
+			pipelineCacheCI.pInitialData = nullptr;
+			result = vkCreatePipelineCache(VulkanContext::GetLogicalDevice(), &pipelineCacheCI, nullptr, &s_Data.PipelineCache);
+		}
+
+		VK_CHECK(result);
+
+		ATN_CORE_TIMING_TAG("Vulkan", "Loaded pipeline cache ({}) in {}", Utils::MemoryBytesToString(cacheData.Size()), timer.ElapsedTime());
+		cacheData.Release();
+	}
+
+	void VulkanContext::SavePipelineCache()
+	{
+		size_t size = 0;
+		VK_CHECK(vkGetPipelineCacheData(VulkanContext::GetLogicalDevice(), s_Data.PipelineCache, &size, nullptr));
+
+		if (size == 0)
+			return;
+
+		Buffer cacheData(size);
+		VK_CHECK(vkGetPipelineCacheData(VulkanContext::GetLogicalDevice(), s_Data.PipelineCache, &size, cacheData.Data()));
+
+		FilePath path = Utils::GetPipelineCachePath();
+		if (FileSystem::WriteFile(path, (const char*)cacheData.Data(), size))
+			ATN_CORE_INFO_TAG("Vulkan", "Saved pipeline cache ({}) to '{}'", Utils::MemoryBytesToString(size), path);
+
+		cacheData.Release();
+	}
 }
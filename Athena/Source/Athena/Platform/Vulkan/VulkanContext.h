@@ -4,6 +4,7 @@
 
 #include "Athena/Platform/Vulkan/VulkanDevice.h"
 #include "Athena/Platform/Vulkan/VulkanAllocator.h"
+#include "Athena/Platform/Vulkan/VulkanUploader.h"
 
 #include <vulkan/vulkan.h>
 
@@ -28,6 +29,15 @@ namespace Athena
 		VkFence RenderCompleteFence;
 	};
 
+	// Command pool owned by one thread for one frame in flight.
+	// Secondary command buffers are reused after pool reset.
+	struct ThreadCommandPool
+	{
+		VkCommandPool CommandPool;
+		std::vector<VkCommandBuffer> SecondaryCommandBuffers;
+		uint32 UsedCount = 0;
+	};
+
 	struct VulkanContextData
 	{
 		VkInstance Instance;
@@ -35,8 +45,12 @@ namespace Athena
 		Ref<VulkanAllocator> Allocator;
 		Ref<DescriptorSetAllocator> DescriptorSetAllocator;
 		Ref<VulkanDevice> Device;
+		Ref<VulkanUploader> Uploader;
 		std::vector<FrameSyncData> FrameSyncData;
 		VkCommandPool CommandPool;
+		// [frame][thread]
+		std::vector<std::vector<ThreadCommandPool>> ThreadCommandPools;
+		VkPipelineCache PipelineCache;
 	};
 
 
@@ -49,7 +63,9 @@ namespace Athena
 		static VkInstance GetInstance() { return s_Data.Instance; }
 		static Ref<VulkanAllocator> GetAllocator() { return s_Data.Allocator; }
 		static VkCommandPool GetCommandPool() { return s_Data.CommandPool; }
+		static VkPipelineCache GetPipelineCache() { return s_Data.PipelineCache; }
 		static Ref<DescriptorSetAllocator> GetDescriptorSetAllocator() { return s_Data.DescriptorSetAllocator; }
+		static Ref<VulkanUploader> GetUploader() { return s_Data.Uploader; }
 
 		static Ref<VulkanDevice> GetDevice() { return s_Data.Device; }
 		static VkDevice GetLogicalDevice() { return s_Data.Device->GetLogicalDevice(); }
@@ -57,6 +73,15 @@ namespace Athena
 
 		static const FrameSyncData& GetFrameSyncData(uint32 frameIndex) { return s_Data.FrameSyncData[frameIndex]; }
 
+		// Allocates from pool of current job system thread and current frame, valid until frame is reused
+		static VkCommandBuffer AllocateSecondaryCommandBuffer();
+		// Must be called after frame fence is signaled
+		static void ResetThreadCommandPools(uint32 frameIndex);
+
+	private:
+		static void CreatePipelineCache();
+		static void SavePipelineCache();
+
 	private:
 		static VulkanContextData s_Data;
 	};
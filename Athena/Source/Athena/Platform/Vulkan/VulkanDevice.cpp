@@ -51,6 +51,7 @@ namespace Athena
 			String message = "Queue Families: \n\t";
 
 			m_QueueFamily = UINT32_MAX;
+			m_TransferQueueFamily = UINT32_MAX;
 			VkQueueFlagBits requestedQueueFlags = VkQueueFlagBits(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT);
 			for (uint32 i = 0; i < count; i++)
 			{
@@ -61,6 +62,11 @@ namespace Athena
 				if (supported && (m_QueueFamily == UINT32_MAX))
 					m_QueueFamily = i;
 
+				// Transfer only family is usually backed by DMA engine and runs in parallel with graphics work
+				bool transferOnly = (queues[i].queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queues[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+				if (transferOnly && (m_TransferQueueFamily == UINT32_MAX))
+					m_TransferQueueFamily = i;
+
 				String flags;
 
 				flags += queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT ? "Graphics, " : "";
@@ -73,6 +79,12 @@ namespace Athena
 
 			ATN_CORE_INFO_TAG("Vulkan", message);
 			ATN_CORE_VERIFY(m_QueueFamily != UINT32_MAX, "Failed to find queue family that supports VK_QUEUE_GRAPHICS_BIT, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_TRANSFER_BIT operations and timestamps");
+
+			if (m_TransferQueueFamily == UINT32_MAX)
+			{
+				ATN_CORE_WARN_TAG("Vulkan", "Failed to find dedicated transfer queue family, uploads will use graphics queue");
+				m_TransferQueueFamily = m_QueueFamily;
+			}
 		};
 
 		// Create Logical Device
@@ -81,13 +93,22 @@ namespace Athena
 
 			const float queuePriority[] = { 1.0f };
 
-			VkDeviceQueueCreateInfo queueCIs[1] = {};
+			VkDeviceQueueCreateInfo queueCIs[2] = {};
 			queueCIs[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
 			queueCIs[0].queueFamilyIndex = m_QueueFamily;
 			queueCIs[0].queueCount = 1;
 			queueCIs[0].pQueuePriorities = queuePriority;
 
-			message += std::format("QueueFamily - {}, count - {}\n\t", m_QueueFamily, 1);
+			queueCIs[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueCIs[1].queueFamilyIndex = m_TransferQueueFamily;
+			queueCIs[1].queueCount = 1;
+			queueCIs[1].pQueuePriorities = queuePriority;
+
+			uint32 queueCICount = HasDedicatedTransferQueue() ? 2 : 1;
+
+			for (uint32 i = 0; i < queueCICount; ++i)
+				message += std::format("QueueFamily - {}, count - {}\n\t", queueCIs[i].queueFamilyIndex, 1);
+
 			ATN_CORE_INFO_TAG("Vulkan", message);
 
 			std::vector<const char*> deviceExtensions = { 
@@ -100,22 +121,41 @@ namespace Athena
 
 			CheckEnabledExtensions(deviceExtensions);
 
+			VkPhysicalDeviceVulkan12Features supportedVulkan12Features = {};
+			supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+			VkPhysicalDeviceFeatures2 supportedFeatures2 = {};
+			supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			supportedFeatures2.pNext = &supportedVulkan12Features;
+			vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supportedFeatures2);
+
+			const VkPhysicalDeviceFeatures& supportedFeatures = supportedFeatures2.features;
+
+			VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+			vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			vulkan12Features.pNext = nullptr;
 			// GPU profiling
-			VkPhysicalDeviceHostQueryResetFeatures resetFeatures = {};
-			resetFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
-			resetFeatures.pNext = nullptr;
-			resetFeatures.hostQueryReset = VK_TRUE;
+			vulkan12Features.hostQueryReset = VK_TRUE;
+			// Optional, gl_Layer from vertex shader (cascaded shadow maps), geometry shader is used otherwise
+			vulkan12Features.shaderOutputLayer = supportedVulkan12Features.shaderOutputLayer;
+			// Upload batches completion tracking
+			vulkan12Features.timelineSemaphore = VK_TRUE;
 
 			VkPhysicalDeviceFeatures deviceFeatures = {};
 			deviceFeatures.geometryShader = VK_TRUE;
 			deviceFeatures.wideLines = VK_TRUE;
 			deviceFeatures.pipelineStatisticsQuery = VK_TRUE;
+			// Optional, pipeline statistics query stays active while executing secondary command buffers
+			deviceFeatures.inheritedQueries = supportedFeatures.inheritedQueries;
 			deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+			// Optional, imported textures are not compressed if not supported
+			deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
 			VkDeviceCreateInfo deviceCI = {};
-			deviceCI.pNext = &resetFeatures;
+			deviceCI.pNext = &vulkan12Features;
 			deviceCI.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-			deviceCI.queueCreateInfoCount = std::size(queueCIs);
+			deviceCI.queueCreateInfoCount = queueCICount;
 			deviceCI.pQueueCreateInfos = queueCIs;
 			deviceCI.enabledExtensionCount = deviceExtensions.size();
 			deviceCI.ppEnabledExtensionNames = deviceExtensions.data();
@@ -123,6 +163,7 @@ namespace Athena
 
 			VK_CHECK(vkCreateDevice(m_PhysicalDevice, &deviceCI, nullptr, &m_LogicalDevice));
 			vkGetDeviceQueue(m_LogicalDevice, m_QueueFamily, 0, &m_Queue);
+			vkGetDeviceQueue(m_LogicalDevice, m_TransferQueueFamily, 0, &m_TransferQueue);
 		};
 	}
 
@@ -192,6 +233,18 @@ namespace Athena
 
 		deviceCaps.TimestampComputeAndGraphics = limits.timestampComputeAndGraphics;
 		deviceCaps.TimestampPeriod = limits.timestampPeriod;
+
+		VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+		vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+		VkPhysicalDeviceFeatures2 features2 = {};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features2.pNext = &vulkan12Features;
+		vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &features2);
+
+		deviceCaps.TextureCompressionBC = features2.features.textureCompressionBC;
+		deviceCaps.ShaderOutputLayer = vulkan12Features.shaderOutputLayer;
+		deviceCaps.InheritedQueries = features2.features.inheritedQueries;
 	}
 
 	bool VulkanDevice::CheckEnabledExtensions(const std::vector<const char*>& requiredExtensions)
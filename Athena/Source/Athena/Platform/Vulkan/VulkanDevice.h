@@ -19,6 +19,11 @@ namespace Athena
 		uint32 GetQueueFamily() { return m_QueueFamily; }
 		VkQueue GetQueue() { return m_Queue; }
 
+		// Falls back to graphics queue if device has no transfer only queue family
+		uint32 GetTransferQueueFamily() { return m_TransferQueueFamily; }
+		VkQueue GetTransferQueue() { return m_TransferQueue; }
+		bool HasDedicatedTransferQueue() { return m_TransferQueueFamily != m_QueueFamily; }
+
 		void GetDeviceCapabilities(RenderCapabilities& deviceCaps) const;
 
 	private:
@@ -29,5 +34,7 @@ namespace Athena
 		VkDevice m_LogicalDevice;
 		uint32 m_QueueFamily;
 		VkQueue m_Queue;
+		uint32 m_TransferQueueFamily;
+		VkQueue m_TransferQueue;
 	};
 }
@@ -59,7 +59,7 @@ namespace Athena
 		m_Info.Width = width;
 		m_Info.Height = height;
 
-		if (m_Info.GenerateMipMap)
+		if (m_Info.GenerateMipMap || m_Info.PrecomputedMips)
 			m_MipLevels = Math::Floor(Math::Log2(Math::Max<float>(m_Info.Width, m_Info.Height))) + 1;
 		else
 			m_MipLevels = 1;
@@ -155,124 +155,62 @@ namespace Athena
 
 	void VulkanImage::UploadData(Buffer data, uint32 width, uint32 height)
 	{
-		ATN_CORE_ASSERT(data.Size() >= m_Info.Width * m_Info.Height * Texture::BytesPerPixel(m_Info.Format), "Buffer is too small");
-
-		VkDeviceSize imageSize = width * height * (uint64)Texture::BytesPerPixel(m_Info.Format);
-
-		VkBufferCreateInfo bufferInfo = {};
-		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bufferInfo.size = m_Info.Layers * imageSize;
-		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-		VulkanBufferAllocation stagingBuffer = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+		UploadMips(data.Data(), data.Size(), 0, m_Info.PrecomputedMips ? m_MipLevels : 1);
+	}
 
-		void* mappedMemory = stagingBuffer.MapMemory();
+	void VulkanImage::UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount)
+	{
+		ATN_CORE_ASSERT(baseMip + mipCount <= m_MipLevels);
+
+		VulkanImageUploadInfo uploadInfo;
+		uploadInfo.Image = m_Image.GetImage();
+		uploadInfo.Format = m_Info.Format;
+		uploadInfo.Width = m_Info.Width;
+		uploadInfo.Height = m_Info.Height;
+		uploadInfo.Layers = m_Info.Layers;
+		uploadInfo.MipLevels = m_MipLevels;
+		uploadInfo.BaseMipLevel = baseMip;
+		uploadInfo.DataMipLevels = mipCount;
+		uploadInfo.GenerateMipMap = m_Info.GenerateMipMap;
+
+		// Image is ready for sampling after upload batch is submitted
+		VulkanContext::GetUploader()->UploadImage(uploadInfo, data, size);
 
-		for(uint32 offset = 0; offset < m_Info.Layers * imageSize; offset += imageSize)
-			memcpy((byte*)mappedMemory + offset, data.Data(), imageSize);
+		m_Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	}
 
-		stagingBuffer.UnmapMemory();
+	void VulkanImage::WriteContentToBuffer(Buffer* buffer, uint32 baseMip, uint32 mipCount)
+	{
+		ATN_CORE_ASSERT(baseMip + mipCount <= m_MipLevels);
 
-		VkImageMemoryBarrier barrier = {};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.image = m_Image.GetImage();
-		barrier.subresourceRange.aspectMask = Vulkan::GetImageAspectMask(m_Info.Format);
-		barrier.subresourceRange.baseMipLevel = 0;
-		barrier.subresourceRange.levelCount = 1;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = m_Info.Layers;
+		VkImageAspectFlags aspectMask = Vulkan::GetImageAspectMask(m_Info.Format);
 
-		VkPipelineStageFlags sourceStage;
-		VkPipelineStageFlags destinationStage;
+		// Mip levels are written one after another, each level contains all layers, same as in UploadMips
+		std::vector<VkBufferImageCopy> regions(mipCount);
+		uint64 size = 0;
 
-		VkCommandBuffer commandBuffer = Vulkan::BeginSingleTimeCommands();
+		for (uint32 i = 0; i < mipCount; ++i)
 		{
-			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_NONE;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-			sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-			destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-			vkCmdPipelineBarrier(
-				commandBuffer,
-				sourceStage, destinationStage,
-				0,
-				0, nullptr,
-				0, nullptr,
-				1, &barrier
-			);
-
-			VkBufferImageCopy region = {};
-			region.bufferOffset = 0;
-			region.bufferRowLength = 0;
-			region.bufferImageHeight = 0;
-
-			region.imageSubresource.aspectMask = Vulkan::GetImageAspectMask(m_Info.Format);
-			region.imageSubresource.mipLevel = 0;
-			region.imageSubresource.baseArrayLayer = 0;
-			region.imageSubresource.layerCount = m_Info.Layers;
-
-			region.imageOffset = { 0, 0, 0 };
-			region.imageExtent = { width, height, 1 };
-
-			vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.GetBuffer(), m_Image.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-			if (m_Info.GenerateMipMap)
-			{
-				sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-				destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-				vkCmdPipelineBarrier(
-					commandBuffer,
-					sourceStage, destinationStage,
-					0,
-					0, nullptr,
-					0, nullptr,
-					0, nullptr
-				);
-
-				Vulkan::BlitMipMap(commandBuffer, m_Image.GetImage(), m_Info.Width, m_Info.Height, m_Info.Layers, m_Info.Format, GetMipLevelsCount());
-			}
-			else
-			{
-				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-				sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-				destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-
-				vkCmdPipelineBarrier(
-					commandBuffer,
-					sourceStage, destinationStage,
-					0,
-					0, nullptr,
-					0, nullptr,
-					1, &barrier
-				);
-			}
-
+			uint32 mip = baseMip + i;
+			uint32 width = std::max(m_Info.Width >> mip, 1u);
+			uint32 height = std::max(m_Info.Height >> mip, 1u);
+
+			VkBufferImageCopy& copy = regions[i];
+			copy = {};
+			copy.bufferOffset = size;
+			copy.bufferRowLength = 0;
+			copy.bufferImageHeight = 0;
+			copy.imageSubresource.aspectMask = aspectMask;
+			copy.imageSubresource.mipLevel = mip;
+			copy.imageSubresource.baseArrayLayer = 0;
+			copy.imageSubresource.layerCount = m_Info.Layers;
+			copy.imageOffset = { 0, 0, 0 };
+			copy.imageExtent = { width, height, 1 };
+
+			size += Texture::GetImageSize(m_Info.Format, width, height) * m_Info.Layers;
 		}
-		Vulkan::EndSingleTimeCommands(commandBuffer);
-		VulkanContext::GetAllocator()->DestroyBuffer(stagingBuffer);
-
-		m_Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	}
-
-	void VulkanImage::WriteContentToBuffer(Buffer* buffer)
-	{
-		ATN_CORE_ASSERT(m_Type != TextureType::TEXTURE_CUBE, "Not implemented!");
 
 		VkCommandBuffer commandBuffer = Vulkan::BeginSingleTimeCommands();
-		uint32 width = m_Info.Width;
-		uint32 height = m_Info.Height;
-		uint32 size = m_Info.Width * m_Info.Height * Texture::BytesPerPixel(m_Info.Format);
-
 		VkImage srcImage = GetVulkanImage();
 
 		VkBufferCreateInfo bufferInfo = {};
@@ -283,23 +221,27 @@ namespace Athena
 		VulkanBufferAllocation bufAlloc = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT);
 		VkBuffer dstBuffer = bufAlloc.GetBuffer();
 
+		// Image is returned to its current layout after copy
+		VkImageLayout layout = m_Layout == VK_IMAGE_LAYOUT_UNDEFINED ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : m_Layout;
+
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 		barrier.image = srcImage;
-		barrier.subresourceRange.aspectMask = Vulkan::GetImageAspectMask(m_Info.Format);
-		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.aspectMask = aspectMask;
+		barrier.subresourceRange.baseMipLevel = baseMip;
+		barrier.subresourceRange.levelCount = mipCount;
 		barrier.subresourceRange.baseArrayLayer = 0;
 		barrier.subresourceRange.layerCount = m_Info.Layers;
 
 		{
 			barrier.oldLayout = m_Layout;
 			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_NONE;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
-			VkPipelineStageFlags sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			VkPipelineStageFlags sourceStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 			VkPipelineStageFlags destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
 
 			vkCmdPipelineBarrier(
@@ -312,26 +254,15 @@ namespace Athena
 			);
 		}
 
-		VkBufferImageCopy copy = {};
-		copy.bufferOffset = 0;
-		copy.bufferRowLength = width;
-		copy.bufferImageHeight = height;
-		copy.imageSubresource.aspectMask = Vulkan::GetImageAspectMask(m_Info.Format);
-		copy.imageSubresource.mipLevel = 0;
-		copy.imageSubresource.baseArrayLayer = 0;
-		copy.imageSubresource.layerCount = 1;
-		copy.imageOffset = { 0, 0, 0 };
-		copy.imageExtent = { width, height, 1 };
-
 		vkCmdCopyImageToBuffer(commandBuffer, 
 			srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 
 			dstBuffer, 
-			1, &copy);
+			regions.size(), regions.data());
 
 		{
-			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			barrier.newLayout = layout;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 			barrier.dstAccessMask = VK_ACCESS_NONE;
 
 			VkPipelineStageFlags sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -349,6 +280,8 @@ namespace Athena
 
 		Vulkan::EndSingleTimeCommands(commandBuffer);
 
+		m_Layout = layout;
+
 		buffer->Allocate(size);
 
 		void* memory = bufAlloc.MapMemory();
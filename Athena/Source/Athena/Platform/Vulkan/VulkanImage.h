@@ -17,7 +17,9 @@ namespace Athena
 
 		void Resize(uint32 width, uint32 height);
 
-		void WriteContentToBuffer(Buffer* dstBuffer);
+		// Data contains mip levels [baseMip, baseMip + mipCount) one after another, each level contains all layers
+		void WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip = 0, uint32 mipCount = 1);
+		void UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount);
 
 		uint32 GetMipLevelsCount() const { return m_MipLevels; }
 
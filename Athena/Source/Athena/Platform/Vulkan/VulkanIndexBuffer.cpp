@@ -31,6 +31,7 @@ namespace Athena
 		});
 
 		m_IndexBufferSet.clear();
+		m_MappedDataSet.clear();
 	}
 
 	void VulkanIndexBuffer::Resize(uint64 size)
@@ -52,25 +53,18 @@ namespace Athena
 			VkBufferCreateInfo bufferInfo = {};
 			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			bufferInfo.size = bufferSize;
-			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-			VulkanBufferAllocation stagingBuffer = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
-
-			void* mappedData = stagingBuffer.MapMemory();
-			memcpy(mappedData, m_Info.Data, bufferSize);
-			stagingBuffer.UnmapMemory();
-
 			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+
 			m_IndexBuffer = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, (VmaAllocationCreateFlagBits)0, m_Info.Name);
 			Vulkan::SetObjectDebugName(m_IndexBuffer.GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, m_Info.Name);
 
-			Vulkan::CopyBuffer(stagingBuffer.GetBuffer(), m_IndexBuffer.GetBuffer(), bufferSize);
-
-			allocator->DestroyBuffer(stagingBuffer);
+			if (m_Info.Data != nullptr)
+				VulkanContext::GetUploader()->UploadBuffer(m_IndexBuffer.GetBuffer(), m_Info.Data, bufferSize);
 		}
 		else if (m_Info.Flags == BufferMemoryFlags::CPU_WRITEABLE)
 		{
 			m_IndexBufferSet.resize(Renderer::GetFramesInFlight());
+			m_MappedDataSet.resize(Renderer::GetFramesInFlight());
 
 			for (uint32 i = 0; i < m_IndexBufferSet.size(); ++i)
 			{
@@ -82,15 +76,12 @@ namespace Athena
 				bufferInfo.size = bufferSize;
 				bufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 
-				m_IndexBufferSet[i] = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, bufferName);
+				m_IndexBufferSet[i] = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags, bufferName);
+				m_MappedDataSet[i] = (byte*)m_IndexBufferSet[i].GetMappedData();
 				Vulkan::SetObjectDebugName(m_IndexBufferSet[i].GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, bufferName);
 
 				if (m_Info.Data != nullptr)
-				{
-					void* mappedData = m_IndexBufferSet[i].MapMemory();
-					memcpy(mappedData, m_Info.Data, bufferSize);
-					m_IndexBufferSet[i].UnmapMemory();
-				}
+					memcpy(m_MappedDataSet[i], m_Info.Data, bufferSize);
 			}
 		}
 
@@ -101,11 +92,13 @@ namespace Athena
 	{
 		ATN_CORE_VERIFY(m_Info.Flags == BufferMemoryFlags::CPU_WRITEABLE);
 			
-		auto buffer = m_IndexBufferSet[Renderer::GetCurrentFrameIndex()];
+		memcpy(m_MappedDataSet[Renderer::GetCurrentFrameIndex()] + offset, data, size);
+	}
 
-		void* mappedData = buffer.MapMemory();
-		memcpy((byte*)mappedData + offset, data, size);
-		buffer.UnmapMemory();
+	void* VulkanIndexBuffer::GetMappedMemory()
+	{
+		ATN_CORE_ASSERT(m_Info.Flags == BufferMemoryFlags::CPU_WRITEABLE);
+		return m_MappedDataSet[Renderer::GetCurrentFrameIndex()];
 	}
 
 	VkBuffer VulkanIndexBuffer::GetVulkanIndexBuffer() const
@@ -17,6 +17,7 @@ namespace Athena
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset = 0) override;
 		virtual void Resize(uint64 size) override;
+		virtual void* GetMappedMemory() override;
 
 		VkBuffer GetVulkanIndexBuffer() const;
 
@@ -26,5 +27,6 @@ namespace Athena
 	private:
 		VulkanBufferAllocation m_IndexBuffer;
 		std::vector<VulkanBufferAllocation> m_IndexBufferSet;
+		std::vector<byte*> m_MappedDataSet;
 	};
 }
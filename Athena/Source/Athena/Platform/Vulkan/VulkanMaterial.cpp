@@ -28,14 +28,14 @@ namespace Athena
 		
 	}
 
-	void VulkanMaterial::Set(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex)
+	void VulkanMaterial::SetResourceInternal(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex)
 	{
 		m_DescriptorSetManager.Set(name, resource, arrayIndex);
 	}
 
-	Ref<RenderResource> VulkanMaterial::GetResourceInternal(const String& name)
+	Ref<RenderResource> VulkanMaterial::GetResourceInternal(const String& name, uint32 arrayIndex)
 	{
-		return m_DescriptorSetManager.Get(name);
+		return m_DescriptorSetManager.Get(name, arrayIndex);
 	}
 
 	void VulkanMaterial::Bind(const Ref<RenderCommandBuffer>& commandBuffer)
@@ -15,8 +15,8 @@ namespace Athena
 		VulkanMaterial(const Ref<Shader>& shader, const String& name);
 		~VulkanMaterial();
 
-		virtual void Set(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex) override;
-		virtual Ref<RenderResource> GetResourceInternal(const String& name) override;
+		virtual void SetResourceInternal(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex) override;
+		virtual Ref<RenderResource> GetResourceInternal(const String& name, uint32 arrayIndex) override;
 
 		virtual void Bind(const Ref<RenderCommandBuffer>& commandBuffer) override;
 
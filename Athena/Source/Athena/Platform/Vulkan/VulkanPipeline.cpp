@@ -333,7 +333,7 @@ namespace Athena
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 		pipelineInfo.basePipelineIndex = -1;
 
-		VK_CHECK(vkCreateGraphicsPipelines(VulkanContext::GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_VulkanPipeline));
+		VK_CHECK(vkCreateGraphicsPipelines(VulkanContext::GetLogicalDevice(), VulkanContext::GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_VulkanPipeline));
 		Vulkan::SetObjectDebugName(m_VulkanPipeline, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT, m_Info.Name);
 	}
 }
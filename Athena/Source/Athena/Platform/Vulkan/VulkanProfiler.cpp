@@ -41,16 +41,7 @@ namespace Athena
 			queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
 			queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
 			queryPoolInfo.queryCount = m_Info.MaxPipelineQueriesCount * Renderer::GetFramesInFlight();
-			queryPoolInfo.pipelineStatistics =
-				VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
-				VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+			queryPoolInfo.pipelineStatistics = PipelineStatisticsFlags;
 
 			VK_CHECK(vkCreateQueryPool(VulkanContext::GetLogicalDevice(), &queryPoolInfo, nullptr, &m_PipelineStatsQueryPool));
 			Vulkan::SetObjectDebugName(m_TimeQueryPool, VK_DEBUG_REPORT_OBJECT_TYPE_QUERY_POOL_EXT, std::format("{}_PipelineStatsPool", m_Info.Name));
@@ -3,6 +3,8 @@
 #include "Athena/Renderer/Renderer.h"
 #include "Athena/Core/Application.h"
 #include "Athena/Platform/Vulkan/VulkanUtils.h"
+#include "Athena/Platform/Vulkan/VulkanProfiler.h"
+#include "Athena/Platform/Vulkan/VulkanRenderPass.h"
 
 
 namespace Athena
@@ -11,6 +13,13 @@ namespace Athena
 	{
 		m_Info = info;
 
+		// Secondary command buffers are allocated from thread command pools at begin
+		if (m_Info.Usage == RenderCommandBufferUsage::SECONDARY)
+		{
+			m_CommandBuffers.resize(Renderer::GetFramesInFlight(), VK_NULL_HANDLE);
+			return;
+		}
+
 		uint32 count = 0;
 		switch (m_Info.Usage)
 		{
@@ -33,6 +42,9 @@ namespace Athena
 
 	VulkanRenderCommandBuffer::~VulkanRenderCommandBuffer()
 	{
+		if (m_Info.Usage == RenderCommandBufferUsage::SECONDARY)
+			return;
+
 		Renderer::SubmitResourceFree([commandBuffers = m_CommandBuffers]()
 		{
 			vkFreeCommandBuffers(VulkanContext::GetLogicalDevice(), VulkanContext::GetCommandPool(), commandBuffers.size(), commandBuffers.data());
@@ -41,6 +53,8 @@ namespace Athena
 
 	void VulkanRenderCommandBuffer::Begin()
 	{
+		ATN_CORE_ASSERT(m_Info.Usage != RenderCommandBufferUsage::SECONDARY, "Use BeginSecondary");
+
 		VkCommandBuffer vkCommandBuffer = GetActiveCommandBuffer();
 
 		if (m_Info.Usage != RenderCommandBufferUsage::IMMEDIATE)
@@ -58,12 +72,49 @@ namespace Athena
 		VK_CHECK(vkEndCommandBuffer(GetActiveCommandBuffer()));
 	}
 
+	void VulkanRenderCommandBuffer::BeginSecondary(const Ref<RenderPass>& renderPass)
+	{
+		ATN_CORE_ASSERT(m_Info.Usage == RenderCommandBufferUsage::SECONDARY);
+
+		VkCommandBuffer vkCommandBuffer = VulkanContext::AllocateSecondaryCommandBuffer();
+		m_CommandBuffers[Renderer::GetCurrentFrameIndex()] = vkCommandBuffer;
+
+		Vulkan::SetObjectDebugName(vkCommandBuffer, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT, m_Info.Name);
+
+		Ref<VulkanRenderPass> vkRenderPass = renderPass.As<VulkanRenderPass>();
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = vkRenderPass->GetVulkanRenderPass();
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = vkRenderPass->GetVulkanFramebuffer();
+		inheritanceInfo.pipelineStatistics = Renderer::GetRenderCaps().InheritedQueries ? VulkanProfiler::PipelineStatisticsFlags : 0;
+
+		VkCommandBufferBeginInfo cmdBufBeginInfo = {};
+		cmdBufBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmdBufBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		cmdBufBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		VK_CHECK(vkBeginCommandBuffer(vkCommandBuffer, &cmdBufBeginInfo));
+	}
+
+	void VulkanRenderCommandBuffer::ExecuteSecondary(const Ref<RenderCommandBuffer>& secondary)
+	{
+		ATN_CORE_ASSERT(m_Info.Usage != RenderCommandBufferUsage::SECONDARY);
+
+		VkCommandBuffer vkSecondary = secondary.As<VulkanRenderCommandBuffer>()->GetActiveCommandBuffer();
+		ATN_CORE_ASSERT(vkSecondary != VK_NULL_HANDLE, "Secondary command buffer was not recorded in this frame");
+
+		vkCmdExecuteCommands(GetActiveCommandBuffer(), 1, &vkSecondary);
+	}
+
 	void VulkanRenderCommandBuffer::Submit()
 	{
 		switch (m_Info.Usage)
 		{
 		case RenderCommandBufferUsage::PRESENT: SubmitForPresent(); break;
 		case RenderCommandBufferUsage::IMMEDIATE: SubmitImmediate(); break;
+		case RenderCommandBufferUsage::SECONDARY: ATN_CORE_ASSERT(false, "Secondary command buffer can not be submitted"); break;
 		}
 	}
 
@@ -87,6 +138,9 @@ namespace Athena
 		submitInfo.signalSemaphoreCount = 1;
 		submitInfo.pSignalSemaphores = &frameData.RenderCompleteSemaphore;
 
+		// Uploads recorded during frame must be submitted before frame commands
+		VulkanContext::GetUploader()->Flush();
+
 		{
 			ATN_PROFILE_SCOPE("vkQueueSubmit");
 			Timer timer = Timer();
@@ -98,6 +152,8 @@ namespace Athena
 
 	void VulkanRenderCommandBuffer::SubmitImmediate()
 	{
+		VulkanContext::GetUploader()->Flush();
+
 		VkCommandBuffer commandBuffer = GetActiveCommandBuffer();
 
 		VkSubmitInfo submitInfo = {};
@@ -126,6 +182,7 @@ namespace Athena
 		{
 		case RenderCommandBufferUsage::PRESENT: return m_CommandBuffers[Renderer::GetCurrentFrameIndex()];
 		case RenderCommandBufferUsage::IMMEDIATE: return m_CommandBuffers[0];
+		case RenderCommandBufferUsage::SECONDARY: return m_CommandBuffers[Renderer::GetCurrentFrameIndex()];
 		}
 
 		return VK_NULL_HANDLE;
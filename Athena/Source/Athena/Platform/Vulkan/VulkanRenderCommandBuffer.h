@@ -18,6 +18,9 @@ namespace Athena
 		virtual void End() override;
 		virtual void Submit() override;
 
+		virtual void BeginSecondary(const Ref<RenderPass>& renderPass) override;
+		virtual void ExecuteSecondary(const Ref<RenderCommandBuffer>& secondary) override;
+
 		VkCommandBuffer GetActiveCommandBuffer();
 
 	private:
@@ -66,7 +66,7 @@ namespace Athena
 		});
 	}
 
-	void VulkanRenderPass::Begin(const Ref<RenderCommandBuffer>& commandBuffer)
+	void VulkanRenderPass::Begin(const Ref<RenderCommandBuffer>& commandBuffer, RenderPassContents contents)
 	{
 		if(m_Info.DebugColor != LinearColor(0.f))
 			Renderer::BeginDebugRegion(commandBuffer, m_Info.Name, m_Info.DebugColor);
@@ -97,7 +97,10 @@ namespace Athena
 		renderPassBeginInfo.clearValueCount = m_ClearColors.size();
 		renderPassBeginInfo.pClearValues = m_ClearColors.data();
 
-		vkCmdBeginRenderPass(vkcmdBuf, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		VkSubpassContents subpassContents = contents == RenderPassContents::SECONDARY_COMMAND_BUFFERS ?
+			VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+
+		vkCmdBeginRenderPass(vkcmdBuf, &renderPassBeginInfo, subpassContents);
 	}
 
 	void VulkanRenderPass::End(const Ref<RenderCommandBuffer>& commandBuffer)
@@ -13,13 +13,14 @@ namespace Athena
 		VulkanRenderPass(const RenderPassCreateInfo& info);
 		~VulkanRenderPass();
 
-		virtual void Begin(const Ref<RenderCommandBuffer>& commandBuffer) override;
+		virtual void Begin(const Ref<RenderCommandBuffer>& commandBuffer, RenderPassContents contents = RenderPassContents::INLINE) override;
 		virtual void End(const Ref<RenderCommandBuffer>& commandBuffer) override;
 
 		virtual void Resize(uint32 width, uint32 height) override;
 		virtual void Bake() override;
 
 		VkRenderPass GetVulkanRenderPass() const { return m_VulkanRenderPass; };
+		VkFramebuffer GetVulkanFramebuffer() const { return m_VulkanFramebuffer; };
 
 	private:
 		void BuildDependencies(std::vector<VkSubpassDependency>& dependencies);
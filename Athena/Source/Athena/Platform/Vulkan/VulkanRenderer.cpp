@@ -347,4 +347,9 @@ namespace Athena
 	{
 		return VulkanContext::GetAllocator()->GetMemoryUsage();
 	}
+
+	uint64 VulkanRenderer::GetMemoryBudget()
+	{
+		return VulkanContext::GetAllocator()->GetMemoryBudget();
+	}
 }
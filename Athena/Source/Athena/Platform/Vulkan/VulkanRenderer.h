@@ -33,6 +33,7 @@ namespace Athena
 
 		virtual void GetRenderCapabilities(RenderCapabilities& caps) override;
 		virtual uint64 GetMemoryUsage() override;
+		virtual uint64 GetMemoryBudget() override;
 		virtual void WaitDeviceIdle() override;
 
 	private:
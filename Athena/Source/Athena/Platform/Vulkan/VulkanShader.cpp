@@ -1,17 +1,24 @@
 #include "VulkanShader.h"
 
 #include "Athena/Core/FileSystem.h"
+#include "Athena/Core/Time.h"
 #include "Athena/Platform/Vulkan/VulkanUtils.h"
 
 
 namespace Athena
 {
-	VulkanShader::VulkanShader(const FilePath& path, const String& name)
+	VulkanShader::VulkanShader(const FilePath& path, const String& name, bool compile)
 	{
 		m_FilePath = path;
 		m_Name = name;
+		m_IsCompiled = false;
 		m_PipelineLayout = VK_NULL_HANDLE;
-		CompileOrGetFromCache(false);
+
+		if (compile)
+		{
+			Compile(false);
+			Bake();
+		}
 	}
 
 	VulkanShader::VulkanShader(const FilePath& path)
@@ -42,12 +49,8 @@ namespace Athena
 
 	void VulkanShader::Reload()
 	{
-		CompileOrGetFromCache(true);
-
-		for (const auto& [_, callback] : m_OnReloadCallbacks)
-		{
-			callback();
-		}
+		if (Compile(false))
+			Bake();
 	}
 
 	bool VulkanShader::IsCompute()
@@ -55,7 +58,34 @@ namespace Athena
 		return m_VulkanShaderModules.contains(ShaderStage::COMPUTE_STAGE);
 	}
 
-	void VulkanShader::CompileOrGetFromCache(bool forceCompile)
+	bool VulkanShader::Compile(bool forceCompile)
+	{
+		Timer compileTimer;
+
+		m_Compiler = Scope<ShaderCompiler>::Create(m_FilePath, m_Name);
+
+		// Already baked binaries are still valid
+		if (!forceCompile && m_IsCompiled && m_PipelineLayout != VK_NULL_HANDLE && m_Compiler->IsCacheUpToDate())
+		{
+			m_Compiler.Release();
+			return false;
+		}
+
+		m_IsCompiled = m_Compiler->CompileOrGetFromCache(forceCompile);
+
+		if (!m_IsCompiled)
+			return true;
+
+		Time compileTime = compileTimer.ElapsedTime();
+		Timer reflectTimer;
+
+		m_PendingMetaData = m_Compiler->Reflect();
+
+		ATN_CORE_TIMING_TAG("Renderer", "Shader '{}' compilation took {}, reflection took {}", m_Name, compileTime, reflectTimer.ElapsedTime());
+		return true;
+	}
+
+	void VulkanShader::Bake()
 	{
 		// TODO: For now hot reloading does not affect any shader resources information, such as: 
 		// descriptor set layouts and pipeline layout (how would we add new resources or delete old resources in materials and pipelines?)
@@ -72,18 +102,25 @@ namespace Athena
 			m_VulkanShaderModules.clear();
 		}
 
-
-		ShaderCompiler compiler(m_FilePath, m_Name);
-		m_IsCompiled = compiler.CompileOrGetFromCache(forceCompile);
+		ATN_CORE_ASSERT(m_Compiler, "Shader must be compiled before bake");
+		Scope<ShaderCompiler> compiler = std::move(m_Compiler);
 
 		if (!m_IsCompiled)
 			return;
 
-		m_MetaData = compiler.Reflect();
-		CreateVulkanShaderModulesAndStages(compiler);
+		m_MetaData = m_PendingMetaData;
+		CreateVulkanShaderModulesAndStages(*compiler);
 
+		// Reload, pipelines have to be recreated with new modules
 		if (m_PipelineLayout)
+		{
+			for (const auto& [_, callback] : m_OnReloadCallbacks)
+			{
+				callback();
+			}
+
 			return;
+		}
 
 		struct DescriptorSetLayoutStatistics
 		{
@@ -12,11 +12,14 @@ namespace Athena
 	class VulkanShader : public Shader
 	{
 	public:
-		VulkanShader(const FilePath& path, const String& name);
+		VulkanShader(const FilePath& path, const String& name, bool compile = true);
 		VulkanShader(const FilePath& path);
 
 		~VulkanShader();
 
+		virtual bool Compile(bool forceCompile) override;
+		virtual void Bake() override;
+
 		virtual void Reload() override;
 		virtual bool IsCompute() override;
 
@@ -25,10 +28,13 @@ namespace Athena
 		VkPipelineLayout GetPipelineLayout() const { return m_PipelineLayout; }
 
 	private:
-		void CompileOrGetFromCache(bool forceCompile);
 		void CreateVulkanShaderModulesAndStages(const ShaderCompiler& compiler);
 
 	private:
+		// Result of Compile, released in Bake
+		Scope<ShaderCompiler> m_Compiler;
+		ShaderMetaData m_PendingMetaData;
+
 		std::unordered_map<ShaderStage, VkShaderModule> m_VulkanShaderModules;
 		std::vector<VkPipelineShaderStageCreateInfo> m_PipelineShaderStages;
 		std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
@@ -31,6 +31,7 @@ namespace Athena
 		});
 
 		m_VulkanSBSet.clear();
+		m_MappedDataSet.clear();
 	}
 
 	void VulkanStorageBuffer::UploadData(const void* data, uint64 size, uint64 offset)
@@ -40,11 +41,13 @@ namespace Athena
 		if (size == 0)
 			return;
 
-		auto& ubo = m_VulkanSBSet[Renderer::GetCurrentFrameIndex()];
+		memcpy(m_MappedDataSet[Renderer::GetCurrentFrameIndex()] + offset, data, size);
+	}
 
-		void* mappedMemory = ubo.MapMemory();
-		memcpy(mappedMemory, data, size);
-		ubo.UnmapMemory();
+	void* VulkanStorageBuffer::GetMappedMemory()
+	{
+		ATN_CORE_ASSERT(m_Flags == BufferMemoryFlags::CPU_WRITEABLE);
+		return m_MappedDataSet[Renderer::GetCurrentFrameIndex()];
 	}
 
 	void VulkanStorageBuffer::Resize(uint64 size)
@@ -78,6 +81,7 @@ namespace Athena
 		else if (m_Flags == BufferMemoryFlags::CPU_WRITEABLE)
 		{
 			m_VulkanSBSet.resize(Renderer::GetFramesInFlight());
+			m_MappedDataSet.resize(Renderer::GetFramesInFlight());
 
 			for (uint32 i = 0; i < m_VulkanSBSet.size(); ++i)
 			{
@@ -88,7 +92,8 @@ namespace Athena
 				bufferInfo.size = m_Size;
 				bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 
-				m_VulkanSBSet[i] = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, bufferName);
+				m_VulkanSBSet[i] = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags, bufferName);
+				m_MappedDataSet[i] = (byte*)m_VulkanSBSet[i].GetMappedData();
 				Vulkan::SetObjectDebugName(m_VulkanSBSet[i].GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, bufferName);
 
 				VkDescriptorBufferInfo descriptorInfo;
@@ -18,6 +18,7 @@ namespace Athena
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset) override;
 		virtual void Resize(uint64 size) override;
+		virtual void* GetMappedMemory() override;
 
 		VkBuffer GetVulkanBuffer(uint32 frameIndex) { return m_VulkanSBSet[frameIndex].GetBuffer(); }
 		const VkDescriptorBufferInfo& GetVulkanDescriptorInfo(uint32 frameIndex) const { return m_DescriptorInfo[frameIndex]; }
@@ -27,6 +28,7 @@ namespace Athena
 
 	private:
 		std::vector<VulkanBufferAllocation> m_VulkanSBSet;
+		std::vector<byte*> m_MappedDataSet;
 		std::vector<VkDescriptorBufferInfo> m_DescriptorInfo;
 		BufferMemoryFlags m_Flags;
 	};
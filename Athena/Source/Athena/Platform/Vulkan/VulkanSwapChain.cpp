@@ -259,6 +259,9 @@ namespace Athena
 			appStats.CPUWait = timer.ElapsedTime();
 		}
 
+		// Secondary command buffers of this frame are no longer used by GPU
+		VulkanContext::ResetThreadCommandPools(Renderer::GetCurrentFrameIndex());
+
 		{
 			ATN_PROFILE_SCOPE("vkAcquireNextImageKHR");
 			Timer timer = Timer();
@@ -8,10 +8,11 @@ namespace Athena
 	VulkanTexture2D::VulkanTexture2D(const TextureCreateInfo& info, Buffer data)
 	{
 		m_Info = info;
+		m_ResidentMip = info.PrecomputedMips ? info.FirstResidentMip : 0;
 		m_Sampler = VK_NULL_HANDLE;
 		m_DescriptorInfo.sampler = m_Sampler;
 
-		m_Image = Ref<VulkanImage>::Create(info, TextureType::TEXTURE_2D, data);
+		m_Image = Ref<VulkanImage>::Create(GetResidentImageInfo(), TextureType::TEXTURE_2D, data);
 
 		SetSampler(m_Info.Sampler);
 	}
@@ -31,6 +32,7 @@ namespace Athena
 
 		m_Info.Width = width;
 		m_Info.Height = height;
+		m_ResidentMip = 0;
 
 		m_Image->Resize(width, height);
 
@@ -53,9 +55,48 @@ namespace Athena
 		m_DescriptorInfo.sampler = m_Sampler;
 	}
 
-	void VulkanTexture2D::WriteContentToBuffer(Buffer* dstBuffer)
+	void VulkanTexture2D::WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip, uint32 mipCount)
 	{
-		m_Image->WriteContentToBuffer(dstBuffer);
+		m_Image->WriteContentToBuffer(dstBuffer, baseMip, mipCount);
+	}
+
+	void VulkanTexture2D::UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount)
+	{
+		m_Image->UploadMips(data, size, baseMip, mipCount);
+	}
+
+	void VulkanTexture2D::SetResidentMips(uint32 mip, const void* data, uint64 size)
+	{
+		m_ResidentMip = mip;
+
+		// Previous image is freed when frames in flight that use it are completed
+		m_Image = Ref<VulkanImage>::Create(GetResidentImageInfo(), TextureType::TEXTURE_2D, Buffer());
+		m_Image->UploadMips(data, size, 0, m_Image->GetMipLevelsCount());
+
+		InvalidateViews();
+	}
+
+	void VulkanTexture2D::Recreate(const TextureCreateInfo& info, Buffer data)
+	{
+		// Old sampler is destroyed using previous sampler info
+		SetSampler(info.Sampler);
+
+		m_Info = info;
+		m_ResidentMip = info.PrecomputedMips ? info.FirstResidentMip : 0;
+
+		// Previous image is freed when frames in flight that use it are completed
+		m_Image = Ref<VulkanImage>::Create(GetResidentImageInfo(), TextureType::TEXTURE_2D, data);
+
+		InvalidateViews();
+	}
+
+	TextureCreateInfo VulkanTexture2D::GetResidentImageInfo() const
+	{
+		TextureCreateInfo info = m_Info;
+		info.Width = Math::Max(m_Info.Width >> m_ResidentMip, 1u);
+		info.Height = Math::Max(m_Info.Height >> m_ResidentMip, 1u);
+
+		return info;
 	}
 
 	VkImage VulkanTexture2D::GetVulkanImage() const 
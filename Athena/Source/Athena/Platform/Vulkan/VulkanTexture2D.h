@@ -17,7 +17,9 @@ namespace Athena
 		virtual void Resize(uint32 width, uint32 height) override;
 		virtual void SetSampler(const TextureSamplerCreateInfo& samplerInfo) override;
 
-		virtual void WriteContentToBuffer(Buffer* dstBuffer) override;
+		virtual void WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip = 0, uint32 mipCount = 1) override;
+		virtual void UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount) override;
+		virtual void SetResidentMips(uint32 mip, const void* data, uint64 size) override;
 
 		Ref<VulkanImage> GetImage() const { return m_Image; }
 
@@ -26,6 +28,10 @@ namespace Athena
 		VkImageView GetVulkanImageView() const;
 		const VkDescriptorImageInfo& GetVulkanDescriptorInfo();
 
+	private:
+		virtual void Recreate(const TextureCreateInfo& info, Buffer data) override;
+		TextureCreateInfo GetResidentImageInfo() const;
+
 	private:
 		Ref<VulkanImage> m_Image;
 		VkSampler m_Sampler;
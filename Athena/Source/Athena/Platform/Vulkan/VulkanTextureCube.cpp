@@ -54,9 +54,14 @@ namespace Athena
 		m_DescriptorInfo.sampler = m_Sampler;
 	}
 
-	void VulkanTextureCube::WriteContentToBuffer(Buffer* dstBuffer)
+	void VulkanTextureCube::WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip, uint32 mipCount)
 	{
-		m_Image->WriteContentToBuffer(dstBuffer);
+		m_Image->WriteContentToBuffer(dstBuffer, baseMip, mipCount);
+	}
+
+	void VulkanTextureCube::UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount)
+	{
+		m_Image->UploadMips(data, size, baseMip, mipCount);
 	}
 
 	VkImage VulkanTextureCube::GetVulkanImage() const
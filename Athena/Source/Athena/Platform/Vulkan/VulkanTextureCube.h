@@ -18,7 +18,8 @@ namespace Athena
 		virtual void Resize(uint32 width, uint32 height) override;
 		virtual void SetSampler(const TextureSamplerCreateInfo& samplerInfo) override;
 
-		virtual void WriteContentToBuffer(Buffer* dstBuffer) override;
+		virtual void WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip = 0, uint32 mipCount = 1) override;
+		virtual void UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount) override;
 
 		Ref<VulkanImage> GetImage() const { return m_Image; }
 
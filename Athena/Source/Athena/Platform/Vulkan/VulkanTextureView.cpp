@@ -58,6 +58,9 @@ namespace Athena
 			return;
 		}
 
+		// Image is replaced when streamed texture changes its resident mips
+		m_Image = Vulkan::GetImage(Ref(m_Texture));
+
 		TextureFormat format = m_Texture->GetFormat();
 
 		VkComponentMapping swizzling = {};
@@ -75,7 +78,7 @@ namespace Athena
 			swizzling.b = VK_COMPONENT_SWIZZLE_R;
 		}
 
-		uint32 texMipLevelsCount = m_Texture->GetMipLevelsCount();
+		uint32 texMipLevelsCount = m_Image->GetMipLevelsCount();
 		uint32 viewBaseMipLevel = m_Info.BaseMipLevel;
 		uint32 viewMipLevelCount = m_Info.MipLevelCount;
 		
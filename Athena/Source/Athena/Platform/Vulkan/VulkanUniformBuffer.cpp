@@ -10,6 +10,7 @@ namespace Athena
 		m_Size = size;
 		m_Name = name;
 		m_VulkanUBSet.resize(Renderer::GetFramesInFlight());
+		m_MappedDataSet.resize(Renderer::GetFramesInFlight());
 		m_DescriptorInfo.resize(Renderer::GetFramesInFlight());
 
 		for (uint32 i = 0; i < m_VulkanUBSet.size(); ++i)
@@ -20,7 +21,8 @@ namespace Athena
 			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			bufferInfo.size = m_Size;
 			bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-			m_VulkanUBSet[i] = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, bufferName);
+			m_VulkanUBSet[i] = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags, bufferName);
+			m_MappedDataSet[i] = (byte*)m_VulkanUBSet[i].GetMappedData();
 			Vulkan::SetObjectDebugName(m_VulkanUBSet[i].GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, bufferName);
 
 			VkDescriptorBufferInfo descriptorInfo;
@@ -47,10 +49,6 @@ namespace Athena
 		if (size == 0)
 			return;
 
-		auto& ubo = m_VulkanUBSet[Renderer::GetCurrentFrameIndex()];
-
-		void* mappedMemory = ubo.MapMemory();
-		memcpy((byte*)mappedMemory + offset, data, size);
-		ubo.UnmapMemory();
+		memcpy(m_MappedDataSet[Renderer::GetCurrentFrameIndex()] + offset, data, size);
 	}
 }
@@ -23,6 +23,7 @@ namespace Athena
 
 	private:
 		std::vector<VulkanBufferAllocation> m_VulkanUBSet;
+		std::vector<byte*> m_MappedDataSet;
 		std::vector<VkDescriptorBufferInfo> m_DescriptorInfo;
 	};
 }
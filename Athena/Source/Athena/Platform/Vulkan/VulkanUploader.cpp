@@ -0,0 +1,546 @@
+#include "VulkanUploader.h"
+
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Platform/Vulkan/VulkanUtils.h"
+#include "Athena/Utils/StringUtils.h"
+
+#include <numeric>
+
+
+namespace Athena
+{
+	namespace Utils
+	{
+		static uint64 AlignUp(uint64 value, uint64 alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		static uint32 GetMipExtent(uint32 extent, uint32 mip)
+		{
+			return std::max(extent >> mip, 1u);
+		}
+	}
+
+	VulkanUploader::VulkanUploader()
+	{
+		Ref<VulkanDevice> device = VulkanContext::GetDevice();
+
+		m_DedicatedTransferQueue = device->HasDedicatedTransferQueue();
+		m_TransferQueueFamily = device->GetTransferQueueFamily();
+		m_GraphicsQueueFamily = device->GetQueueFamily();
+
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = StagingRingSize;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+		m_StagingRing = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags, "StagingRing");
+		m_StagingRingData = (byte*)m_StagingRing.GetMappedData();
+		Vulkan::SetObjectDebugName(m_StagingRing.GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, "StagingRing");
+
+		VkCommandPoolCreateInfo commandPoolCI = {};
+		commandPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		commandPoolCI.queueFamilyIndex = m_TransferQueueFamily;
+		VK_CHECK(vkCreateCommandPool(VulkanContext::GetLogicalDevice(), &commandPoolCI, nullptr, &m_TransferCommandPool));
+
+		if (m_DedicatedTransferQueue)
+		{
+			commandPoolCI.queueFamilyIndex = m_GraphicsQueueFamily;
+			VK_CHECK(vkCreateCommandPool(VulkanContext::GetLogicalDevice(), &commandPoolCI, nullptr, &m_GraphicsCommandPool));
+		}
+
+		VkSemaphoreTypeCreateInfo semaphoreTypeCI = {};
+		semaphoreTypeCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		semaphoreTypeCI.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		semaphoreTypeCI.initialValue = 0;
+
+		VkSemaphoreCreateInfo semaphoreCI = {};
+		semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreCI.pNext = &semaphoreTypeCI;
+		VK_CHECK(vkCreateSemaphore(VulkanContext::GetLogicalDevice(), &semaphoreCI, nullptr, &m_TimelineSemaphore));
+
+		ATN_CORE_INFO_TAG("Vulkan", "Created uploader, staging ring {}, dedicated transfer queue = {}",
+			Utils::MemoryBytesToString(StagingRingSize), m_DedicatedTransferQueue);
+	}
+
+	VulkanUploader::~VulkanUploader()
+	{
+		WaitIdle();
+
+		for (const auto& buffer : m_CurrentBatch.TemporaryBuffers)
+			VulkanContext::GetAllocator()->DestroyBuffer(buffer);
+
+		vkDestroySemaphore(VulkanContext::GetLogicalDevice(), m_TimelineSemaphore, nullptr);
+
+		vkDestroyCommandPool(VulkanContext::GetLogicalDevice(), m_TransferCommandPool, nullptr);
+		if (m_GraphicsCommandPool != VK_NULL_HANDLE)
+			vkDestroyCommandPool(VulkanContext::GetLogicalDevice(), m_GraphicsCommandPool, nullptr);
+
+		VulkanContext::GetAllocator()->DestroyBuffer(m_StagingRing, "StagingRing");
+	}
+
+	void VulkanUploader::UploadBuffer(VkBuffer dstBuffer, const void* data, uint64 size, uint64 dstOffset)
+	{
+		ATN_PROFILE_FUNC();
+
+		if (size == 0)
+			return;
+
+		std::scoped_lock lock(m_Mutex);
+
+		StagingRegion staging = AllocateStaging(size, 16);
+		memcpy(staging.Data, data, size);
+		vmaFlushAllocation(VulkanContext::GetAllocator()->GetInternalAllocator(), staging.Allocation, staging.Offset, size);
+
+		if (!m_BatchRecording)
+			BeginBatch();
+
+		VkCommandBuffer commandBuffer = m_CurrentBatch.TransferCommandBuffer;
+
+		// Copies in one command buffer are not ordered, writes into the same buffer must be serialized
+		if (!m_CurrentBatch.DstBuffers.insert(dstBuffer).second)
+		{
+			VkMemoryBarrier barrier = {};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			vkCmdPipelineBarrier(
+				commandBuffer,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				0,
+				1, &barrier,
+				0, nullptr,
+				0, nullptr);
+		}
+
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = staging.Offset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = size;
+
+		vkCmdCopyBuffer(commandBuffer, staging.Buffer, dstBuffer, 1, &copyRegion);
+
+		VkBufferMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		barrier.srcQueueFamilyIndex = m_DedicatedTransferQueue ? m_TransferQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = m_DedicatedTransferQueue ? m_GraphicsQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer = dstBuffer;
+		barrier.offset = dstOffset;
+		barrier.size = size;
+
+		m_CurrentBatch.BufferBarriers.push_back(barrier);
+	}
+
+	void VulkanUploader::UploadImage(const VulkanImageUploadInfo& info, const void* data, uint64 size)
+	{
+		ATN_PROFILE_FUNC();
+
+		ATN_CORE_ASSERT(info.DataMipLevels != 0 && info.BaseMipLevel + info.DataMipLevels <= info.MipLevels);
+
+		bool compressed = Texture::IsCompressedFormat(info.Format);
+		uint32 texelSize = compressed ? Texture::BytesPerBlock(info.Format) : Texture::BytesPerPixel(info.Format);
+
+		uint32 baseMip = info.BaseMipLevel;
+		uint32 mipCount = info.DataMipLevels;
+		uint64 layerSize = Texture::GetImageSize(info.Format, Utils::GetMipExtent(info.Width, baseMip), Utils::GetMipExtent(info.Height, baseMip));
+		ATN_CORE_ASSERT(size >= layerSize, "Buffer is too small");
+
+		bool allLayers = mipCount > 1 || size >= layerSize * info.Layers;
+
+		uint64 stagingSize = 0;
+		if (mipCount > 1)
+		{
+			for (uint32 mip = baseMip; mip < baseMip + mipCount; ++mip)
+				stagingSize += Texture::GetImageSize(info.Format, Utils::GetMipExtent(info.Width, mip), Utils::GetMipExtent(info.Height, mip)) * info.Layers;
+
+			ATN_CORE_ASSERT(size >= stagingSize, "Buffer is too small");
+		}
+		else
+		{
+			stagingSize = allLayers ? layerSize * info.Layers : layerSize;
+		}
+
+		std::scoped_lock lock(m_Mutex);
+
+		// Buffer offset of image copy must be multiple of texel (or block) size
+		StagingRegion staging = AllocateStaging(stagingSize, std::lcm<uint64>(16, texelSize));
+		memcpy(staging.Data, data, stagingSize);
+		vmaFlushAllocation(VulkanContext::GetAllocator()->GetInternalAllocator(), staging.Allocation, staging.Offset, stagingSize);
+
+		if (!m_BatchRecording)
+			BeginBatch();
+
+		VkCommandBuffer commandBuffer = m_CurrentBatch.TransferCommandBuffer;
+
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = info.Image;
+		barrier.subresourceRange.aspectMask = Vulkan::GetImageAspectMask(info.Format);
+		barrier.subresourceRange.baseMipLevel = baseMip;
+		barrier.subresourceRange.levelCount = mipCount;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = info.Layers;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_NONE;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+			commandBuffer,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0, nullptr,
+			0, nullptr,
+			1, &barrier);
+
+		VkBufferImageCopy region = {};
+		region.bufferOffset = staging.Offset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = Vulkan::GetImageAspectMask(info.Format);
+		region.imageSubresource.mipLevel = baseMip;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { Utils::GetMipExtent(info.Width, baseMip), Utils::GetMipExtent(info.Height, baseMip), 1 };
+
+		std::vector<VkBufferImageCopy> regions;
+		if (mipCount > 1)
+		{
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = info.Layers;
+
+			for (uint32 mip = baseMip; mip < baseMip + mipCount; ++mip)
+			{
+				uint32 mipWidth = Utils::GetMipExtent(info.Width, mip);
+				uint32 mipHeight = Utils::GetMipExtent(info.Height, mip);
+
+				region.imageSubresource.mipLevel = mip;
+				region.imageExtent = { mipWidth, mipHeight, 1 };
+				regions.push_back(region);
+
+				region.bufferOffset += Texture::GetImageSize(info.Format, mipWidth, mipHeight) * info.Layers;
+			}
+		}
+		else if (allLayers)
+		{
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = info.Layers;
+			regions.push_back(region);
+		}
+		else
+		{
+			// Every layer is copied from the same staging region
+			for (uint32 layer = 0; layer < info.Layers; ++layer)
+			{
+				region.imageSubresource.baseArrayLayer = layer;
+				region.imageSubresource.layerCount = 1;
+				regions.push_back(region);
+			}
+		}
+
+		vkCmdCopyBufferToImage(commandBuffer, staging.Buffer, info.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions.size(), regions.data());
+
+		bool generateMipMap = info.GenerateMipMap && baseMip == 0 && mipCount == 1;
+
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = generateMipMap ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = generateMipMap ? VK_ACCESS_TRANSFER_READ_BIT : VK_ACCESS_SHADER_READ_BIT;
+		barrier.srcQueueFamilyIndex = m_DedicatedTransferQueue ? m_TransferQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = m_DedicatedTransferQueue ? m_GraphicsQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+
+		m_CurrentBatch.ImageBarriers.push_back(barrier);
+
+		if (generateMipMap)
+			m_CurrentBatch.MipMapImages.push_back(info);
+	}
+
+	void VulkanUploader::Flush()
+	{
+		ATN_PROFILE_FUNC();
+		ATN_CORE_ASSERT(JobSystem::GetCurrentThreadIndex() == 0, "Uploads can be submitted only from main thread");
+
+		std::scoped_lock lock(m_Mutex);
+
+		FlushInternal();
+		ReleaseCompletedBatches();
+	}
+
+	void VulkanUploader::WaitIdle()
+	{
+		std::scoped_lock lock(m_Mutex);
+
+		if (m_InFlightBatches.empty())
+			return;
+
+		WaitForBatch(m_InFlightBatches.back().TimelineValue);
+		ReleaseCompletedBatches();
+	}
+
+	VulkanUploader::StagingRegion VulkanUploader::AllocateStaging(uint64 size, uint64 alignment)
+	{
+		ReleaseCompletedBatches();
+
+		if (size <= StagingRingSize)
+		{
+			uint64 offset;
+			bool allocated = TryAllocateFromRing(size, alignment, &offset);
+
+			// Only main thread can submit batches to free the ring, other threads fall back to temporary buffer
+			bool mainThread = JobSystem::GetCurrentThreadIndex() == 0;
+			while (!allocated && mainThread)
+			{
+				FlushInternal();
+				ATN_CORE_ASSERT(!m_InFlightBatches.empty());
+
+				WaitForBatch(m_InFlightBatches.front().TimelineValue);
+				ReleaseCompletedBatches();
+
+				allocated = TryAllocateFromRing(size, alignment, &offset);
+			}
+
+			if (allocated)
+				return { m_StagingRing.GetBuffer(), m_StagingRing.GetAllocation(), offset, m_StagingRingData + offset };
+		}
+
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+		VulkanBufferAllocation buffer = VulkanContext::GetAllocator()->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags);
+
+		// Released together with the batch
+		m_CurrentBatch.TemporaryBuffers.push_back(buffer);
+
+		return { buffer.GetBuffer(), buffer.GetAllocation(), 0, (byte*)buffer.GetMappedData() };
+	}
+
+	bool VulkanUploader::TryAllocateFromRing(uint64 size, uint64 alignment, uint64* offset)
+	{
+		// Empty ring, restart from the beginning so that any request up to ring size fits
+		if (m_RingHead == m_RingTail)
+		{
+			m_RingHead = Utils::AlignUp(m_RingHead, StagingRingSize);
+			m_RingTail = m_RingHead;
+		}
+
+		uint64 physicalHead = m_RingHead % StagingRingSize;
+		uint64 alignedOffset = Utils::AlignUp(physicalHead, alignment);
+
+		uint64 start = m_RingHead + (alignedOffset - physicalHead);
+
+		// Region can not wrap around, skip the rest of the ring
+		if (alignedOffset + size > StagingRingSize)
+			start = Utils::AlignUp(m_RingHead, StagingRingSize);
+
+		uint64 end = start + size;
+		if (end - m_RingTail > StagingRingSize)
+			return false;
+
+		m_RingHead = end;
+		*offset = start % StagingRingSize;
+
+		return true;
+	}
+
+	void VulkanUploader::BeginBatch()
+	{
+		VkCommandBufferBeginInfo cmdBufBeginInfo = {};
+		cmdBufBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmdBufBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		m_CurrentBatch.TransferCommandBuffer = AllocateCommandBuffer(m_TransferCommandPool, m_FreeTransferCommandBuffers);
+		VK_CHECK(vkBeginCommandBuffer(m_CurrentBatch.TransferCommandBuffer, &cmdBufBeginInfo));
+
+		if (m_DedicatedTransferQueue)
+		{
+			m_CurrentBatch.GraphicsCommandBuffer = AllocateCommandBuffer(m_GraphicsCommandPool, m_FreeGraphicsCommandBuffers);
+			VK_CHECK(vkBeginCommandBuffer(m_CurrentBatch.GraphicsCommandBuffer, &cmdBufBeginInfo));
+		}
+
+		m_BatchRecording = true;
+	}
+
+	void VulkanUploader::FlushInternal()
+	{
+		if (!m_BatchRecording)
+			return;
+
+		UploadBatch& batch = m_CurrentBatch;
+
+		if (m_DedicatedTransferQueue)
+		{
+			// Release ownership on transfer queue, dst access is ignored
+			std::vector<VkBufferMemoryBarrier> bufferBarriers = batch.BufferBarriers;
+			std::vector<VkImageMemoryBarrier> imageBarriers = batch.ImageBarriers;
+
+			for (auto& barrier : bufferBarriers)
+				barrier.dstAccessMask = VK_ACCESS_NONE;
+
+			for (auto& barrier : imageBarriers)
+				barrier.dstAccessMask = VK_ACCESS_NONE;
+
+			vkCmdPipelineBarrier(
+				batch.TransferCommandBuffer,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+				0,
+				0, nullptr,
+				bufferBarriers.size(), bufferBarriers.data(),
+				imageBarriers.size(), imageBarriers.data());
+
+			// Acquire ownership on graphics queue, src access is ignored
+			for (auto& barrier : batch.BufferBarriers)
+				barrier.srcAccessMask = VK_ACCESS_NONE;
+
+			for (auto& barrier : batch.ImageBarriers)
+				barrier.srcAccessMask = VK_ACCESS_NONE;
+
+			vkCmdPipelineBarrier(
+				batch.GraphicsCommandBuffer,
+				VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+				0,
+				0, nullptr,
+				batch.BufferBarriers.size(), batch.BufferBarriers.data(),
+				batch.ImageBarriers.size(), batch.ImageBarriers.data());
+		}
+		else
+		{
+			vkCmdPipelineBarrier(
+				batch.TransferCommandBuffer,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+				0,
+				0, nullptr,
+				batch.BufferBarriers.size(), batch.BufferBarriers.data(),
+				batch.ImageBarriers.size(), batch.ImageBarriers.data());
+		}
+
+		// Blit requires graphics queue
+		VkCommandBuffer graphicsCommandBuffer = m_DedicatedTransferQueue ? batch.GraphicsCommandBuffer : batch.TransferCommandBuffer;
+		for (const auto& info : batch.MipMapImages)
+			Vulkan::BlitMipMap(graphicsCommandBuffer, info.Image, info.Width, info.Height, info.Layers, info.Format, info.MipLevels);
+
+		VK_CHECK(vkEndCommandBuffer(batch.TransferCommandBuffer));
+
+		uint64 transferValue = ++m_LastSubmittedValue;
+
+		VkTimelineSemaphoreSubmitInfo transferTimelineInfo = {};
+		transferTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		transferTimelineInfo.signalSemaphoreValueCount = 1;
+		transferTimelineInfo.pSignalSemaphoreValues = &transferValue;
+
+		VkSubmitInfo transferSubmitInfo = {};
+		transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		transferSubmitInfo.pNext = &transferTimelineInfo;
+		transferSubmitInfo.commandBufferCount = 1;
+		transferSubmitInfo.pCommandBuffers = &batch.TransferCommandBuffer;
+		transferSubmitInfo.signalSemaphoreCount = 1;
+		transferSubmitInfo.pSignalSemaphores = &m_TimelineSemaphore;
+
+		VK_CHECK(vkQueueSubmit(VulkanContext::GetDevice()->GetTransferQueue(), 1, &transferSubmitInfo, VK_NULL_HANDLE));
+
+		batch.TimelineValue = transferValue;
+
+		if (m_DedicatedTransferQueue)
+		{
+			VK_CHECK(vkEndCommandBuffer(batch.GraphicsCommandBuffer));
+
+			uint64 graphicsValue = ++m_LastSubmittedValue;
+			VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+			VkTimelineSemaphoreSubmitInfo graphicsTimelineInfo = {};
+			graphicsTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			graphicsTimelineInfo.waitSemaphoreValueCount = 1;
+			graphicsTimelineInfo.pWaitSemaphoreValues = &transferValue;
+			graphicsTimelineInfo.signalSemaphoreValueCount = 1;
+			graphicsTimelineInfo.pSignalSemaphoreValues = &graphicsValue;
+
+			VkSubmitInfo graphicsSubmitInfo = {};
+			graphicsSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			graphicsSubmitInfo.pNext = &graphicsTimelineInfo;
+			graphicsSubmitInfo.waitSemaphoreCount = 1;
+			graphicsSubmitInfo.pWaitSemaphores = &m_TimelineSemaphore;
+			graphicsSubmitInfo.pWaitDstStageMask = &waitStage;
+			graphicsSubmitInfo.commandBufferCount = 1;
+			graphicsSubmitInfo.pCommandBuffers = &batch.GraphicsCommandBuffer;
+			graphicsSubmitInfo.signalSemaphoreCount = 1;
+			graphicsSubmitInfo.pSignalSemaphores = &m_TimelineSemaphore;
+
+			// Frame commands submitted after this are ordered by acquire barriers, no extra wait is required
+			VK_CHECK(vkQueueSubmit(VulkanContext::GetDevice()->GetQueue(), 1, &graphicsSubmitInfo, VK_NULL_HANDLE));
+
+			batch.TimelineValue = graphicsValue;
+		}
+
+		batch.RingEnd = m_RingHead;
+
+		m_InFlightBatches.push_back(std::move(batch));
+		m_CurrentBatch = UploadBatch();
+		m_BatchRecording = false;
+	}
+
+	void VulkanUploader::WaitForBatch(uint64 timelineValue)
+	{
+		ATN_PROFILE_FUNC();
+
+		VkSemaphoreWaitInfo waitInfo = {};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &m_TimelineSemaphore;
+		waitInfo.pValues = &timelineValue;
+
+		VK_CHECK(vkWaitSemaphores(VulkanContext::GetLogicalDevice(), &waitInfo, DEFAULT_FENCE_TIMEOUT));
+	}
+
+	void VulkanUploader::ReleaseCompletedBatches()
+	{
+		if (m_InFlightBatches.empty())
+			return;
+
+		uint64 completedValue;
+		VK_CHECK(vkGetSemaphoreCounterValue(VulkanContext::GetLogicalDevice(), m_TimelineSemaphore, &completedValue));
+
+		while (!m_InFlightBatches.empty() && m_InFlightBatches.front().TimelineValue <= completedValue)
+		{
+			UploadBatch& batch = m_InFlightBatches.front();
+
+			m_RingTail = std::max(m_RingTail, batch.RingEnd);
+
+			m_FreeTransferCommandBuffers.push_back(batch.TransferCommandBuffer);
+			if (batch.GraphicsCommandBuffer != VK_NULL_HANDLE)
+				m_FreeGraphicsCommandBuffers.push_back(batch.GraphicsCommandBuffer);
+
+			for (const auto& buffer : batch.TemporaryBuffers)
+				VulkanContext::GetAllocator()->DestroyBuffer(buffer);
+
+			m_InFlightBatches.pop_front();
+		}
+	}
+
+	VkCommandBuffer VulkanUploader::AllocateCommandBuffer(VkCommandPool pool, std::vector<VkCommandBuffer>& freeList)
+	{
+		if (!freeList.empty())
+		{
+			VkCommandBuffer commandBuffer = freeList.back();
+			freeList.pop_back();
+			return commandBuffer;
+		}
+
+		VkCommandBufferAllocateInfo cmdBufAllocInfo = {};
+		cmdBufAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		cmdBufAllocInfo.commandPool = pool;
+		cmdBufAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cmdBufAllocInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		VK_CHECK(vkAllocateCommandBuffers(VulkanContext::GetLogicalDevice(), &cmdBufAllocInfo, &commandBuffer));
+
+		return commandBuffer;
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+#include "Athena/Renderer/Texture.h"
+#include "Athena/Platform/Vulkan/VulkanAllocator.h"
+
+#include <vulkan/vulkan.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+
+namespace Athena
+{
+	struct VulkanImageUploadInfo
+	{
+		VkImage Image = VK_NULL_HANDLE;
+		TextureFormat Format;
+		// Size of mip 0
+		uint32 Width = 0;
+		uint32 Height = 0;
+		uint32 Layers = 1;
+		uint32 MipLevels = 1;
+		// Range of mip levels stored in data one after another, each level contains all layers
+		uint32 BaseMipLevel = 0;
+		uint32 DataMipLevels = 1;
+		// Mips are blitted from level 0 on graphics queue, only if data contains just level 0
+		bool GenerateMipMap = false;
+	};
+
+	// Records all GPU uploads into one batch that is submitted once per frame.
+	// Data is copied into persistently mapped staging ring, regions of the ring are reused
+	// when timeline semaphore reaches value of the batch that used them.
+	// If device has dedicated transfer queue, copies run on it and ownership is transferred to graphics queue.
+	class VulkanUploader : public RefCounted
+	{
+	public:
+		static constexpr uint64 StagingRingSize = 64 * 1024 * 1024;
+
+	public:
+		VulkanUploader();
+		~VulkanUploader();
+
+		// Can be called from any thread, data is copied before return
+		void UploadBuffer(VkBuffer dstBuffer, const void* data, uint64 size, uint64 dstOffset = 0);
+		// If data contains only one layer of one mip, it is copied into every layer of the image
+		void UploadImage(const VulkanImageUploadInfo& info, const void* data, uint64 size);
+
+		// Submits recorded uploads, work submitted to graphics queue after this call sees uploaded data.
+		// Main thread only.
+		void Flush();
+		// Blocks until all submitted uploads are completed
+		void WaitIdle();
+
+	private:
+		struct UploadBatch
+		{
+			VkCommandBuffer TransferCommandBuffer = VK_NULL_HANDLE;
+			// Only used with dedicated transfer queue, acquires ownership and generates mips
+			VkCommandBuffer GraphicsCommandBuffer = VK_NULL_HANDLE;
+			std::vector<VkBufferMemoryBarrier> BufferBarriers;
+			std::vector<VkImageMemoryBarrier> ImageBarriers;
+			std::vector<VulkanImageUploadInfo> MipMapImages;
+			std::vector<VulkanBufferAllocation> TemporaryBuffers;
+			std::unordered_set<VkBuffer> DstBuffers;
+			uint64 RingEnd = 0;
+			uint64 TimelineValue = 0;
+		};
+
+		struct StagingRegion
+		{
+			VkBuffer Buffer;
+			VmaAllocation Allocation;
+			uint64 Offset;
+			byte* Data;
+		};
+
+	private:
+		StagingRegion AllocateStaging(uint64 size, uint64 alignment);
+		bool TryAllocateFromRing(uint64 size, uint64 alignment, uint64* offset);
+
+		void BeginBatch();
+		void FlushInternal();
+		void WaitForBatch(uint64 timelineValue);
+		void ReleaseCompletedBatches();
+
+		VkCommandBuffer AllocateCommandBuffer(VkCommandPool pool, std::vector<VkCommandBuffer>& freeList);
+
+	private:
+		VulkanBufferAllocation m_StagingRing;
+		byte* m_StagingRingData = nullptr;
+		// Virtual positions, physical offset is position % StagingRingSize
+		uint64 m_RingHead = 0;
+		uint64 m_RingTail = 0;
+
+		bool m_DedicatedTransferQueue = false;
+		uint32 m_TransferQueueFamily = 0;
+		uint32 m_GraphicsQueueFamily = 0;
+
+		VkCommandPool m_TransferCommandPool = VK_NULL_HANDLE;
+		VkCommandPool m_GraphicsCommandPool = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> m_FreeTransferCommandBuffers;
+		std::vector<VkCommandBuffer> m_FreeGraphicsCommandBuffers;
+
+		VkSemaphore m_TimelineSemaphore = VK_NULL_HANDLE;
+		uint64 m_LastSubmittedValue = 0;
+
+		UploadBatch m_CurrentBatch;
+		bool m_BatchRecording = false;
+		std::deque<UploadBatch> m_InFlightBatches;
+
+		std::mutex m_Mutex;
+	};
+}
@@ -1,4 +1,5 @@
 #include "Athena/Core/Core.h"
+#include "Athena/Core/JobSystem.h"
 #include "Athena/Renderer/Shader.h"
 #include "Athena/Renderer/Texture.h"
 #include "Athena/Platform/Vulkan/VulkanContext.h"
@@ -231,6 +232,15 @@ namespace Athena::Vulkan
         case TextureFormat::RGBA16F:         return VK_FORMAT_R16G16B16A16_SFLOAT;
         case TextureFormat::RGBA32F:         return VK_FORMAT_R32G32B32A32_SFLOAT;
 
+        case TextureFormat::BC1:             return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case TextureFormat::BC1_SRGB:        return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case TextureFormat::BC3:             return VK_FORMAT_BC3_UNORM_BLOCK;
+        case TextureFormat::BC3_SRGB:        return VK_FORMAT_BC3_SRGB_BLOCK;
+        case TextureFormat::BC4:             return VK_FORMAT_BC4_UNORM_BLOCK;
+        case TextureFormat::BC5:             return VK_FORMAT_BC5_UNORM_BLOCK;
+        case TextureFormat::BC7:             return VK_FORMAT_BC7_UNORM_BLOCK;
+        case TextureFormat::BC7_SRGB:        return VK_FORMAT_BC7_SRGB_BLOCK;
+
         case TextureFormat::DEPTH16:         return VK_FORMAT_D16_UNORM;
         case TextureFormat::DEPTH24STENCIL8: return VK_FORMAT_D24_UNORM_S8_UINT;
         case TextureFormat::DEPTH32F:        return VK_FORMAT_D32_SFLOAT;
@@ -397,8 +407,11 @@ namespace Athena::Vulkan
         return nullptr;
     }
 
+    // Main thread only, command pool and graphics queue are not synchronized with other threads
     inline VkCommandBuffer BeginSingleTimeCommands()
     {
+        ATN_CORE_ASSERT(JobSystem::GetCurrentThreadIndex() == 0, "Single time commands can be submitted only from main thread");
+
         VkCommandBufferAllocateInfo cmdBufAllocInfo = {};
         cmdBufAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         cmdBufAllocInfo.commandPool = VulkanContext::GetCommandPool();
@@ -421,6 +434,11 @@ namespace Athena::Vulkan
     {
         vkEndCommandBuffer(vkCommandBuffer);
 
+        ATN_CORE_ASSERT(JobSystem::GetCurrentThreadIndex() == 0, "Single time commands can be submitted only from main thread");
+
+        // Commands may use resources uploaded in current frame
+        VulkanContext::GetUploader()->Flush();
+
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.commandBufferCount = 1;
@@ -441,20 +459,6 @@ namespace Athena::Vulkan
         vkFreeCommandBuffers(VulkanContext::GetLogicalDevice(), VulkanContext::GetCommandPool(), 1, &vkCommandBuffer);
     }
 
-    inline void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
-    {
-        VkCommandBuffer vkCommandBuffer = BeginSingleTimeCommands();
-        {
-            VkBufferCopy copyRegion{};
-            copyRegion.srcOffset = 0;
-            copyRegion.dstOffset = 0;
-            copyRegion.size = size;
-
-            vkCmdCopyBuffer(vkCommandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-        }
-        EndSingleTimeCommands(vkCommandBuffer);
-    }
-
     inline void BlitMipMap(VkCommandBuffer commandBuffer, VkImage image, uint32 width, uint32 height, uint32 layers, TextureFormat format, uint32 mipLevels)
     {
         int32 mipWidth = width;
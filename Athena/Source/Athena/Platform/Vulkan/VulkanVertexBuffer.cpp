@@ -31,6 +31,7 @@ namespace Athena
 		});
 
 		m_VertexBufferSet.clear();
+		m_MappedDataSet.clear();
 	}
 
 	void VulkanVertexBuffer::UploadData(const void* data, uint64 size, uint64 offset)
@@ -40,11 +41,13 @@ namespace Athena
 		if (size == 0)
 			return;
 
-		auto buffer = m_VertexBufferSet[Renderer::GetCurrentFrameIndex()];
+		memcpy(m_MappedDataSet[Renderer::GetCurrentFrameIndex()] + offset, data, size);
+	}
 
-		void* mappedData = buffer.MapMemory();
-		memcpy((byte*)mappedData + offset, data, size);
-		buffer.UnmapMemory();
+	void* VulkanVertexBuffer::GetMappedMemory()
+	{
+		ATN_CORE_ASSERT(m_Info.Flags == BufferMemoryFlags::CPU_WRITEABLE);
+		return m_MappedDataSet[Renderer::GetCurrentFrameIndex()];
 	}
 
 	void VulkanVertexBuffer::Resize(uint64 size)
@@ -65,25 +68,18 @@ namespace Athena
 			VkBufferCreateInfo bufferInfo = {};
 			bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			bufferInfo.size = bufferSize;
-			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-			VulkanBufferAllocation stagingBuffer = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
-
-			void* mappedData = stagingBuffer.MapMemory();
-			memcpy(mappedData, m_Info.Data, bufferSize);
-			stagingBuffer.UnmapMemory();
-
 			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
 			m_VertexBuffer = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, (VmaAllocationCreateFlagBits)0, m_Info.Name);
 			Vulkan::SetObjectDebugName(m_VertexBuffer.GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, m_Info.Name);
 
-			Vulkan::CopyBuffer(stagingBuffer.GetBuffer(), m_VertexBuffer.GetBuffer(), bufferSize);
-
-			allocator->DestroyBuffer(stagingBuffer);
+			if (m_Info.Data != nullptr)
+				VulkanContext::GetUploader()->UploadBuffer(m_VertexBuffer.GetBuffer(), m_Info.Data, bufferSize);
 		}
 		else if (m_Info.Flags == BufferMemoryFlags::CPU_WRITEABLE)
 		{
 			m_VertexBufferSet.resize(Renderer::GetFramesInFlight());
+			m_MappedDataSet.resize(Renderer::GetFramesInFlight());
 
 			for (uint32 i = 0; i < m_VertexBufferSet.size(); ++i)
 			{
@@ -95,15 +91,12 @@ namespace Athena
 				bufferInfo.size = bufferSize;
 				bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 
-				m_VertexBufferSet[i] = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, bufferName);
+				m_VertexBufferSet[i] = allocator->AllocateBuffer(bufferInfo, VMA_MEMORY_USAGE_AUTO, VulkanAllocator::PersistentMappingFlags, bufferName);
+				m_MappedDataSet[i] = (byte*)m_VertexBufferSet[i].GetMappedData();
 				Vulkan::SetObjectDebugName(m_VertexBufferSet[i].GetBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, bufferName);
 
 				if (m_Info.Data != nullptr)
-				{
-					void* mappedData = m_VertexBufferSet[i].MapMemory();
-					memcpy(mappedData, m_Info.Data, bufferSize);
-					m_VertexBufferSet[i].UnmapMemory();
-				}
+					memcpy(m_MappedDataSet[i], m_Info.Data, bufferSize);
 			}
 		}
 
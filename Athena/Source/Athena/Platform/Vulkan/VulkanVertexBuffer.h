@@ -17,6 +17,7 @@ namespace Athena
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset = 0) override;
 		virtual void Resize(uint64 size) override;
+		virtual void* GetMappedMemory() override;
 
 		VkBuffer GetVulkanVertexBuffer() const;
 
@@ -26,5 +27,6 @@ namespace Athena
 	private:
 		VulkanBufferAllocation m_VertexBuffer;
 		std::vector<VulkanBufferAllocation> m_VertexBufferSet;
+		std::vector<byte*> m_MappedDataSet;
 	};
 }
@@ -1,5 +1,6 @@
 #include "AABB.h"
 
+#include "Athena/Math/Common.h"
 #include "Athena/Math/Limits.h"
 
 
@@ -20,24 +21,23 @@ namespace Athena
 
 	AABB AABB::Transform(const Matrix4& transform) const
 	{
-		std::array<Vector3, 8> corners;
+		// Transform center and project extents onto new axes,
+		// gives the same box as transforming all 8 corners
+		Vector3 center = GetCenter();
+		Vector3 extents = GetExtents();
 
-		corners[0] = m_MinPoint;
-		corners[1] = Vector3(m_MinPoint.x, m_MinPoint.y, m_MaxPoint.z);
-		corners[2] = Vector3(m_MinPoint.x, m_MaxPoint.y, m_MinPoint.z);
-		corners[3] = Vector3(m_MaxPoint.x, m_MinPoint.y, m_MinPoint.z);
-		corners[4] = Vector3(m_MinPoint.x, m_MaxPoint.y, m_MaxPoint.z);
-		corners[5] = Vector3(m_MaxPoint.x, m_MinPoint.y, m_MaxPoint.z);
-		corners[6] = Vector3(m_MaxPoint.x, m_MaxPoint.y, m_MinPoint.z);
-		corners[7] = m_MaxPoint;
-
-		AABB result;
-		for (uint32 i = 0; i < corners.size(); ++i)
+		Vector3 newCenter;
+		Vector3 newExtents;
+		for (uint32 j = 0; j < 3; ++j)
 		{
-			Vector3 transformed = corners[i] * transform;
-			result.Extend(transformed);
+			newCenter[j] = center.x * transform[0][j] + center.y * transform[1][j] + center.z * transform[2][j] + transform[3][j];
+			newExtents[j] = extents.x * Math::Abs(transform[0][j]) + extents.y * Math::Abs(transform[1][j]) + extents.z * Math::Abs(transform[2][j]);
 		}
 
+		AABB result;
+		result.m_MinPoint = newCenter - newExtents;
+		result.m_MaxPoint = newCenter + newExtents;
+
 		return result;
 	}
 
@@ -25,6 +25,9 @@ namespace Athena
 		const Vector3& GetMinPoint() const { return m_MinPoint; }
 		const Vector3& GetMaxPoint() const { return m_MaxPoint; }
 
+		Vector3 GetCenter() const { return (m_MaxPoint + m_MinPoint) * 0.5f; }
+		Vector3 GetExtents() const { return (m_MaxPoint - m_MinPoint) * 0.5f; }
+
 	private:
 		Vector3 m_MaxPoint;
 		Vector3 m_MinPoint;
@@ -159,6 +159,19 @@ namespace Athena
 		return result;
 	}
 
+	Ref<Animator> Animator::Copy(const Ref<Animator>& other)
+	{
+		Ref<Animator> result = Ref<Animator>::Create();
+
+		result->m_Skeleton = other->m_Skeleton;
+		result->m_Animations = other->m_Animations;
+		result->m_CurrentAnimation = other->m_CurrentAnimation;
+		result->m_CurrentTime = other->m_CurrentTime;
+		result->m_BoneTransforms = other->m_BoneTransforms;
+
+		return result;
+	}
+
 	void Animator::OnUpdate(Time frameTime)
 	{
 		if (IsPlaying())
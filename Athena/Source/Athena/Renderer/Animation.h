@@ -106,6 +106,8 @@ namespace Athena
 	{
 	public:
 		static Ref<Animator> Create(const std::vector<Ref<Animation>>& animations, const Ref<Skeleton>& skeleton);
+		// Shares animations and skeleton, copies playback state
+		static Ref<Animator> Copy(const Ref<Animator>& other);
 
 		const std::vector<Matrix4>& GetBoneTransforms() const { return m_BoneTransforms; }
 
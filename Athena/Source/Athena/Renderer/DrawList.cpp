@@ -7,29 +7,99 @@
 
 namespace Athena
 {
+	uint64 DrawSortEntry::MakeKey(uint32 materialID, uint32 meshID, uint32 depthBucket)
+	{
+		uint64 key = 0;
+		key |= uint64(materialID & 0xFFFFFF) << 40;
+		key |= uint64(meshID & 0xFFFFFF) << 16;
+		key |= uint64(depthBucket & 0xFFFF);
+
+		return key;
+	}
+
+	static uint64 MakeSortKey(uint32 materialID, uint32 meshID, const Matrix4& transform, const Vector3& cameraPosition)
+	{
+		// Bits of positive float are ordered same as its value,
+		// so upper 16 bits of squared distance give front to back buckets
+		Vector3 position = transform[3];
+		float distance = (position - cameraPosition).SqrLength();
+
+		uint32 distanceBits;
+		memcpy(&distanceBits, &distance, sizeof(float));
+
+		return DrawSortEntry::MakeKey(materialID, meshID, distanceBits >> 16);
+	}
+
+	// Passes where all keys have the same byte are skipped
+	void DrawSortEntry::RadixSort(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& buffer)
+	{
+		const uint32 count = entries.size();
+		if (count <= 1)
+			return;
+
+		constexpr uint32 passes = sizeof(uint64);
+		uint32 histograms[passes][256] = {};
+
+		for (const auto& entry : entries)
+		{
+			for (uint32 pass = 0; pass < passes; ++pass)
+				histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+		}
+
+		buffer.resize(count);
+
+		DrawSortEntry* src = entries.data();
+		DrawSortEntry* dst = buffer.data();
+
+		for (uint32 pass = 0; pass < passes; ++pass)
+		{
+			const uint32 shift = pass * 8;
+			uint32* histogram = histograms[pass];
+
+			if (histogram[(src[0].Key >> shift) & 0xFF] == count)
+				continue;
+
+			uint32 offset = 0;
+			for (uint32 i = 0; i < 256; ++i)
+			{
+				uint32 bucketSize = histogram[i];
+				histogram[i] = offset;
+				offset += bucketSize;
+			}
+
+			for (uint32 i = 0; i < count; ++i)
+				dst[histogram[(src[i].Key >> shift) & 0xFF]++] = src[i];
+
+			std::swap(src, dst);
+		}
+
+		if (src != entries.data())
+			entries.swap(buffer);
+	}
+
+
 	void DrawListStatic::Push(const StaticDrawCall& drawCall)
 	{
+		m_SortEntries.push_back({ 0, (uint32)m_Array.size() });
 		m_Array.push_back(drawCall);
 	}
 
 	void DrawListStatic::Clear()
 	{
 		m_Array.clear();
+		m_SortEntries.clear();
 	}
 
-	void DrawListStatic::Sort()
+	void DrawListStatic::Sort(const Vector3& cameraPosition)
 	{
 		// Sort by material and vertex buffer(for instancing)
-		std::sort(m_Array.begin(), m_Array.end(), [](const StaticDrawCall& left, const StaticDrawCall& right)
+		for (auto& entry : m_SortEntries)
 		{
-			const auto& leftName = left.Material->GetName();
-			const auto& rightName = right.Material->GetName();
-
-			if (leftName == rightName)
-				return left.VertexBuffer.Raw() < right.VertexBuffer.Raw();
+			const StaticDrawCall& drawCall = m_Array[entry.Index];
+			entry.Key = MakeSortKey(drawCall.Material->GetID(), drawCall.VertexBuffer->GetID(), drawCall.Transform, cameraPosition);
+		}
 
-			return leftName < rightName;
-		});
+		DrawSortEntry::RadixSort(m_SortEntries, m_SortBuffer);
 	}
 
 	void DrawListStatic::Flush(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline)
@@ -38,16 +108,18 @@ namespace Athena
 		Ref<Material> instanceMaterial;
 		if (!m_Array.empty())
 		{
-			instanceVertexBuffer = m_Array[0].VertexBuffer;
-			instanceMaterial = m_Array[0].Material;
+			instanceVertexBuffer = m_Array[m_SortEntries[0].Index].VertexBuffer;
+			instanceMaterial = m_Array[m_SortEntries[0].Index].Material;
 			instanceMaterial->Bind(commandBuffer);
 		}
 
 		uint32 instanceOffset = m_InstanceOffset;
 		uint32 instanceCount = 0;
 
-		for (const auto& drawCall : m_Array)
+		for (const auto& entry : m_SortEntries)
 		{
+			const StaticDrawCall& drawCall = m_Array[entry.Index];
+
 			// Flush instances if material changed or vertex buffer
 			if (drawCall.Material != instanceMaterial)
 			{
@@ -77,30 +149,61 @@ namespace Athena
 			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, instanceMaterial, instanceCount, instanceOffset);
 	}
 
-	void DrawListStatic::FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, bool shadowPass)
+	void DrawListStatic::FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline)
 	{
 		Ref<VertexBuffer> instanceVertexBuffer;
 		uint32 instanceOffset = m_InstanceOffset;
 		uint32 instanceCount = 0;
 
-		for (const auto& drawCall : m_Array)
+		for (const auto& entry : m_SortEntries)
 		{
+			const StaticDrawCall& drawCall = m_Array[entry.Index];
+
 			if (instanceCount == 0)
 				instanceVertexBuffer = drawCall.VertexBuffer;
 
-			if (shadowPass && !drawCall.Material->GetFlag(MaterialFlag::CAST_SHADOWS))
+			if (drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
+				instanceOffset += instanceCount;
+				instanceCount = 1;
+
+				instanceVertexBuffer = drawCall.VertexBuffer;
+			}
+			else
+			{
+				instanceCount++;
+			}
+		}
+
+		if (instanceCount != 0)
+			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
+	}
+
+	void DrawListStatic::FlushShadows(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, const Ref<Material>& shadowMaterial)
+	{
+		Ref<VertexBuffer> instanceVertexBuffer;
+		uint32 instanceOffset = m_InstanceOffset;
+		uint32 instanceCount = 0;
+
+		for (const auto& entry : m_SortEntries)
+		{
+			const StaticDrawCall& drawCall = m_Array[entry.Index];
+
+			if (instanceCount == 0)
+				instanceVertexBuffer = drawCall.VertexBuffer;
+
+			if (!drawCall.Material->GetFlag(MaterialFlag::CAST_SHADOWS))
 			{
 				if(instanceCount != 0)
-					Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
+					Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
 
 				instanceOffset += instanceCount + 1;
 				instanceCount = 0;
-
-				instanceVertexBuffer = drawCall.VertexBuffer;
 			}
 			else if (drawCall.VertexBuffer != instanceVertexBuffer)
 			{
-				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
 				instanceOffset += instanceCount;
 				instanceCount = 1;
 
@@ -112,19 +215,18 @@ namespace Athena
 			}
 		}
 
-		if (!m_Array.empty())
-		{
-			if((*(m_Array.end() - 1)).Material->GetFlag(MaterialFlag::CAST_SHADOWS))
-				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
-		}
+		if (instanceCount != 0)
+			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
 	}
 
 	void DrawListStatic::EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data)
 	{
-		data.reserve(m_Array.size());
+		data.reserve(data.size() + m_Array.size());
 
-		for (const auto& draw : m_Array)
+		for (const auto& entry : m_SortEntries)
 		{
+			const StaticDrawCall& draw = m_Array[entry.Index];
+
 			InstanceTransformData transformData;
 			transformData.TRow0 = draw.Transform[0];
 			transformData.TRow1 = draw.Transform[1];
@@ -137,20 +239,26 @@ namespace Athena
 
 	uint32 DrawListStatic::GetInstancesCount() const
 	{
-		uint32 instances = 1;
+		uint32 instances = m_Array.empty() ? 0 : 1;
 
 		Ref<VertexBuffer> instanceVertexBuffer;
 		Ref<Material> instanceMaterial;
 		if (!m_Array.empty())
 		{
-			instanceVertexBuffer = m_Array[0].VertexBuffer;
-			instanceMaterial = m_Array[0].Material;
+			instanceVertexBuffer = m_Array[m_SortEntries[0].Index].VertexBuffer;
+			instanceMaterial = m_Array[m_SortEntries[0].Index].Material;
 		}
 
-		for (const auto& drawCall : m_Array)
+		for (const auto& entry : m_SortEntries)
 		{
+			const StaticDrawCall& drawCall = m_Array[entry.Index];
+
 			if (drawCall.Material != instanceMaterial || drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				instanceMaterial = drawCall.Material;
+				instanceVertexBuffer = drawCall.VertexBuffer;
 				instances++;
+			}
 		}
 
 		return instances;
@@ -159,66 +267,157 @@ namespace Athena
 
 	void DrawListAnim::Push(const AnimDrawCall& drawCall)
 	{
+		m_SortEntries.push_back({ 0, (uint32)m_Array.size() });
 		m_Array.push_back(drawCall);
 	}
 
 	void DrawListAnim::Clear()
 	{
 		m_Array.clear();
+		m_SortEntries.clear();
 	}
 
-	void DrawListAnim::Sort()
+	void DrawListAnim::Sort(const Vector3& cameraPosition)
 	{
 		// Sort by material
-		std::sort(m_Array.begin(), m_Array.end(), [](const AnimDrawCall& left, const AnimDrawCall& right)
+		for (auto& entry : m_SortEntries)
 		{
-			return left.Material->GetName() < right.Material->GetName();
-		});
+			const AnimDrawCall& drawCall = m_Array[entry.Index];
+			entry.Key = MakeSortKey(drawCall.Material->GetID(), drawCall.VertexBuffer->GetID(), drawCall.Transform, cameraPosition);
+		}
+
+		DrawSortEntry::RadixSort(m_SortEntries, m_SortBuffer);
 	}
 
 	void DrawListAnim::Flush(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline)
 	{
-		uint32 instanceOffset = m_InstanceOffset;
-
+		Ref<VertexBuffer> instanceVertexBuffer;
 		Ref<Material> instanceMaterial;
+		if (!m_Array.empty())
+		{
+			instanceVertexBuffer = m_Array[m_SortEntries[0].Index].VertexBuffer;
+			instanceMaterial = m_Array[m_SortEntries[0].Index].Material;
+			instanceMaterial->Bind(commandBuffer);
+		}
+
+		uint32 instanceOffset = m_InstanceOffset;
+		uint32 instanceCount = 0;
 
-		for (const auto& drawCall : m_Array)
+		// Bones offsets are fetched per instance, so submeshes of different animators can be instanced
+		for (const auto& entry : m_SortEntries)
 		{
+			const AnimDrawCall& drawCall = m_Array[entry.Index];
+
 			if (drawCall.Material != instanceMaterial)
 			{
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, instanceMaterial, instanceCount, instanceOffset);
+				instanceOffset += instanceCount;
+
+				instanceCount = 1;
+				instanceVertexBuffer = drawCall.VertexBuffer;
 				instanceMaterial = drawCall.Material;
 				instanceMaterial->Bind(commandBuffer);
 			}
+			else if (drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, drawCall.Material, instanceCount, instanceOffset);
+				instanceOffset += instanceCount;
+
+				instanceCount = 1;
+				instanceVertexBuffer = drawCall.VertexBuffer;
+			}
+			else
+			{
+				instanceCount++;
+			}
+		}
+
+		if (!m_Array.empty())
+			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, instanceMaterial, instanceCount, instanceOffset);
+	}
+
+	void DrawListAnim::FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline)
+	{
+		Ref<VertexBuffer> instanceVertexBuffer;
+		uint32 instanceOffset = m_InstanceOffset;
+		uint32 instanceCount = 0;
 
-			instanceMaterial->Set("u_BonesOffset", drawCall.BonesOffset);
-			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, drawCall.VertexBuffer, instanceMaterial, 1, instanceOffset);
+		for (const auto& entry : m_SortEntries)
+		{
+			const AnimDrawCall& drawCall = m_Array[entry.Index];
+
+			if (instanceCount == 0)
+				instanceVertexBuffer = drawCall.VertexBuffer;
+
+			if (drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
+				instanceOffset += instanceCount;
+				instanceCount = 1;
 
-			instanceOffset++;
+				instanceVertexBuffer = drawCall.VertexBuffer;
+			}
+			else
+			{
+				instanceCount++;
+			}
 		}
+
+		if (instanceCount != 0)
+			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, nullptr, instanceCount, instanceOffset);
 	}
 
-	void DrawListAnim::FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, bool shadowPass)
+	void DrawListAnim::FlushShadows(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, const Ref<Material>& shadowMaterial)
 	{
+		Ref<VertexBuffer> instanceVertexBuffer;
 		uint32 instanceOffset = m_InstanceOffset;
+		uint32 instanceCount = 0;
 
-		for (const auto& drawCall : m_Array)
+		for (const auto& entry : m_SortEntries)
 		{
-			if (shadowPass && !drawCall.Material->GetFlag(MaterialFlag::CAST_SHADOWS))
-				continue;
+			const AnimDrawCall& drawCall = m_Array[entry.Index];
 
-			drawCall.Material->Set("u_BonesOffset", drawCall.BonesOffset);
-			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, drawCall.VertexBuffer, drawCall.Material, 1, instanceOffset);
-			
-			instanceOffset++;
+			if (instanceCount == 0)
+				instanceVertexBuffer = drawCall.VertexBuffer;
+
+			if (!drawCall.Material->GetFlag(MaterialFlag::CAST_SHADOWS))
+			{
+				if (instanceCount != 0)
+					Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
+
+				instanceOffset += instanceCount + 1;
+				instanceCount = 0;
+			}
+			else if (drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
+				instanceOffset += instanceCount;
+				instanceCount = 1;
+
+				instanceVertexBuffer = drawCall.VertexBuffer;
+			}
+			else
+			{
+				instanceCount++;
+			}
 		}
+
+		if (instanceCount != 0)
+			Renderer::RenderGeometryInstanced(commandBuffer, pipeline, instanceVertexBuffer, shadowMaterial, instanceCount, instanceOffset);
 	}
 
-	void DrawListAnim::EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data)
+	void DrawListAnim::EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data, std::vector<uint32>& bonesOffsets)
 	{
-		data.reserve(m_Array.size());
+		data.reserve(data.size() + m_Array.size());
 
-		for (const auto& draw : m_Array)
+		// Bones offsets are indexed by instance, entries of other lists are left zero
+		bonesOffsets.resize(data.size(), 0);
+		bonesOffsets.reserve(data.size() + m_Array.size());
+
+		for (const auto& entry : m_SortEntries)
 		{
+			const AnimDrawCall& draw = m_Array[entry.Index];
+
 			InstanceTransformData transformData;
 			transformData.TRow0 = draw.Transform[0];
 			transformData.TRow1 = draw.Transform[1];
@@ -226,6 +425,34 @@ namespace Athena
 			transformData.TRow3 = draw.Transform[3];
 
 			data.push_back(transformData);
+			bonesOffsets.push_back(draw.BonesOffset);
 		}
 	}
+
+	uint32 DrawListAnim::GetInstancesCount() const
+	{
+		uint32 instances = m_Array.empty() ? 0 : 1;
+
+		Ref<VertexBuffer> instanceVertexBuffer;
+		Ref<Material> instanceMaterial;
+		if (!m_Array.empty())
+		{
+			instanceVertexBuffer = m_Array[m_SortEntries[0].Index].VertexBuffer;
+			instanceMaterial = m_Array[m_SortEntries[0].Index].Material;
+		}
+
+		for (const auto& entry : m_SortEntries)
+		{
+			const AnimDrawCall& drawCall = m_Array[entry.Index];
+
+			if (drawCall.Material != instanceMaterial || drawCall.VertexBuffer != instanceVertexBuffer)
+			{
+				instanceMaterial = drawCall.Material;
+				instanceVertexBuffer = drawCall.VertexBuffer;
+				instances++;
+			}
+		}
+
+		return instances;
+	}
 }
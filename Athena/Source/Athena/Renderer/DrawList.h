@@ -20,6 +20,18 @@ namespace Athena
 		Vector3 TRow3;
 	};
 
+	// Draw calls are sorted by 64-bit key: [63..40] material ID | [39..16] mesh ID | [15..0] depth bucket.
+	// Each draw list is flushed with a single pipeline, so key has no pipeline bits.
+	struct ATHENA_API DrawSortEntry
+	{
+		uint64 Key;
+		uint32 Index;
+
+		static uint64 MakeKey(uint32 materialID, uint32 meshID, uint32 depthBucket);
+		// LSD radix sort, 'buffer' is used as temporary storage
+		static void RadixSort(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& buffer);
+	};
+
 	struct StaticDrawCall
 	{
 		Ref<VertexBuffer> VertexBuffer;
@@ -31,10 +43,13 @@ namespace Athena
 	{
 	public:
 		void Push(const StaticDrawCall& drawCall);
-		void Sort();
+		// Sorts keys only, draw calls stay in submission order
+		void Sort(const Vector3& cameraPosition);
 
 		void Flush(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline);
-		void FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, bool shadowPass = false);
+		void FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline);
+		// Skips materials that do not cast shadows, push constants are taken from 'shadowMaterial'
+		void FlushShadows(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, const Ref<Material>& shadowMaterial);
 
 		void SetInstanceOffset(uint32 offset) { m_InstanceOffset = offset; }
 		void EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data);
@@ -46,6 +61,8 @@ namespace Athena
 
 	private:
 		std::vector<StaticDrawCall> m_Array;
+		std::vector<DrawSortEntry> m_SortEntries;
+		std::vector<DrawSortEntry> m_SortBuffer;
 		uint32 m_InstanceOffset = 0;
 	};
 
@@ -54,6 +71,7 @@ namespace Athena
 		Ref<VertexBuffer> VertexBuffer;
 		Ref<Material> Material;
 		Matrix4 Transform;
+		// Offset of animator bones in bones buffer, shared by all submeshes of mesh
 		uint32 BonesOffset = 0;
 	};
 
@@ -61,21 +79,26 @@ namespace Athena
 	{
 	public:
 		void Push(const AnimDrawCall& drawCall);
-		void Sort();
+		// Sorts keys only, draw calls stay in submission order
+		void Sort(const Vector3& cameraPosition);
 
 		void Flush(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline);
-		void FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, bool shadowPass = false);
+		void FlushNoMaterials(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline);
+		// Skips materials that do not cast shadows, push constants are taken from 'shadowMaterial'
+		void FlushShadows(const Ref<RenderCommandBuffer> commandBuffer, const Ref<Pipeline>& pipeline, const Ref<Material>& shadowMaterial);
 
 		void SetInstanceOffset(uint32 offset) { m_InstanceOffset = offset; }
-		void EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data);
+		void EmplaceInstanceTransforms(std::vector<InstanceTransformData>& data, std::vector<uint32>& bonesOffsets);
+
+		uint32 GetInstancesCount() const;
 
 		uint64 Size() const { return m_Array.size(); }
 		void Clear();
 
-		const auto& GetArray() const { return m_Array; }
-
 	private:
 		std::vector<AnimDrawCall> m_Array;
+		std::vector<DrawSortEntry> m_SortEntries;
+		std::vector<DrawSortEntry> m_SortBuffer;
 		uint32 m_InstanceOffset = 0;
 	};
 }
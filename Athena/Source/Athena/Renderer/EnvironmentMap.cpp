@@ -1,14 +1,47 @@
 #include "EnvironmentMap.h"
+#include "Athena/Core/Application.h"
 #include "Athena/Core/FileSystem.h"
+#include "Athena/Asset/AssetLoader.h"
+#include "Athena/Asset/TextureCache.h"
 #include "Athena/Asset/TextureImporter.h"
 #include "Athena/Renderer/ComputePass.h"
 #include "Athena/Renderer/ComputePipeline.h"
 #include "Athena/Renderer/Renderer.h"
 #include "Athena/Renderer/TextureGenerator.h"
+#include "Athena/Utils/HashUtils.h"
+
+#include <atomic>
 
 
 namespace Athena
 {
+	// Increment when layout of cache or bake shaders change
+	static constexpr uint32 EnvironmentCacheVersion = 1;
+	static constexpr uint32 EnvironmentCacheMagic = 0x564E5441;	// 'ATNV'
+
+	struct EnvironmentCacheHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint64 Key;
+		TextureFormat Format;
+		uint32 Resolution;
+		uint32 MipLevels;
+		uint32 IrradianceResolution;
+		// Environment mips are followed by irradiance map, each mip contains all faces
+		uint64 EnvironmentDataSize;
+		uint64 IrradianceDataSize;
+	};
+
+	static FilePath GetEnvironmentCachePath(uint64 key)
+	{
+		FilePath cacheFolder = Application::Get().GetConfig().EngineResourcesPath / "Cache/Environment";
+		return cacheFolder / std::format("{}.aenv", Utils::HashToString(key));
+	}
+
+	static std::atomic<uint32> s_EnvironmentCacheTempCounter = 0;
+
+
 	Ref<EnvironmentMap> EnvironmentMap::Create(uint32 resolution)
 	{
 		Ref<EnvironmentMap> result = Ref<EnvironmentMap>::Create(resolution);
@@ -16,12 +49,52 @@ namespace Athena
 		return result;
 	}
 
+	Ref<EnvironmentMap> EnvironmentMap::Copy(const Ref<EnvironmentMap>& other)
+	{
+		Ref<EnvironmentMap> result(new EnvironmentMap());
+		result->m_Type = other->m_Type;
+		result->m_IrradianceMode = other->m_IrradianceMode;
+		result->m_Resolution = other->m_Resolution;
+		result->m_Turbidity = other->m_Turbidity;
+		result->m_Azimuth = other->m_Azimuth;
+		result->m_Inclination = other->m_Inclination;
+		result->m_FilePath = other->m_FilePath;
+
+		// Nothing is baked yet, copy bakes into own textures
+		if (other->m_Dirty)
+		{
+			result->CreateResources();
+			result->m_Dirty = true;
+			return result;
+		}
+
+		result->m_EnvironmentTexture = other->m_EnvironmentTexture;
+		result->m_IrradianceTexture = other->m_IrradianceTexture;
+		result->m_IrradianceSH = other->m_IrradianceSH;
+		result->m_BakedKey = other->m_BakedKey;
+		result->m_Dirty = false;
+
+		result->m_SharedTextures = true;
+		other->m_SharedTextures = true;
+
+		return result;
+	}
+
 	EnvironmentMap::EnvironmentMap(uint32 resolution)
 	{
 		m_Dirty = true;
 		m_Type = EnvironmentMapType::PREETHAM;
 		m_Resolution = resolution;
 
+		CreateResources();
+	}
+
+	void EnvironmentMap::CreateResources()
+	{
+		m_SharedTextures = false;
+
+		uint32 irradianceResolution = m_IrradianceMode == EnvironmentIrradianceMode::CUBEMAP ? m_IrradianceMapResolution : 1;
+
 		TextureCreateInfo cubemapInfo;
 		cubemapInfo.Name = "EnvironmentMap";
 		cubemapInfo.Format = TextureFormat::R11G11B10F;
@@ -35,8 +108,8 @@ namespace Athena
 		m_EnvironmentTexture = TextureCube::Create(cubemapInfo);
 
 		cubemapInfo.Name = "EnvIrradianceMap";
-		cubemapInfo.Width = m_IrradianceMapResolution;
-		cubemapInfo.Height = m_IrradianceMapResolution;
+		cubemapInfo.Width = irradianceResolution;
+		cubemapInfo.Height = irradianceResolution;
 		cubemapInfo.GenerateMipMap = false;
 
 		m_IrradianceTexture = TextureCube::Create(cubemapInfo);
@@ -90,6 +163,24 @@ namespace Athena
 			m_IrradiancePipeline->Bake();
 		}
 
+		// Irradiance SH Pipeline
+		{
+			m_IrradianceSH = StorageBuffer::Create("EnvIrradianceSH", sizeof(IrradianceSH), BufferMemoryFlags::GPU_ONLY);
+
+			ComputePassCreateInfo passInfo;
+			passInfo.Name = "IrradianceSHPass";
+			passInfo.DebugColor = { 0.6f, 0.4f, 0.2f, 1.f };
+
+			m_IrradianceSHPass = ComputePass::Create(passInfo);
+			m_IrradianceSHPass->SetOutput(m_IrradianceSH);
+			m_IrradianceSHPass->Bake();
+
+			m_IrradianceSHPipeline = ComputePipeline::Create(Renderer::GetShaderPack()->Get("EnvironmentIrradianceSH"));
+			m_IrradianceSHPipeline->SetInput("u_EnvironmentMap", m_EnvironmentTexture);
+			m_IrradianceSHPipeline->SetInput("u_IrradianceSHData", m_IrradianceSH);
+			m_IrradianceSHPipeline->Bake();
+		}
+
 		// Mip Filter Pipeline
 		{
 			ComputePassCreateInfo passInfo;
@@ -129,8 +220,33 @@ namespace Athena
 			return;
 
 		m_Resolution = resolution;
-		m_EnvironmentTexture->Resize(resolution, resolution);
+
+		if (m_SharedTextures)
+			CreateResources();
+		else
+			m_EnvironmentTexture->Resize(resolution, resolution);
+
+		m_Dirty = true;
+		m_BakedKey = 0;
+	}
+
+	void EnvironmentMap::SetIrradianceMode(EnvironmentIrradianceMode mode)
+	{
+		if (m_IrradianceMode == mode)
+			return;
+
+		m_IrradianceMode = mode;
+
+		// Irradiance cubemap is not used with SH, keep only placeholder face to free memory
+		uint32 irradianceResolution = mode == EnvironmentIrradianceMode::CUBEMAP ? m_IrradianceMapResolution : 1;
+
+		if (m_SharedTextures)
+			CreateResources();
+		else
+			m_IrradianceTexture->Resize(irradianceResolution, irradianceResolution);
+
 		m_Dirty = true;
+		m_BakedKey = 0;
 	}
 
 	void EnvironmentMap::SetFilePath(const FilePath& path)
@@ -175,6 +291,14 @@ namespace Athena
 		return m_IrradianceTexture;
 	}
 
+	Ref<StorageBuffer> EnvironmentMap::GetIrradianceSH()
+	{
+		if (!IsEmpty() && m_Dirty)
+			Load();
+
+		return m_IrradianceSH;
+	}
+
 	void EnvironmentMap::LoadFromFile(const Ref<RenderCommandBuffer>& commandBuffer)
 	{
 		Ref<Texture2D> panorama = TextureImporter::Load(m_FilePath, TextureImportOptions());
@@ -203,8 +327,37 @@ namespace Athena
 		m_PreethamPass->End(commandBuffer);
 	}
 
+	void EnvironmentMap::ComputeIrradianceSH(const Ref<RenderCommandBuffer>& commandBuffer)
+	{
+		// Whole cubemap is reduced by one work group
+		m_IrradianceSHPass->Begin(commandBuffer);
+		{
+			m_IrradianceSHPipeline->Bind(commandBuffer);
+			Renderer::Dispatch(commandBuffer, m_IrradianceSHPipeline, { 1, 1, 1 });
+		}
+		m_IrradianceSHPass->End(commandBuffer);
+	}
+
 	void EnvironmentMap::Load()
 	{
+		ATN_PROFILE_FUNC();
+
+		// Baked textures may be used by copy of this map, they are never overwritten
+		if (m_SharedTextures)
+			CreateResources();
+
+		uint64 cacheKey = GetCacheKey();
+		if (LoadFromCache(cacheKey))
+		{
+			// Projection takes few microseconds, so coefficients are not stored in cache
+			if (m_IrradianceMode == EnvironmentIrradianceMode::SPHERICAL_HARMONICS)
+				ComputeIrradianceSH(Renderer::GetRenderCommandBuffer());
+
+			m_BakedKey = cacheKey;
+			m_Dirty = false;
+			return;
+		}
+
 		Ref<RenderCommandBuffer> commandBuffer = Renderer::GetRenderCommandBuffer();
 
 		if (m_Type == EnvironmentMapType::STATIC)
@@ -219,12 +372,19 @@ namespace Athena
 		Renderer::EndDebugRegion(commandBuffer);
 
 
-		m_IrradiancePass->Begin(commandBuffer);
+		if (m_IrradianceMode == EnvironmentIrradianceMode::SPHERICAL_HARMONICS)
 		{
-			m_IrradiancePipeline->Bind(commandBuffer);
-			Renderer::Dispatch(commandBuffer, m_IrradiancePipeline, { m_IrradianceMapResolution, m_IrradianceMapResolution, 6 });
+			ComputeIrradianceSH(commandBuffer);
+		}
+		else
+		{
+			m_IrradiancePass->Begin(commandBuffer);
+			{
+				m_IrradiancePipeline->Bind(commandBuffer);
+				Renderer::Dispatch(commandBuffer, m_IrradiancePipeline, { m_IrradianceMapResolution, m_IrradianceMapResolution, 6 });
+			}
+			m_IrradiancePass->End(commandBuffer);
 		}
-		m_IrradiancePass->End(commandBuffer);
 
 
 		m_MipFilterPass->Begin(commandBuffer);
@@ -241,7 +401,145 @@ namespace Athena
 		}
 		m_MipFilterPass->End(commandBuffer);
 
+		m_BakedKey = cacheKey;
 		m_Dirty = false;
+
+		WriteCacheDeferred(cacheKey);
+	}
+
+	uint64 EnvironmentMap::GetCacheKey()
+	{
+		uint64 hash = Utils::FNV1aOffsetBasis;
+
+		if (m_Type == EnvironmentMapType::STATIC)
+		{
+			// Same source identity as for imported panorama, path and last write time
+			hash = TextureCache::GetKey(m_FilePath, TextureImportOptions());
+		}
+		else if (m_Type == EnvironmentMapType::PREETHAM)
+		{
+			hash = Utils::HashFNV1a(&m_Turbidity, sizeof(m_Turbidity), hash);
+			hash = Utils::HashFNV1a(&m_Azimuth, sizeof(m_Azimuth), hash);
+			hash = Utils::HashFNV1a(&m_Inclination, sizeof(m_Inclination), hash);
+		}
+
+		uint32 mipFilterLevels = ShaderDef::MAX_SKYBOX_MAP_LOD;
+		TextureFormat format = m_EnvironmentTexture->GetFormat();
+
+		hash = Utils::HashFNV1a(&m_Type, sizeof(m_Type), hash);
+		hash = Utils::HashFNV1a(&m_IrradianceMode, sizeof(m_IrradianceMode), hash);
+		hash = Utils::HashFNV1a(&m_Resolution, sizeof(m_Resolution), hash);
+		hash = Utils::HashFNV1a(&m_IrradianceMapResolution, sizeof(m_IrradianceMapResolution), hash);
+		hash = Utils::HashFNV1a(&mipFilterLevels, sizeof(mipFilterLevels), hash);
+		hash = Utils::HashFNV1a(&format, sizeof(format), hash);
+		hash = Utils::HashFNV1a(&EnvironmentCacheVersion, sizeof(EnvironmentCacheVersion), hash);
+
+		return hash;
+	}
+
+	uint32 EnvironmentMap::GetCachedIrradianceResolution() const
+	{
+		// SH is computed from environment texture, no irradiance data is stored
+		return m_IrradianceMode == EnvironmentIrradianceMode::CUBEMAP ? m_IrradianceMapResolution : 0;
+	}
+
+	bool EnvironmentMap::LoadFromCache(uint64 key)
+	{
+		ATN_PROFILE_FUNC();
+
+		FilePath cachePath = GetEnvironmentCachePath(key);
+
+		Ref<MappedFile> file = MappedFile::Create(cachePath);
+		if (!file || file->Size() < sizeof(EnvironmentCacheHeader))
+			return false;
+
+		EnvironmentCacheHeader header;
+		memcpy(&header, file->Data(), sizeof(header));
+
+		if (header.Magic != EnvironmentCacheMagic || header.Version != EnvironmentCacheVersion || header.Key != key)
+			return false;
+
+		if (header.Format != m_EnvironmentTexture->GetFormat() || header.Resolution != m_Resolution ||
+			header.MipLevels != m_EnvironmentTexture->GetMipLevelsCount() || header.IrradianceResolution != GetCachedIrradianceResolution())
+			return false;
+
+		if (file->Size() - sizeof(header) < header.EnvironmentDataSize + header.IrradianceDataSize)
+			return false;
+
+		// Data is copied into staging memory, file can be unmapped after upload
+		const byte* data = file->Data() + sizeof(header);
+		m_EnvironmentTexture->UploadMips(data, header.EnvironmentDataSize, 0, header.MipLevels);
+		if (header.IrradianceResolution != 0)
+			m_IrradianceTexture->UploadMips(data + header.EnvironmentDataSize, header.IrradianceDataSize, 0, 1);
+
+		ATN_CORE_TRACE_TAG("EnvironmentMap", "Load environment map from cache '{}'", cachePath);
+		return true;
+	}
+
+	void EnvironmentMap::WriteCacheDeferred(uint64 key)
+	{
+		Renderer::Defer([environmentMap = Ref<EnvironmentMap>(this), key]()
+		{
+			// Parameters were changed and map was baked again, e.g. while Preetham sky is edited
+			if (environmentMap->m_BakedKey != key)
+				return;
+
+			environmentMap->WriteCache(key);
+		});
+	}
+
+	void EnvironmentMap::WriteCache(uint64 key)
+	{
+		ATN_PROFILE_FUNC();
+
+		EnvironmentCacheHeader header;
+		header.Magic = EnvironmentCacheMagic;
+		header.Version = EnvironmentCacheVersion;
+		header.Key = key;
+		header.Format = m_EnvironmentTexture->GetFormat();
+		header.Resolution = m_Resolution;
+		header.MipLevels = m_EnvironmentTexture->GetMipLevelsCount();
+		header.IrradianceResolution = GetCachedIrradianceResolution();
+
+		Buffer environmentData;
+		m_EnvironmentTexture->WriteContentToBuffer(&environmentData, 0, header.MipLevels);
+
+		Buffer irradianceData;
+		if (header.IrradianceResolution != 0)
+			m_IrradianceTexture->WriteContentToBuffer(&irradianceData, 0, 1);
+
+		header.EnvironmentDataSize = environmentData.Size();
+		header.IrradianceDataSize = irradianceData.Size();
+
+		FilePath cachePath = GetEnvironmentCachePath(key);
+
+		// Readback has to be done on main thread, file is written on loader thread
+		AssetLoader::Submit([cachePath, header, environmentData, irradianceData]() mutable
+		{
+			std::vector<byte> buffer(sizeof(header) + environmentData.Size() + irradianceData.Size());
+			memcpy(buffer.data(), &header, sizeof(header));
+			memcpy(buffer.data() + sizeof(header), environmentData.Data(), environmentData.Size());
+			if (irradianceData.Size() > 0)
+				memcpy(buffer.data() + sizeof(header) + environmentData.Size(), irradianceData.Data(), irradianceData.Size());
+
+			environmentData.Release();
+			irradianceData.Release();
+
+			// Other threads may have cache file mapped, so it is replaced instead of rewritten in place
+			FilePath tempPath = cachePath;
+			tempPath += std::format(".{}.tmp", s_EnvironmentCacheTempCounter.fetch_add(1, std::memory_order_relaxed));
+
+			if (!FileSystem::WriteFile(tempPath, (const char*)buffer.data(), buffer.size()))
+			{
+				ATN_CORE_WARN_TAG("EnvironmentMap", "Failed to write environment map cache '{}'", cachePath);
+				return;
+			}
+
+			// Cache with same key has same content, so failure to replace it is not an error
+			if (!FileSystem::Rename(tempPath, cachePath))
+				FileSystem::Remove(tempPath);
+		},
+		[]() {});
 	}
 
 	bool EnvironmentMap::IsEmpty()
@@ -2,6 +2,7 @@
 
 #include "Athena/Core/Core.h"
 #include "Athena/Renderer/Texture.h"
+#include "Athena/Renderer/GPUBuffer.h"
 #include "Athena/Renderer/ComputePass.h"
 #include "Athena/Renderer/ComputePipeline.h"
 #include "Athena/Renderer/Renderer.h"
@@ -15,10 +16,25 @@ namespace Athena
 		PREETHAM,
 	};
 
+	enum class EnvironmentIrradianceMode
+	{
+		CUBEMAP = 1,
+		// L2 spherical harmonics, no irradiance cubemap is baked or sampled
+		SPHERICAL_HARMONICS,
+	};
+
+	// Layout of u_IrradianceSHData, rgb - irradiance coefficients convolved with cosine lobe
+	struct IrradianceSH
+	{
+		Vector4 Coefficients[9];
+	};
+
 	class ATHENA_API EnvironmentMap : public RefCounted
 	{
 	public:
 		static Ref<EnvironmentMap> Create(uint32 resolution);
+		// Settings are copied, baked textures are shared until one of maps is baked again
+		static Ref<EnvironmentMap> Copy(const Ref<EnvironmentMap>& other);
 		EnvironmentMap(uint32 resolution);
 
 		EnvironmentMapType GetType() const { return m_Type; }
@@ -29,29 +45,53 @@ namespace Athena
 
 		Ref<TextureCube> GetEnvironmentTexture();
 		Ref<TextureCube> GetIrradianceTexture();
+		// Valid only in SPHERICAL_HARMONICS mode, written on GPU
+		Ref<StorageBuffer> GetIrradianceSH();
+
+		EnvironmentIrradianceMode GetIrradianceMode() const { return m_IrradianceMode; }
+		void SetIrradianceMode(EnvironmentIrradianceMode mode);
 
 		uint32 GetResolution() const { return m_Resolution; }
 		void SetResolution(uint32 resolution);
 
 		void SetPreethamParams(float turbidity, float azimuth, float inclination);
 
+		// Static map without source file, black textures are returned
+		bool IsEmpty();
+
 		float GetTurbidity() const { return m_Turbidity; }
 		float GetAzimuth() const { return m_Azimuth; }
 		float GetInclination() const { return m_Inclination; }
 
 	private:
+		EnvironmentMap() = default;
+
+		// Creates textures and bake pipelines
+		void CreateResources();
 		void LoadFromFile(const Ref<RenderCommandBuffer>& commandBuffer);
 		void LoadPreetham(const Ref<RenderCommandBuffer>& commandBuffer);
+		void ComputeIrradianceSH(const Ref<RenderCommandBuffer>& commandBuffer);
 		void Load();
 
-		bool IsEmpty();
+		// Key depends on source, resolutions and bake settings
+		uint64 GetCacheKey();
+		bool LoadFromCache(uint64 key);
+		uint32 GetCachedIrradianceResolution() const;
+		// Baked textures are read back after GPU has finished the frame that baked them
+		void WriteCacheDeferred(uint64 key);
+		void WriteCache(uint64 key);
 
 	private:
 		Ref<TextureCube> m_EnvironmentTexture;
 		Ref<TextureCube> m_IrradianceTexture;
 
 		EnvironmentMapType m_Type;
+		EnvironmentIrradianceMode m_IrradianceMode = EnvironmentIrradianceMode::CUBEMAP;
 		bool m_Dirty = true;
+		// Textures are shared with copy, new ones are created before they are changed
+		bool m_SharedTextures = false;
+		// Cache key of parameters that textures were baked or loaded with, 0 if textures are empty
+		uint64 m_BakedKey = 0;
 
 		uint32 m_Resolution = 1024;
 		uint32 m_IrradianceMapResolution = 64;
@@ -72,6 +112,10 @@ namespace Athena
 		Ref<ComputePass> m_IrradiancePass;
 		Ref<ComputePipeline> m_IrradiancePipeline;
 
+		Ref<StorageBuffer> m_IrradianceSH;
+		Ref<ComputePass> m_IrradianceSHPass;
+		Ref<ComputePipeline> m_IrradianceSHPipeline;
+
 		Ref<ComputePass> m_MipFilterPass;
 		Ref<ComputePipeline> m_MipFilterPipeline;
 		std::array<Ref<Material>, ShaderDef::MAX_SKYBOX_MAP_LOD> m_MipFilterMaterials;
@@ -0,0 +1,106 @@
+#include "Frustum.h"
+
+#include "Athena/Math/SIMD/Platform.h"
+
+
+namespace Athena
+{
+	Frustum::Frustum()
+	{
+		for (uint32 i = 0; i < PaddedPlanesCount; ++i)
+		{
+			m_PlanesX[i] = 0.f;
+			m_PlanesY[i] = 0.f;
+			m_PlanesZ[i] = 0.f;
+			m_PlanesW[i] = 1.f;
+		}
+	}
+
+	Frustum::Frustum(const Matrix4& viewProjection)
+		: Frustum()
+	{
+		// Row vectors: clip = v * viewProjection, so planes are built from columns.
+		// Clip space depth is in [0, w] for both regular and reversed Z.
+		const Matrix4& m = viewProjection;
+
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			float* plane[4] = { m_PlanesX, m_PlanesY, m_PlanesZ, m_PlanesW };
+
+			plane[i][0] = m[i][3] + m[i][0];	// Left
+			plane[i][1] = m[i][3] - m[i][0];	// Right
+			plane[i][2] = m[i][3] + m[i][1];	// Bottom
+			plane[i][3] = m[i][3] - m[i][1];	// Top
+			plane[i][4] = m[i][2];				// Near
+			plane[i][5] = m[i][3] - m[i][2];	// Far
+		}
+
+		for (uint32 i = 0; i < PlanesCount; ++i)
+		{
+			float length = Math::Sqrt(m_PlanesX[i] * m_PlanesX[i] + m_PlanesY[i] * m_PlanesY[i] + m_PlanesZ[i] * m_PlanesZ[i]);
+			if (length > 0.f)
+			{
+				m_PlanesX[i] /= length;
+				m_PlanesY[i] /= length;
+				m_PlanesZ[i] /= length;
+				m_PlanesW[i] /= length;
+			}
+		}
+	}
+
+	bool Frustum::IsVisible(const AABB& aabb) const
+	{
+		return IsVisible(aabb.GetCenter(), aabb.GetExtents());
+	}
+
+	bool Frustum::IsVisible(const AABB& aabb, const Matrix4& transform) const
+	{
+		return IsVisible(aabb.Transform(transform));
+	}
+
+	bool Frustum::IsVisible(const Vector3& center, const Vector3& extents) const
+	{
+		// AABB is outside if for any plane: dot(n, c) + w < -dot(|n|, e)
+#ifdef ATN_SSE_2
+		const __m128 cx = _mm_set_ps1(center.x);
+		const __m128 cy = _mm_set_ps1(center.y);
+		const __m128 cz = _mm_set_ps1(center.z);
+		const __m128 ex = _mm_set_ps1(extents.x);
+		const __m128 ey = _mm_set_ps1(extents.y);
+		const __m128 ez = _mm_set_ps1(extents.z);
+		const __m128 signMask = _mm_set_ps1(-0.f);
+
+		for (uint32 i = 0; i < PaddedPlanesCount; i += 4)
+		{
+			__m128 px = _mm_load_ps(&m_PlanesX[i]);
+			__m128 py = _mm_load_ps(&m_PlanesY[i]);
+			__m128 pz = _mm_load_ps(&m_PlanesZ[i]);
+			__m128 pw = _mm_load_ps(&m_PlanesW[i]);
+
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)), _mm_add_ps(_mm_mul_ps(pz, cz), pw));
+
+			__m128 radius = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_andnot_ps(signMask, px), ex),
+				_mm_mul_ps(_mm_andnot_ps(signMask, py), ey)),
+				_mm_mul_ps(_mm_andnot_ps(signMask, pz), ez));
+
+			__m128 outside = _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps());
+			if (_mm_movemask_ps(outside) != 0)
+				return false;
+		}
+
+		return true;
+#else
+		for (uint32 i = 0; i < PlanesCount; ++i)
+		{
+			float distance = m_PlanesX[i] * center.x + m_PlanesY[i] * center.y + m_PlanesZ[i] * center.z + m_PlanesW[i];
+			float radius = Math::Abs(m_PlanesX[i]) * extents.x + Math::Abs(m_PlanesY[i]) * extents.y + Math::Abs(m_PlanesZ[i]) * extents.z;
+
+			if (distance + radius < 0.f)
+				return false;
+		}
+
+		return true;
+#endif
+	}
+}
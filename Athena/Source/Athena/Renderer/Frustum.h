@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include "Athena/Math/Vector.h"
+#include "Athena/Math/Matrix.h"
+
+#include "Athena/Renderer/AABB.h"
+
+
+namespace Athena
+{
+	// 6 clip planes extracted from view projection matrix.
+	// Planes are stored in SoA layout, so AABB can be tested against 4 planes at once.
+	class ATHENA_API Frustum
+	{
+	public:
+		Frustum();
+		Frustum(const Matrix4& viewProjection);
+
+		bool IsVisible(const AABB& aabb) const;
+		// Tests local space 'aabb' transformed by 'transform'
+		bool IsVisible(const AABB& aabb, const Matrix4& transform) const;
+		bool IsVisible(const Vector3& center, const Vector3& extents) const;
+
+	private:
+		static constexpr uint32 PlanesCount = 6;
+		// Padded to 8, extra planes always pass
+		static constexpr uint32 PaddedPlanesCount = 8;
+
+		alignas(16) float m_PlanesX[PaddedPlanesCount];
+		alignas(16) float m_PlanesY[PaddedPlanesCount];
+		alignas(16) float m_PlanesZ[PaddedPlanesCount];
+		alignas(16) float m_PlanesW[PaddedPlanesCount];
+	};
+}
@@ -5,6 +5,7 @@
 #include "Athena/Platform/Vulkan/VulkanIndexBuffer.h"
 #include "Athena/Platform/Vulkan/VulkanUniformBuffer.h"
 #include "Athena/Platform/Vulkan/VulkanStorageBuffer.h"
+#include "Athena/Core/IDPool.h"
 
 
 namespace Athena
@@ -20,6 +21,25 @@ namespace Athena
 		return nullptr;
 	}
 
+	// Vertex buffer ID takes 24 bits of draw sort key.
+	// Pool is never destroyed, buffers may be released after static destructors.
+	static IDPool& GetVertexBufferIDPool()
+	{
+		static IDPool* pool = new IDPool(1 << 24);
+		return *pool;
+	}
+
+	VertexBuffer::VertexBuffer()
+		: m_ID(GetVertexBufferIDPool().Allocate())
+	{
+
+	}
+
+	VertexBuffer::~VertexBuffer()
+	{
+		GetVertexBufferIDPool().Release(m_ID);
+	}
+
 	Ref<VertexBuffer> VertexBuffer::Create(const VertexBufferCreateInfo& info)
 	{
 		switch (Renderer::GetAPI())
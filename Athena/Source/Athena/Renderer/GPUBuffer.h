@@ -2,6 +2,7 @@
 
 #include "Athena/Core/Core.h"
 #include "Athena/Core/Log.h"
+#include "Athena/Math/Common.h"
 #include "Athena/Utils/StringUtils.h"
 #include "Athena/Renderer/RenderResource.h"
 
@@ -161,6 +162,8 @@ namespace Athena
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset = 0) = 0;
 		virtual void Resize(uint64 size) = 0;
+		// Persistently mapped memory of current frame buffer, only for CPU_WRITEABLE
+		virtual void* GetMappedMemory() = 0;
 
 		uint32 GetCount() const { return m_Info.Count; }
 		uint32 GetSize() const { return m_Info.Count * sizeof(uint32); };
@@ -184,18 +187,27 @@ namespace Athena
 	{
 	public:
 		static Ref<VertexBuffer> Create(const VertexBufferCreateInfo& info);
-		virtual ~VertexBuffer() = default;
+		virtual ~VertexBuffer();
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset = 0) = 0;
 		virtual void Resize(uint64 size) = 0;
+		// Persistently mapped memory of current frame buffer, only for CPU_WRITEABLE
+		virtual void* GetMappedMemory() = 0;
 
 		uint64 GetSize() const { return m_Info.Size; }
 		Ref<IndexBuffer> GetIndexBuffer() const { return m_Info.IndexBuffer; }
 		const String& GetName() const { return m_Info.Name; }
 		const VertexBufferCreateInfo& GetInfo() const { return m_Info; }
 
+		// Unique among live vertex buffers, used for sorting draw calls
+		uint32 GetID() const { return m_ID; }
+
+	protected:
+		VertexBuffer();
+
 	protected:
 		VertexBufferCreateInfo m_Info;
+		uint32 m_ID;
 	};
 
 
@@ -226,6 +238,8 @@ namespace Athena
 
 		virtual void UploadData(const void* data, uint64 size, uint64 offset = 0) = 0;
 		virtual void Resize(uint64 size) = 0;
+		// Persistently mapped memory of current frame buffer, only for CPU_WRITEABLE
+		virtual void* GetMappedMemory() = 0;
 
 		virtual RenderResourceType GetResourceType() const override { return RenderResourceType::StorageBuffer; }
 		virtual const String& GetName() const override { return m_Name; }
@@ -237,49 +251,69 @@ namespace Athena
 		uint64 m_Size;
 	};
 
+	// Per frame in flight CPU_WRITEABLE buffer, data is written directly into persistently mapped memory.
+	// Grows on demand, shrinks back when peak usage stays low for ShrinkDelay flushes.
 	template <typename T>
 	class DynamicGPUBuffer
 	{
+	public:
+		static constexpr float GrowFactor = 2.f;
+		static constexpr uint64 ShrinkThreshold = 4;
+		static constexpr uint32 ShrinkDelay = 256;
+
 	public:
 		DynamicGPUBuffer() = default;
 		DynamicGPUBuffer(const Ref<T>& buffer)
-			: m_GPUBuffer(buffer) {}
+			: m_GPUBuffer(buffer), m_MinSize(buffer->GetSize()) {}
 
 		void Push(const void* data, uint64 size)
 		{
 			uint64 newOffset = m_DataOffset + size;
 
-			if (m_CPUBuffer.size() < newOffset)
+			if (m_GPUBuffer->GetSize() < newOffset)
 			{
-				uint64 newSize = newOffset * 2.f;
-				m_CPUBuffer.resize(newSize);
-			}
+				uint64 newSize = newOffset * GrowFactor;
 
-			auto begin = m_CPUBuffer.begin() + m_DataOffset;
-			memcpy(&(*begin), data, size);
+				ATN_CORE_WARN_TAG("Renderer", "{} allocating from {} to {}", m_GPUBuffer->GetName(), 
+					Utils::MemoryBytesToString(m_GPUBuffer->GetSize()), Utils::MemoryBytesToString(newSize));
+
+				Reallocate(newSize);
+			}
 
+			memcpy((byte*)m_GPUBuffer->GetMappedMemory() + m_DataOffset, data, size);
 			m_DataOffset = newOffset;
 		}
 
+		// Data is already visible to GPU, only tracks usage
 		void Flush()
 		{
-			// Increase size if not enough
-			if (m_GPUBuffer->GetSize() < m_DataOffset)
+			m_PeakUsage = Math::Max(m_PeakUsage, m_DataOffset);
+			m_UploadedSize = m_DataOffset;
+
+			if (++m_FlushCounter >= ShrinkDelay)
 			{
-				uint64 newSize = m_DataOffset * 2.f;
+				if (m_GPUBuffer->GetSize() > Math::Max(m_PeakUsage * ShrinkThreshold, m_MinSize))
+				{
+					uint64 newSize = Math::Max<uint64>(m_PeakUsage * GrowFactor, m_MinSize);
 
-				ATN_CORE_WARN_TAG("Renderer", "{} allocating from {} to {}", m_GPUBuffer->GetName(), 
-					Utils::MemoryBytesToString(m_GPUBuffer->GetSize()), Utils::MemoryBytesToString(newSize));
+					ATN_CORE_INFO_TAG("Renderer", "{} shrinking from {} to {}", m_GPUBuffer->GetName(),
+						Utils::MemoryBytesToString(m_GPUBuffer->GetSize()), Utils::MemoryBytesToString(newSize));
 
-				m_GPUBuffer->Resize(newSize);
-			}
+					Reallocate(newSize);
+				}
 
-			// TODO: Decrease size when too much allocated
+				m_PeakUsage = 0;
+				m_FlushCounter = 0;
+			}
 
-			m_GPUBuffer->UploadData(m_CPUBuffer.data(), m_DataOffset);
 			m_DataOffset = 0;
 		}
 
+		// Size of buffer for one frame in flight
+		uint64 GetCapacity() const { return m_GPUBuffer->GetSize(); }
+		// Bytes written between last two flushes
+		uint64 GetUploadedSize() const { return m_UploadedSize; }
+
 		// Only for StorageBuffer and UniformBuffer
 		operator Ref<RenderResource>() const 
 		{ 
@@ -291,9 +325,22 @@ namespace Athena
 			return m_GPUBuffer;
 		}
 
+	private:
+		// Release of old buffer is deferred by renderer, so its memory is still mapped
+		// and data written in current frame is moved without GPU copy
+		void Reallocate(uint64 size)
+		{
+			const byte* oldData = (const byte*)m_GPUBuffer->GetMappedMemory();
+			m_GPUBuffer->Resize(size);
+			memcpy(m_GPUBuffer->GetMappedMemory(), oldData, m_DataOffset);
+		}
+
 	private:
 		Ref<T> m_GPUBuffer;
-		std::vector<byte> m_CPUBuffer;
+		uint64 m_MinSize = 0;
 		uint64 m_DataOffset = 0;
+		uint64 m_UploadedSize = 0;
+		uint64 m_PeakUsage = 0;
+		uint32 m_FlushCounter = 0;
 	};
 }
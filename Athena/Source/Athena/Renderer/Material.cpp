@@ -3,6 +3,7 @@
 #include "Athena/Renderer/Renderer.h"
 #include "Athena/Platform/Vulkan/VulkanMaterial.h"
 #include "Athena/Math/Random.h"
+#include "Athena/Core/IDPool.h"
 
 
 namespace Athena
@@ -30,8 +31,40 @@ namespace Athena
 		return Material::Create(Renderer::GetShaderPack()->Get("GBuffer_Anim"), name);
 	}
 
+	Ref<Material> Material::Copy(const Ref<Material>& other)
+	{
+		Ref<Material> result = Material::Create(other->m_Shader, other->m_Name);
+		memcpy(result->m_Buffer, other->m_Buffer, sizeof(m_Buffer));
+		result->m_Flags = other->m_Flags;
+
+		// Set 0 contains material resources
+		for (const auto& [name, desc] : other->m_Shader->GetResourcesDescription())
+		{
+			if (desc.Set != 0)
+				continue;
+
+			for (uint32 i = 0; i < desc.ArraySize; ++i)
+			{
+				Ref<RenderResource> resource = other->GetResourceInternal(name, i);
+				if (resource)
+					result->Set(name, resource, i);
+			}
+		}
+
+		return result;
+	}
+
+	// Material ID takes 24 bits of draw sort key.
+	// Pool is never destroyed, materials may be released after static destructors.
+	static IDPool& GetMaterialIDPool()
+	{
+		static IDPool* pool = new IDPool(1 << 24);
+		return *pool;
+	}
+
 	Material::Material(const Ref<Shader> shader, const String& name)
-		: m_Shader(shader), m_Name(name), m_BufferMembers(&shader->GetMetaData().PushConstant.Members)
+		: m_Shader(shader), m_Name(name), m_ID(GetMaterialIDPool().Allocate()),
+		m_BufferMembers(&shader->GetMetaData().PushConstant.Members)
 	{
 		memset(m_Buffer, 0, sizeof(m_Buffer));
 
@@ -40,7 +73,7 @@ namespace Athena
 
 	Material::~Material()
 	{
-		
+		GetMaterialIDPool().Release(m_ID);
 	}
 
 	void Material::Set(const String& name, const Matrix4& value)
@@ -97,6 +130,20 @@ namespace Athena
 		memcpy(&m_Buffer[offset], &value, sizeof(value));
 	}
 
+	void Material::Set(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex)
+	{
+		SetResourceInternal(name, resource, arrayIndex);
+
+		std::erase_if(m_StreamedTextures, [&name](const auto& slot) { return slot.first == name; });
+
+		if (resource && resource->GetResourceType() == RenderResourceType::Texture2D)
+		{
+			Ref<Texture2D> texture = resource.As<Texture2D>();
+			if (texture->IsStreamed())
+				m_StreamedTextures.push_back({ name, texture });
+		}
+	}
+
 	bool Material::GetMemberOffset(const String& name, ShaderDataType dataType, uint32* offset)
 	{
 		if (!m_BufferMembers->contains(name))
@@ -129,6 +176,15 @@ namespace Athena
 		return false;
 	}
 
+	Ref<MaterialTable> MaterialTable::Copy(const Ref<MaterialTable>& other)
+	{
+		Ref<MaterialTable> result = Ref<MaterialTable>::Create();
+		for (const auto& [name, material] : other->m_Materials)
+			result->m_Materials[name] = Material::Copy(material);
+
+		return result;
+	}
+
 	Ref<Material> MaterialTable::Get(const String& name) const
 	{
 		return m_Materials.at(name);
@@ -22,6 +22,8 @@ namespace Athena
 		static Ref<Material> Create(const Ref<Shader>& shader, const String& name);
 		static Ref<Material> CreatePBRStatic(const String& name);
 		static Ref<Material> CreatePBRAnim(const String& name);
+		// Same shader, parameters and bound resources, changes to copy do not affect 'other'
+		static Ref<Material> Copy(const Ref<Material>& other);
 		virtual ~Material();
 
 		void Set(const String& name, const Matrix4& value);
@@ -31,7 +33,7 @@ namespace Athena
 		void Set(const String& name, uint32 value);
 		void Set(const String& name, int32 value);
 
-		virtual void Set(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex = 0) = 0;
+		void Set(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex = 0);
 
 		template <typename T>
 		T Get(const String& name);
@@ -45,11 +47,18 @@ namespace Athena
 		Ref<Shader> GetShader() const { return m_Shader; }
 		const String& GetName() const { return m_Name; }
 
+		// Unique among live materials, used for sorting draw calls
+		uint32 GetID() const { return m_ID; }
+
+		// Streamed textures bound to material by name, TextureStreamer loads their mips when material is drawn
+		const std::vector<std::pair<String, Ref<Texture2D>>>& GetStreamedTextures() const { return m_StreamedTextures; }
+
 	protected:
 		Material(const Ref<Shader> shader, const String& name);
 
 	private:
-		virtual Ref<RenderResource> GetResourceInternal(const String& name) = 0;
+		virtual void SetResourceInternal(const String& name, const Ref<RenderResource>& resource, uint32 arrayIndex) = 0;
+		virtual Ref<RenderResource> GetResourceInternal(const String& name, uint32 arrayIndex) = 0;
 
 		bool GetMemberOffset(const String& name, ShaderDataType dataType, uint32* offset);
 		bool GetInternal(const String& name, ShaderDataType dataType, void** data);
@@ -57,9 +66,11 @@ namespace Athena
 	private:
 		Ref<Shader> m_Shader;
 		String m_Name;
+		uint32 m_ID;
 		byte m_Buffer[128];
 		const std::unordered_map<String, StructMemberShaderMetaData>* m_BufferMembers;
 		std::unordered_map<MaterialFlag, bool> m_Flags;
+		std::vector<std::pair<String, Ref<Texture2D>>> m_StreamedTextures;
 	};
 
 	template <>
@@ -105,7 +116,7 @@ namespace Athena
 	template <>
 	inline Ref<Texture2D> Material::Get<Ref<Texture2D>>(const String& name)
 	{
-		return GetResourceInternal(name);
+		return GetResourceInternal(name, 0);
 	}
 
 
@@ -113,6 +124,9 @@ namespace Athena
 	{
 	public:
 		Ref<Material> Get(const String& name) const;
+		// Each material is copied
+		static Ref<MaterialTable> Copy(const Ref<MaterialTable>& other);
+
 		void Add(const Ref<Material>& material);
 		void Remove(const Ref<Material>& material);
 
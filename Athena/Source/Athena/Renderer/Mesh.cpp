@@ -1,17 +1,122 @@
 #include "Mesh.h"
 
+#include "Athena/Core/Application.h"
 #include "Athena/Core/FileSystem.h"
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Asset/AssetLoader.h"
+#include "Athena/Asset/TextureCache.h"
 #include "Athena/Asset/TextureImporter.h"
+#include "Athena/Renderer/MeshCacheStream.h"
 #include "Athena/Renderer/Renderer.h"
+#include "Athena/Utils/HashUtils.h"
 
 #include <assimp/cimport.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/matrix4x4.h>
 
+#include <atomic>
+#include <span>
+
 
 namespace Athena
 {
+	// Increment when layout of cooked data or import logic changes
+	static constexpr uint32 MeshCacheVersion = 2;
+	static constexpr uint32 MeshCacheMagic = 0x4D4E5441;	// 'ATNM'
+
+	static constexpr uint32 ImportFlags =
+		aiProcess_GenUVCoords |
+		aiProcess_CalcTangentSpace |
+		aiProcess_GenSmoothNormals |
+		aiProcess_FixInfacingNormals |
+		aiProcess_GenBoundingBoxes |
+		aiProcess_FindInvalidData |
+
+		aiProcess_SortByPType |
+		aiProcess_FindDegenerates |
+		aiProcess_ImproveCacheLocality |
+		aiProcess_JoinIdenticalVertices |
+		aiProcess_LimitBoneWeights |
+
+		aiProcess_RemoveRedundantMaterials |
+		aiProcess_OptimizeGraph |
+		aiProcess_OptimizeMeshes |
+
+		aiProcess_Triangulate |
+		aiProcess_EmbedTextures |
+		aiProcess_FlipUVs;
+
+	enum MaterialTextureSlot
+	{
+		ALBEDO_MAP = 0,
+		NORMAL_MAP,
+		ROUGHNESS_MAP,
+		METALNESS_MAP,
+
+		TEXTURE_SLOT_COUNT
+	};
+
+	enum CookedMaterialProperty
+	{
+		HAS_ALBEDO = BIT(0),
+		HAS_ROUGHNESS = BIT(1),
+		HAS_METALNESS = BIT(2),
+		HAS_EMISSION = BIT(3),
+	};
+
+	enum class CookedTextureSource : uint8
+	{
+		NONE = 0,
+		EMBEDDED,
+		// Path is relative to mesh file
+		EXTERNAL
+	};
+
+	struct CookedTexture
+	{
+		CookedTextureSource Source = CookedTextureSource::NONE;
+		String Path;
+		uint32 Width = 0;
+		uint32 Height = 0;
+		std::span<const byte> EmbeddedData;
+	};
+
+	struct CookedMaterial
+	{
+		String Name;
+		uint32 Properties = 0;
+		Vector4 Albedo;
+		float Roughness = 0.f;
+		float Metalness = 0.f;
+		float Emission = 0.f;
+		CookedTexture Textures[TEXTURE_SLOT_COUNT];
+	};
+
+	struct CookedSubMesh
+	{
+		String Name;
+		String MaterialName;
+		AABB BoundingBox;
+		float UVDensity = 0.f;
+		std::span<const byte> Vertices;
+		std::span<const uint32> Indices;
+	};
+
+	// CPU side result of mesh import, vertex and index data is either
+	// owned by 'Storage' or points into mapped cache file
+	struct MeshCookedData
+	{
+		AABB BoundingBox;
+		std::vector<CookedSubMesh> SubMeshes;
+		std::vector<CookedMaterial> Materials;
+		std::vector<Bone> Bones;
+		std::vector<AnimationCreateInfo> Animations;
+
+		std::vector<std::vector<byte>> Storage;
+		Ref<MappedFile> CacheFile;
+	};
+
 	static Matrix4 ConvertaiMatrix4x4(const aiMatrix4x4& input)
 	{
 		Matrix4 output;
@@ -37,131 +142,108 @@ namespace Athena
 		return { input.x, input.y, input.z };
 	}
 
-	static String ConvertaiStringName(const aiString& aiName)
+	static String GetResourceName(const String& name)
 	{
 		const uint32 nameMaxLength = 30;
 
-		if (aiName.length >= nameMaxLength)
-		{
-			String name = aiName.C_Str();
+		if (name.length() >= nameMaxLength)
 			return name.substr(0, nameMaxLength);
-		}
 
-		return aiName.C_Str();
+		return name;
 	}
 
-	static Ref<Texture2D> LoadTexture(const aiScene* aiscene, const aiMaterial* aimaterial, uint32 type, bool srgb, const FilePath& path)
+	static uint32 FindBoneIndex(const std::vector<Bone>& bones, const String& name)
 	{
-		Ref<Texture2D> result = nullptr;
-
-		aiString texFilepath;
-		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_TEXTURE(type, 0), texFilepath))
+		for (const auto& bone : bones)
 		{
-			TextureImportOptions options;
-			options.sRGB = srgb;
-			options.GenerateMipMaps = true;
-
-			const aiTexture* embeddedTex = aiscene->GetEmbeddedTexture(texFilepath.C_Str());
-			if (embeddedTex)
-			{
-				void* data = embeddedTex->pcData;
-				uint32 width = embeddedTex->mWidth;
-				uint32 height = embeddedTex->mHeight;
-
-				options.Name = String(texFilepath.C_Str(), texFilepath.length);
-				result = TextureImporter::Load(data, width, height, options);
-			}
-			else
-			{
-				FilePath path = path;
-				path.replace_filename(texFilepath.C_Str());
-				if (FileSystem::Exists(path))
-				{
-					result = TextureImporter::Load(path, options);
-				}
-				else
-				{
-					ATN_CORE_WARN_TAG("StaticMesh", "Invalid texture filepath '{}'", path);
-				}
-			}
+			if (bone.Name == name)
+				return bone.Index;
 		}
 
-		return result;
+		ATN_CORE_ASSERT(false);
+		return 0;
 	}
 
-	static Ref<Material> LoadMaterial(const aiScene* aiscene, uint32 aiMaterialIndex, const FilePath& path, Ref<MaterialTable> table, bool animated)
+	static bool CookTexture(const aiScene* aiscene, const aiMaterial* aimaterial, uint32 type, const FilePath& meshPath, MeshCookedData& data, CookedTexture& texture)
 	{
-		Ref<Material> result;
-		const aiMaterial* aimaterial = aiscene->mMaterials[aiMaterialIndex];
-		String materialName = aimaterial->GetName().C_Str();
+		aiString texFilepath;
+		if (AI_SUCCESS != aimaterial->Get(AI_MATKEY_TEXTURE(type, 0), texFilepath))
+			return false;
 
-		if (table->Exists(materialName))
-			return table->Get(materialName);
+		texture.Path = String(texFilepath.C_Str(), texFilepath.length);
 
-		if (animated)
-			result = Material::CreatePBRAnim(materialName);
-		else
-			result = Material::CreatePBRStatic(materialName);
+		const aiTexture* embeddedTex = aiscene->GetEmbeddedTexture(texFilepath.C_Str());
+		if (embeddedTex)
+		{
+			texture.Source = CookedTextureSource::EMBEDDED;
+			texture.Width = embeddedTex->mWidth;
+			texture.Height = embeddedTex->mHeight;
 
-		aiColor4D color;
-		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_BASE_COLOR, color))
-			result->Set("u_Albedo", Vector4(color.r, color.g, color.b, color.a));
-		else if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_COLOR_DIFFUSE, color))
-			result->Set("u_Albedo", Vector4(color.r, color.g, color.b, color.a));
+			// Height is 0 for compressed textures, width is size in bytes then
+			uint64 size = texture.Height == 0 ? texture.Width : (uint64)texture.Width * texture.Height * sizeof(aiTexel);
+			const byte* bytes = (const byte*)embeddedTex->pcData;
+
+			std::vector<byte>& storage = data.Storage.emplace_back(bytes, bytes + size);
+			texture.EmbeddedData = storage;
+			return true;
+		}
 
-		float roughness;
-		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness))
-			result->Set("u_Roughness", roughness);
+		FilePath texturePath = meshPath;
+		texturePath.replace_filename(texture.Path);
+		if (!FileSystem::Exists(texturePath))
+		{
+			ATN_CORE_WARN_TAG("StaticMesh", "Invalid texture filepath '{}'", texturePath);
+			return false;
+		}
+
+		texture.Source = CookedTextureSource::EXTERNAL;
+		return true;
+	}
 
-		float metalness;
-		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_METALLIC_FACTOR, metalness))
-			result->Set("u_Metalness", metalness);
+	static void CookMaterial(const aiScene* aiscene, const aiMaterial* aimaterial, const FilePath& meshPath, MeshCookedData& data)
+	{
+		CookedMaterial material;
+		material.Name = aimaterial->GetName().C_Str();
 
-		float emission;
-		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_EMISSIVE_INTENSITY, emission))
-			result->Set("u_Emission", emission);
-		
-		result->Set("u_UseAlbedoMap", (uint32)true);
-		result->Set("u_UseNormalMap", (uint32)false);
-		result->Set("u_UseRoughnessMap", (uint32)false);
-		result->Set("u_UseMetalnessMap", (uint32)false);
+		for (const auto& cooked : data.Materials)
+		{
+			if (cooked.Name == material.Name)
+				return;
+		}
 
-		Ref<Texture2D> texture;
+		aiColor4D color;
+		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_BASE_COLOR, color) || AI_SUCCESS == aimaterial->Get(AI_MATKEY_COLOR_DIFFUSE, color))
+		{
+			material.Albedo = Vector4(color.r, color.g, color.b, color.a);
+			material.Properties |= HAS_ALBEDO;
+		}
 
-		if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_BASE_COLOR, true, path))
-			result->Set("u_AlbedoMap", texture);
-		else if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_DIFFUSE, true, path))
-			result->Set("u_AlbedoMap", texture);
+		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_ROUGHNESS_FACTOR, material.Roughness))
+			material.Properties |= HAS_ROUGHNESS;
 
-		result->Set("u_UseAlbedoMap", uint32(texture != nullptr));
+		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_METALLIC_FACTOR, material.Metalness))
+			material.Properties |= HAS_METALNESS;
 
-		if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_NORMALS, false, path))
-			result->Set("u_NormalMap", texture);
+		if (AI_SUCCESS == aimaterial->Get(AI_MATKEY_EMISSIVE_INTENSITY, material.Emission))
+			material.Properties |= HAS_EMISSION;
 
-		result->Set("u_UseNormalMap", uint32(texture != nullptr));
+		if (!CookTexture(aiscene, aimaterial, aiTextureType_BASE_COLOR, meshPath, data, material.Textures[ALBEDO_MAP]))
+			CookTexture(aiscene, aimaterial, aiTextureType_DIFFUSE, meshPath, data, material.Textures[ALBEDO_MAP]);
 
-		if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_DIFFUSE_ROUGHNESS, false, path))
-			result->Set("u_RoughnessMap", texture);
-		else if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_SHININESS, false, path))
-			result->Set("u_RoughnessMap", texture);
+		CookTexture(aiscene, aimaterial, aiTextureType_NORMALS, meshPath, data, material.Textures[NORMAL_MAP]);
 
-		result->Set("u_UseRoughnessMap", uint32(texture != nullptr));
+		if (!CookTexture(aiscene, aimaterial, aiTextureType_DIFFUSE_ROUGHNESS, meshPath, data, material.Textures[ROUGHNESS_MAP]))
+			CookTexture(aiscene, aimaterial, aiTextureType_SHININESS, meshPath, data, material.Textures[ROUGHNESS_MAP]);
 
-		if (texture = LoadTexture(aiscene, aimaterial, aiTextureType_METALNESS, false, path))
-			result->Set("u_MetalnessMap", texture);
+		CookTexture(aiscene, aimaterial, aiTextureType_METALNESS, meshPath, data, material.Textures[METALNESS_MAP]);
 
-		result->Set("u_UseMetalnessMap", uint32(texture != nullptr));
-		
-		table->Add(result);
-		return result;
+		data.Materials.push_back(material);
 	}
 
-	static Ref<VertexBuffer> LoadStaticVertexBuffer(const aiMesh* aimesh, const Matrix4& localTransform)
+	template <typename TVertex>
+	static void CookVertexAttributes(const aiMesh* aimesh, const Matrix4& localTransform, std::vector<TVertex>& vertices)
 	{
-		uint32 numVertices = aimesh->mNumVertices;
-		std::vector<StaticVertex> vertices(numVertices);
-
-		for (uint32 i = 0; i < numVertices; ++i)
+		for (uint32 i = 0; i < vertices.size(); ++i)
 		{
 			// Position
 			if (aimesh->HasPositions())
@@ -194,57 +276,68 @@ namespace Athena
 				vertices[i].Bitangent = Vector4(ConvertaiVector3D(aimesh->mBitangents[i]), 0) * localTransform;
 			}
 		}
+	}
 
-		uint32 numFaces = aimesh->mNumFaces;
-		aiFace* faces = aimesh->mFaces;
+	// Square root of uv area to surface area ratio, used by texture streaming to estimate texel density on screen
+	static float ComputeUVDensity(const aiMesh* aimesh, const Matrix4& localTransform)
+	{
+		// Same channel as in CookVertexAttributes
+		const aiVector3D* texCoords = nullptr;
+		for (uint32 j = 0; j < AI_MAX_NUMBER_OF_TEXTURECOORDS && !texCoords; ++j)
+		{
+			if (aimesh->HasTextureCoords(j))
+				texCoords = aimesh->mTextureCoords[j];
+		}
 
-		std::vector<uint32> indices(numFaces * 3);
+		if (!aimesh->HasPositions() || !texCoords)
+			return 0.f;
 
-		uint32 index = 0;
-		for (uint32 i = 0; i < numFaces; i++)
+		double surfaceArea = 0.0;
+		double uvArea = 0.0;
+
+		for (uint32 i = 0; i < aimesh->mNumFaces; ++i)
 		{
-			if (faces[i].mNumIndices != 3)
-				break;
+			const aiFace& face = aimesh->mFaces[i];
+			if (face.mNumIndices != 3)
+				continue;
 
-			indices[index++] = faces[i].mIndices[0];
-			indices[index++] = faces[i].mIndices[1];
-			indices[index++] = faces[i].mIndices[2];
-		}
+			Vector3 p0 = ConvertaiVector3D(aimesh->mVertices[face.mIndices[0]]) * localTransform;
+			Vector3 p1 = ConvertaiVector3D(aimesh->mVertices[face.mIndices[1]]) * localTransform;
+			Vector3 p2 = ConvertaiVector3D(aimesh->mVertices[face.mIndices[2]]) * localTransform;
 
-		Ref<IndexBuffer> indexBuffer = nullptr;
-		if (!indices.empty())
-		{
-			IndexBufferCreateInfo indexBufferInfo;
-			indexBufferInfo.Name = std::format("{}_IndexBuffer", ConvertaiStringName(aimesh->mName));
-			indexBufferInfo.Data = indices.data();
-			indexBufferInfo.Count = indices.size();
-			indexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
+			const aiVector3D& uv0 = texCoords[face.mIndices[0]];
+			const aiVector3D& uv1 = texCoords[face.mIndices[1]];
+			const aiVector3D& uv2 = texCoords[face.mIndices[2]];
 
-			indexBuffer = IndexBuffer::Create(indexBufferInfo);
+			surfaceArea += Math::Cross(p1 - p0, p2 - p0).Length() * 0.5;
+			uvArea += Math::Abs((uv1.x - uv0.x) * (uv2.y - uv0.y) - (uv2.x - uv0.x) * (uv1.y - uv0.y)) * 0.5;
 		}
 
-		VertexBufferCreateInfo vertexBufferInfo;
-		vertexBufferInfo.Name = std::format("{}_VertexBuffer", ConvertaiStringName(aimesh->mName));
-		vertexBufferInfo.Data = vertices.data();
-		vertexBufferInfo.Size = vertices.size() * sizeof(StaticVertex);
-		vertexBufferInfo.IndexBuffer = indexBuffer;
-		vertexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
+		if (surfaceArea <= 0.0)
+			return 0.f;
 
-		return VertexBuffer::Create(vertexBufferInfo);
+		return (float)Math::Sqrt(uvArea / surfaceArea);
+	}
+
+	static std::vector<byte> CookStaticVertices(const aiMesh* aimesh, const Matrix4& localTransform)
+	{
+		std::vector<StaticVertex> vertices(aimesh->mNumVertices);
+		CookVertexAttributes(aimesh, localTransform, vertices);
+
+		const byte* bytes = (const byte*)vertices.data();
+		return std::vector<byte>(bytes, bytes + vertices.size() * sizeof(StaticVertex));
 	}
 
-	static Ref<VertexBuffer> LoadAnimVertexBuffer(const aiMesh* aimesh, const Matrix4& localTransform, const Ref<Skeleton>& skeleton)
+	static std::vector<byte> CookAnimVertices(const aiMesh* aimesh, const Matrix4& localTransform, const std::vector<Bone>& bones)
 	{
-		uint32 numVertices = aimesh->mNumVertices;
-		std::vector<AnimVertex> vertices(numVertices);
+		std::vector<AnimVertex> vertices(aimesh->mNumVertices);
 
-		if (aimesh->HasBones() && skeleton)
+		if (aimesh->HasBones())
 		{
 			for (uint32 i = 0; i < aimesh->mNumBones; ++i)
 			{
 				aiBone* aibone = aimesh->mBones[i];
-				uint32 boneID = skeleton->GetBoneIndex(aibone->mName.C_Str());
-				skeleton->SetBoneOffsetMatrix(boneID, ConvertaiMatrix4x4(aibone->mOffsetMatrix));
+				uint32 boneID = FindBoneIndex(bones, aibone->mName.C_Str());
 
 				for (uint32 j = 0; j < aibone->mNumWeights; ++j)
 				{
@@ -268,44 +361,29 @@ namespace Athena
 			}
 		}
 
-		for (uint32 i = 0; i < numVertices; ++i)
-		{
-			// Position
-			if (aimesh->HasPositions())
-			{
-				vertices[i].Position = ConvertaiVector3D(aimesh->mVertices[i]) * localTransform;
-			}
-
-			// TexCoord
-			for (uint32 j = 0; j < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++j)
-			{
-				if (aimesh->HasTextureCoords(j))
-				{
-					vertices[i].TexCoords.x = aimesh->mTextureCoords[j][i].x;
-					vertices[i].TexCoords.y = aimesh->mTextureCoords[j][i].y;
-					break;
-				}
-			}
+		CookVertexAttributes(aimesh, localTransform, vertices);
 
-			// Normal
-			if (aimesh->HasNormals())
-			{
-				vertices[i].Normal = Vector4(ConvertaiVector3D(aimesh->mNormals[i]), 0) * localTransform;
-			}
+		const byte* bytes = (const byte*)vertices.data();
+		return std::vector<byte>(bytes, bytes + vertices.size() * sizeof(AnimVertex));
+	}
 
-			if (aimesh->HasTangentsAndBitangents())
-			{
-				// Tangent
-				vertices[i].Tangent = Vector4(ConvertaiVector3D(aimesh->mTangents[i]), 0) * localTransform;
-				// Bitangent
-				vertices[i].Bitangent = Vector4(ConvertaiVector3D(aimesh->mBitangents[i]), 0) * localTransform;
-			}
+	static void CookBoneOffsets(const aiMesh* aimesh, std::vector<Bone>& bones)
+	{
+		for (uint32 i = 0; i < aimesh->mNumBones; ++i)
+		{
+			aiBone* aibone = aimesh->mBones[i];
+			uint32 boneID = FindBoneIndex(bones, aibone->mName.C_Str());
+			bones[boneID].OffsetMatrix = ConvertaiMatrix4x4(aibone->mOffsetMatrix);
 		}
+	}
 
+	static std::vector<byte> CookIndices(const aiMesh* aimesh)
+	{
 		uint32 numFaces = aimesh->mNumFaces;
 		aiFace* faces = aimesh->mFaces;
 
-		std::vector<uint32> indices(numFaces * 3);
+		std::vector<byte> storage(numFaces * 3 * sizeof(uint32));
+		uint32* indices = (uint32*)storage.data();
 
 		uint32 index = 0;
 		for (uint32 i = 0; i < numFaces; i++)
@@ -318,56 +396,95 @@ namespace Athena
 			indices[index++] = faces[i].mIndices[2];
 		}
 
-		Ref<IndexBuffer> indexBuffer = nullptr;
-		if (!indices.empty())
-		{
-			IndexBufferCreateInfo indexBufferInfo;
-			indexBufferInfo.Name = std::format("{}_IndexBuffer", ConvertaiStringName(aimesh->mName));
-			indexBufferInfo.Data = indices.data();
-			indexBufferInfo.Count = indices.size();
-			indexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
+		return storage;
+	}
 
-			indexBuffer = IndexBuffer::Create(indexBufferInfo);
+	struct SubMeshCookTask
+	{
+		const aiMesh* Mesh;
+		Matrix4 Transform;
+		std::vector<byte> Vertices;
+		std::vector<byte> Indices;
+		float UVDensity = 0.f;
+	};
+
+	static void CollectSubMeshes(const aiScene* aiscene, const aiNode* ainode, const Matrix4& parentTransform, std::vector<SubMeshCookTask>& tasks)
+	{
+		Matrix4 localTransform = parentTransform * ConvertaiMatrix4x4(ainode->mTransformation);
+
+		for (uint32 i = 0; i < ainode->mNumMeshes; ++i)
+		{
+			SubMeshCookTask& task = tasks.emplace_back();
+			task.Mesh = aiscene->mMeshes[ainode->mMeshes[i]];
+			task.Transform = localTransform;
 		}
 
-		VertexBufferCreateInfo vertexBufferInfo;
-		vertexBufferInfo.Name = std::format("{}_VertexBuffer", ConvertaiStringName(aimesh->mName));
-		vertexBufferInfo.Data = vertices.data();
-		vertexBufferInfo.Size = vertices.size() * sizeof(AnimVertex);
-		vertexBufferInfo.IndexBuffer = indexBuffer;
-		vertexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
-	
-		return VertexBuffer::Create(vertexBufferInfo);
+		for (uint32 i = 0; i < ainode->mNumChildren; ++i)
+		{
+			CollectSubMeshes(aiscene, ainode->mChildren[i], localTransform, tasks);
+		}
 	}
 
-	static SubMesh LoadSubMesh(const aiScene* aiscene, uint32 aiMeshIndex, const FilePath& path, const Matrix4& localTransform, Ref<MaterialTable> table, Ref<Skeleton> skeleton, AABB& aabb)
+	static void CookSubMeshes(const aiScene* aiscene, const FilePath& meshPath, MeshCookedData& data)
 	{
-		aiMesh* aimesh = aiscene->mMeshes[aiMeshIndex];
-		SubMesh subMesh;
+		std::vector<SubMeshCookTask> tasks;
+		CollectSubMeshes(aiscene, aiscene->mRootNode, Matrix4::Identity(), tasks);
 
-		aabb.Extend(AABB(ConvertaiVector3D(aimesh->mAABB.mMin) * localTransform, ConvertaiVector3D(aimesh->mAABB.mMax) * localTransform));
+		const bool animated = !data.Bones.empty();
 
-		subMesh.Name = aimesh->mName.C_Str();
-		if(skeleton)
-			subMesh.VertexBuffer = LoadAnimVertexBuffer(aimesh, localTransform, skeleton);
-		else
-			subMesh.VertexBuffer = LoadStaticVertexBuffer(aimesh, localTransform);
+		// Bones are shared between submeshes, so offsets are written before conversion
+		if (animated)
+		{
+			for (const auto& task : tasks)
+				CookBoneOffsets(task.Mesh, data.Bones);
+		}
 
-		const aiMaterial* aimaterial = aiscene->mMaterials[aimesh->mMaterialIndex];
-		String materialName = aimaterial->GetName().C_Str();
+		JobSystem::ParallelFor(tasks.size(), 1, [&tasks, &data, animated](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+			{
+				SubMeshCookTask& task = tasks[i];
 
-		subMesh.MaterialName = LoadMaterial(aiscene, aimesh->mMaterialIndex, path, table, skeleton != nullptr)->GetName();
+				if (animated)
+					task.Vertices = CookAnimVertices(task.Mesh, task.Transform, data.Bones);
+				else
+					task.Vertices = CookStaticVertices(task.Mesh, task.Transform);
 
-		return subMesh;
+				task.Indices = CookIndices(task.Mesh);
+				task.UVDensity = ComputeUVDensity(task.Mesh, task.Transform);
+			}
+		});
+
+		data.SubMeshes.resize(tasks.size());
+		for (uint32 i = 0; i < tasks.size(); ++i)
+		{
+			SubMeshCookTask& task = tasks[i];
+			CookedSubMesh& subMesh = data.SubMeshes[i];
+
+			subMesh.Name = task.Mesh->mName.C_Str();
+			subMesh.BoundingBox = AABB(ConvertaiVector3D(task.Mesh->mAABB.mMin), ConvertaiVector3D(task.Mesh->mAABB.mMax)).Transform(task.Transform);
+			data.BoundingBox.Extend(subMesh.BoundingBox);
+			subMesh.UVDensity = task.UVDensity;
+
+			subMesh.Vertices = data.Storage.emplace_back(std::move(task.Vertices));
+
+			const std::vector<byte>& indices = data.Storage.emplace_back(std::move(task.Indices));
+			subMesh.Indices = std::span<const uint32>((const uint32*)indices.data(), indices.size() / sizeof(uint32));
+
+			// Materials are deduplicated by name, so they are cooked in submesh order
+			const aiMaterial* aimaterial = aiscene->mMaterials[task.Mesh->mMaterialIndex];
+			subMesh.MaterialName = aimaterial->GetName().C_Str();
+			CookMaterial(aiscene, aimaterial, meshPath, data);
+		}
 	}
 
-	static void LoadBones(const aiNode* aiBone, std::vector<Bone>& bones)
+	static void CookBones(const aiNode* aiBone, std::vector<Bone>& bones)
 	{
 		String nodeName = aiBone->mName.C_Str();
 		bool isValid = nodeName.find("AssimpFbx") == String::npos && nodeName.find("RootNode") == String::npos;
 		if (aiBone->mNumChildren > 0 && !isValid)
 		{
-			LoadBones(aiBone->mChildren[0], bones);
+			CookBones(aiBone->mChildren[0], bones);
 			return;
 		}
 
@@ -381,14 +498,14 @@ namespace Athena
 		for (uint32 i = 0; i < aiBone->mNumChildren; ++i)
 		{
 			bones[bone.Index].Children[i] = bones.size();
-			LoadBones(aiBone->mChildren[i], bones);
+			CookBones(aiBone->mChildren[i], bones);
 		}
 	}
 
-	static Ref<Skeleton> LoadSkeleton(const aiScene* aiscene)
+	static void CookSkeleton(const aiScene* aiscene, std::vector<Bone>& bones)
 	{
 		if (aiscene->mNumAnimations <= 0)
-			return nullptr;
+			return;
 
 		const aiNode* root = aiscene->mRootNode;
 		const aiNode* bonesRoot = nullptr;
@@ -403,21 +520,17 @@ namespace Athena
 			}
 		}
 		if (bonesRoot == nullptr)
-			return nullptr;
-
-		std::vector<Bone> bones;
-		LoadBones(bonesRoot, bones);
+			return;
 
-		return Skeleton::Create(bones);
+		CookBones(bonesRoot, bones);
 	}
 
-	static Ref<Animation> LoadAnimation(const aiAnimation* aianimation, const Ref<Skeleton>& skeleton)
+	static AnimationCreateInfo CookAnimation(const aiAnimation* aianimation)
 	{
 		AnimationCreateInfo info;
 		info.Name = aianimation->mName.C_Str();
 		info.Duration = aianimation->mDuration;
 		info.TicksPerSecond = aianimation->mTicksPerSecond;
-		info.Skeleton = skeleton;
 
 		info.BoneNameToKeyFramesMap.reserve(aianimation->mNumChannels);
 		for (uint32 i = 0; i < aianimation->mNumChannels; ++i)
@@ -449,57 +562,664 @@ namespace Athena
 			info.BoneNameToKeyFramesMap[channel->mNodeName.C_Str()] = keyFrames;
 		}
 
-		return Animation::Create(info);
+		return info;
 	}
 
-	void StaticMesh::ProcessNode(const aiScene* aiscene, const aiNode* ainode, const Matrix4& parentTransform)
+	static bool ImportMesh(const FilePath& path, MeshCookedData& data)
 	{
-		Matrix4 localTransform = parentTransform * ConvertaiMatrix4x4(ainode->mTransformation);
+		ATN_PROFILE_FUNC();
 
-		m_SubMeshes.reserve(ainode->mNumMeshes);
-		for (uint32 i = 0; i < ainode->mNumMeshes; ++i)
+		const aiScene* aiscene = aiImportFile(path.string().c_str(), ImportFlags);
+
+		if (aiscene == nullptr)
+		{
+			ATN_CORE_ERROR_TAG("StaticMesh", "Failed to load mesh from '{}': {}", path, aiGetErrorString());
+			return false;
+		}
+
+		CookSkeleton(aiscene, data.Bones);
+		CookSubMeshes(aiscene, path, data);
+
+		if (!data.Bones.empty())
+		{
+			data.Animations.resize(aiscene->mNumAnimations);
+
+			for (uint32 i = 0; i < aiscene->mNumAnimations; ++i)
+			{
+				data.Animations[i] = CookAnimation(aiscene->mAnimations[i]);
+			}
+		}
+
+		aiReleaseImport(aiscene);
+		return true;
+	}
+
+	static std::string_view TrimWhitespace(std::string_view str)
+	{
+		size_t begin = str.find_first_not_of(" \t");
+		if (begin == std::string_view::npos)
+			return {};
+
+		size_t end = str.find_last_not_of(" \t");
+		return str.substr(begin, end - begin + 1);
+	}
+
+	// Files that model references instead of embedding, .mtl for .obj and buffers/images for .gltf
+	static std::vector<FilePath> GetMeshDependencies(const FilePath& path, std::string_view text)
+	{
+		std::vector<FilePath> result;
+		FilePath folder = path.parent_path();
+		String extension = path.extension().string();
+
+		if (extension == ".obj")
+		{
+			size_t pos = 0;
+			while ((pos = text.find("mtllib", pos)) != std::string_view::npos)
+			{
+				size_t lineEnd = text.find_first_of("\r\n", pos);
+				if (lineEnd == std::string_view::npos)
+					lineEnd = text.size();
+
+				bool lineStart = pos == 0 || text[pos - 1] == '\n' || text[pos - 1] == '\r';
+				std::string_view name = TrimWhitespace(text.substr(pos + 6, lineEnd - pos - 6));
+
+				if (lineStart && !name.empty())
+					result.push_back(folder / name);
+
+				pos = lineEnd;
+			}
+		}
+		else if (extension == ".gltf")
+		{
+			size_t pos = 0;
+			while ((pos = text.find("\"uri\"", pos)) != std::string_view::npos)
+			{
+				pos += 5;
+
+				size_t begin = text.find('"', text.find(':', pos));
+				if (begin == std::string_view::npos)
+					break;
+
+				size_t end = text.find('"', begin + 1);
+				if (end == std::string_view::npos)
+					break;
+
+				std::string_view uri = text.substr(begin + 1, end - begin - 1);
+				if (!uri.starts_with("data:"))
+					result.push_back(folder / uri);
+
+				pos = end + 1;
+			}
+		}
+
+		return result;
+	}
+
+	static uint64 GetMeshCacheKey(const FilePath& path)
+	{
+		Ref<MappedFile> file = MappedFile::Create(path);
+		if (!file)
+			return 0;
+
+		uint64 hash = Utils::HashFNV1a(file->Data(), file->Size());
+		hash = Utils::HashFNV1a(&ImportFlags, sizeof(ImportFlags), hash);
+		hash = Utils::HashFNV1a(&MeshCacheVersion, sizeof(MeshCacheVersion), hash);
+
+		// Changed or missing external files invalidate cache too
+		std::string_view text((const char*)file->Data(), file->Size());
+		for (const FilePath& dependency : GetMeshDependencies(path, text))
+		{
+			String name = dependency.filename().string();
+			int64 writeTime = FileSystem::GetLastWriteTime(dependency);
+
+			hash = Utils::HashFNV1a(name.data(), name.size(), hash);
+			hash = Utils::HashFNV1a(&writeTime, sizeof(writeTime), hash);
+		}
+
+		return hash;
+	}
+
+	static FilePath GetMeshCachePath(uint64 key)
+	{
+		FilePath cacheFolder = Application::Get().GetConfig().EngineResourcesPath / "Cache/Meshes";
+		return cacheFolder / std::format("{}.amesh", Utils::HashToString(key));
+	}
+
+	static std::atomic<uint32> s_MeshCacheTempCounter = 0;
+
+	static void WriteMeshCache(const FilePath& cachePath, uint64 key, const MeshCookedData& data)
+	{
+		ATN_PROFILE_FUNC();
+
+		MeshCacheWriter writer;
+		writer.Write(MeshCacheMagic);
+		writer.Write(MeshCacheVersion);
+		writer.Write(key);
+
+		writer.Write(data.BoundingBox.GetMinPoint());
+		writer.Write(data.BoundingBox.GetMaxPoint());
+
+		writer.Write<uint32>(data.Materials.size());
+		for (const auto& material : data.Materials)
+		{
+			writer.Write(material.Name);
+			writer.Write(material.Properties);
+			writer.Write(material.Albedo);
+			writer.Write(material.Roughness);
+			writer.Write(material.Metalness);
+			writer.Write(material.Emission);
+
+			for (const auto& texture : material.Textures)
+			{
+				writer.Write(texture.Source);
+				if (texture.Source == CookedTextureSource::NONE)
+					continue;
+
+				writer.Write(texture.Path);
+				writer.Write(texture.Width);
+				writer.Write(texture.Height);
+				writer.WriteArray(texture.EmbeddedData);
+			}
+		}
+
+		writer.Write<uint32>(data.SubMeshes.size());
+		for (const auto& subMesh : data.SubMeshes)
+		{
+			writer.Write(subMesh.Name);
+			writer.Write(subMesh.MaterialName);
+			writer.Write(subMesh.BoundingBox.GetMinPoint());
+			writer.Write(subMesh.BoundingBox.GetMaxPoint());
+			writer.Write(subMesh.UVDensity);
+			writer.WriteArray(subMesh.Vertices);
+			writer.WriteArray(subMesh.Indices);
+		}
+
+		writer.Write<uint32>(data.Bones.size());
+		for (const auto& bone : data.Bones)
+		{
+			writer.Write(bone.Name);
+			writer.Write(bone.OffsetMatrix);
+			writer.Write(bone.Index);
+			writer.WriteArray(std::span<const uint32>(bone.Children));
+		}
+
+		writer.Write<uint32>(data.Animations.size());
+		for (const auto& animation : data.Animations)
+		{
+			writer.Write(animation.Name);
+			writer.Write(animation.Duration);
+			writer.Write(animation.TicksPerSecond);
+
+			writer.Write<uint32>(animation.BoneNameToKeyFramesMap.size());
+			for (const auto& [boneName, keyFrames] : animation.BoneNameToKeyFramesMap)
+			{
+				writer.Write(boneName);
+				writer.WriteArray(std::span<const TranslationKey>(keyFrames.TranslationKeys));
+				writer.WriteArray(std::span<const RotationKey>(keyFrames.RotationKeys));
+				writer.WriteArray(std::span<const ScaleKey>(keyFrames.ScaleKeys));
+			}
+		}
+
+		// Other threads may have cache file mapped, so it is replaced instead of rewritten in place
+		FilePath tempPath = cachePath;
+		tempPath += std::format(".{}.tmp", s_MeshCacheTempCounter.fetch_add(1, std::memory_order_relaxed));
+
+		const std::vector<byte>& buffer = writer.GetBuffer();
+		if (!FileSystem::WriteFile(tempPath, (const char*)buffer.data(), buffer.size()))
+		{
+			ATN_CORE_WARN_TAG("StaticMesh", "Failed to write mesh cache '{}'", cachePath);
+			return;
+		}
+
+		// Cache with same key has same content, so failure to replace it is not an error
+		if (!FileSystem::Rename(tempPath, cachePath))
+			FileSystem::Remove(tempPath);
+	}
+
+	static bool ReadMeshCache(const FilePath& cachePath, uint64 key, MeshCookedData& data)
+	{
+		ATN_PROFILE_FUNC();
+
+		data.CacheFile = MappedFile::Create(cachePath);
+		if (!data.CacheFile)
+			return false;
+
+		MeshCacheReader reader(data.CacheFile->Data(), data.CacheFile->Size());
+
+		uint32 magic = 0, version = 0;
+		uint64 cachedKey = 0;
+		if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(cachedKey))
+			return false;
+
+		if (magic != MeshCacheMagic || version != MeshCacheVersion || cachedKey != key)
+			return false;
+
+		Vector3 min, max;
+		if (!reader.Read(min) || !reader.Read(max))
+			return false;
+
+		data.BoundingBox = AABB(min, max);
+
+		uint32 count;
+		if (!reader.Read(count))
+			return false;
+
+		data.Materials.resize(count);
+		for (auto& material : data.Materials)
+		{
+			bool success = reader.Read(material.Name) && reader.Read(material.Properties) && reader.Read(material.Albedo) &&
+				reader.Read(material.Roughness) && reader.Read(material.Metalness) && reader.Read(material.Emission);
+
+			if (!success)
+				return false;
+
+			for (auto& texture : material.Textures)
+			{
+				if (!reader.Read(texture.Source))
+					return false;
+
+				if (texture.Source == CookedTextureSource::NONE)
+					continue;
+
+				success = reader.Read(texture.Path) && reader.Read(texture.Width) && reader.Read(texture.Height) && reader.ReadArray(texture.EmbeddedData);
+				if (!success)
+					return false;
+			}
+		}
+
+		if (!reader.Read(count))
+			return false;
+
+		data.SubMeshes.resize(count);
+		for (auto& subMesh : data.SubMeshes)
+		{
+			bool success = reader.Read(subMesh.Name) && reader.Read(subMesh.MaterialName) && reader.Read(min) && reader.Read(max) &&
+				reader.Read(subMesh.UVDensity) && reader.ReadArray(subMesh.Vertices) && reader.ReadArray(subMesh.Indices);
+
+			if (!success)
+				return false;
+
+			subMesh.BoundingBox = AABB(min, max);
+		}
+
+		if (!reader.Read(count))
+			return false;
+
+		data.Bones.resize(count);
+		for (auto& bone : data.Bones)
+		{
+			if (!reader.Read(bone.Name) || !reader.Read(bone.OffsetMatrix) || !reader.Read(bone.Index) || !reader.ReadArray(bone.Children))
+				return false;
+		}
+
+		if (!reader.Read(count))
+			return false;
+
+		data.Animations.resize(count);
+		for (auto& animation : data.Animations)
+		{
+			uint32 channels;
+			if (!reader.Read(animation.Name) || !reader.Read(animation.Duration) || !reader.Read(animation.TicksPerSecond) || !reader.Read(channels))
+				return false;
+
+			animation.BoneNameToKeyFramesMap.reserve(channels);
+			for (uint32 i = 0; i < channels; ++i)
+			{
+				String boneName;
+				KeyFramesList keyFrames;
+
+				bool success = reader.Read(boneName) && reader.ReadArray(keyFrames.TranslationKeys) &&
+					reader.ReadArray(keyFrames.RotationKeys) && reader.ReadArray(keyFrames.ScaleKeys);
+
+				if (!success)
+					return false;
+
+				animation.BoneNameToKeyFramesMap[boneName] = std::move(keyFrames);
+			}
+		}
+
+		return true;
+	}
+
+	struct MaterialTextureSlotInfo
+	{
+		const char* Name;
+		const char* UseFlagName;
+		bool sRGB;
+		TextureCompression Compression;
+	};
+
+	// Normal maps store only XY in BC5, shaders reconstruct Z
+	static const MaterialTextureSlotInfo s_TextureSlots[TEXTURE_SLOT_COUNT] = {
+		{ "u_AlbedoMap",    "u_UseAlbedoMap",    true,  TextureCompression::BC7 },
+		{ "u_NormalMap",    "u_UseNormalMap",    false, TextureCompression::BC5 },
+		{ "u_RoughnessMap", "u_UseRoughnessMap", false, TextureCompression::BC4 },
+		{ "u_MetalnessMap", "u_UseMetalnessMap", false, TextureCompression::BC4 } };
+
+	struct TextureLoadTask
+	{
+		const CookedTexture* Source = nullptr;
+		TextureImportOptions Options;
+		FilePath Path;
+		uint64 CacheKey = 0;
+		// Index of task with the same key, that loads texture for both
+		uint32 SharedTaskIndex = UINT32_MAX;
+		DecodedImage Image;
+		bool Decoded = false;
+		Ref<Texture2D> Texture;
+	};
+
+	static void FindCachedTexture(TextureLoadTask& task, const FilePath& meshPath)
+	{
+		const CookedTexture& source = *task.Source;
+
+		if (source.Source == CookedTextureSource::EMBEDDED)
+		{
+			uint64 size = TextureImporter::GetEncodedSize(source.Width, source.Height);
+
+			task.Options.Name = source.Path;
+			task.CacheKey = TextureCache::GetKey(source.EmbeddedData.data(), size, task.Options);
+		}
+		else if (source.Source == CookedTextureSource::EXTERNAL)
+		{
+			task.Path = meshPath;
+			task.Path.replace_filename(source.Path);
+
+			if (!FileSystem::Exists(task.Path))
+			{
+				ATN_CORE_WARN_TAG("StaticMesh", "Invalid texture filepath '{}'", task.Path);
+				return;
+			}
+
+			task.CacheKey = TextureCache::GetKey(task.Path, task.Options);
+		}
+
+		if (task.CacheKey != 0)
+			task.Texture = TextureCache::Find(task.CacheKey);
+	}
+
+	static bool IsTextureDecodeNeeded(const TextureLoadTask& task)
+	{
+		return !task.Texture && task.CacheKey != 0 && task.SharedTaskIndex == UINT32_MAX;
+	}
+
+	static void DecodeTexture(TextureLoadTask& task)
+	{
+		if (!IsTextureDecodeNeeded(task))
+			return;
+
+		const CookedTexture& source = *task.Source;
+
+		if (source.Source == CookedTextureSource::EMBEDDED)
+			task.Decoded = TextureImporter::Decode(source.EmbeddedData.data(), source.Width, source.Height, task.Options, task.Image);
+		else
+			task.Decoded = TextureImporter::Decode(task.Path, task.Options, task.Image);
+
+		task.Image.CacheKey = task.CacheKey;
+	}
+
+	// Main thread only, decoded image is released
+	static void CreateTexture(TextureLoadTask& task)
+	{
+		if (task.Decoded)
+			task.Texture = TextureImporter::Create(task.Image, task.Options, task.Path);
+
+		task.Decoded = false;
+	}
+
+	// 'textures' - loaded textures for each slot of this material
+	static Ref<Material> LoadMaterial(const CookedMaterial& material, const TextureLoadTask* textures, bool animated)
+	{
+		Ref<Material> result;
+
+		if (animated)
+			result = Material::CreatePBRAnim(material.Name);
+		else
+			result = Material::CreatePBRStatic(material.Name);
+
+		if (material.Properties & HAS_ALBEDO)
+			result->Set("u_Albedo", material.Albedo);
+
+		if (material.Properties & HAS_ROUGHNESS)
+			result->Set("u_Roughness", material.Roughness);
+
+		if (material.Properties & HAS_METALNESS)
+			result->Set("u_Metalness", material.Metalness);
+
+		if (material.Properties & HAS_EMISSION)
+			result->Set("u_Emission", material.Emission);
+
+		for (uint32 i = 0; i < TEXTURE_SLOT_COUNT; ++i)
+		{
+			const Ref<Texture2D>& texture = textures[i].Texture;
+			if (texture)
+				result->Set(s_TextureSlots[i].Name, texture);
+
+			result->Set(s_TextureSlots[i].UseFlagName, uint32(texture != nullptr));
+		}
+
+		return result;
+	}
+
+	static Ref<VertexBuffer> LoadVertexBuffer(const CookedSubMesh& subMesh)
+	{
+		String name = GetResourceName(subMesh.Name);
+
+		Ref<IndexBuffer> indexBuffer = nullptr;
+		if (!subMesh.Indices.empty())
+		{
+			IndexBufferCreateInfo indexBufferInfo;
+			indexBufferInfo.Name = std::format("{}_IndexBuffer", name);
+			indexBufferInfo.Data = subMesh.Indices.data();
+			indexBufferInfo.Count = subMesh.Indices.size();
+			indexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
+
+			indexBuffer = IndexBuffer::Create(indexBufferInfo);
+		}
+
+		VertexBufferCreateInfo vertexBufferInfo;
+		vertexBufferInfo.Name = std::format("{}_VertexBuffer", name);
+		vertexBufferInfo.Data = subMesh.Vertices.data();
+		vertexBufferInfo.Size = subMesh.Vertices.size();
+		vertexBufferInfo.IndexBuffer = indexBuffer;
+		vertexBufferInfo.Flags = BufferMemoryFlags::GPU_ONLY;
+
+		return VertexBuffer::Create(vertexBufferInfo);
+	}
+
+	// Cooked mesh data and decoded textures, filled on any thread
+	struct MeshLoadData : public RefCounted
+	{
+		// Images are released when textures are created, unless load is dropped by AssetLoader::Shutdown
+		~MeshLoadData()
 		{
-			SubMesh subMesh = LoadSubMesh(aiscene, ainode->mMeshes[i], m_FilePath, localTransform, m_MaterialTable, m_Skeleton, m_AABB);
+			for (auto& task : Textures)
+				task.Image.Pixels.Release();
+		}
+
+		MeshCookedData Cooked;
+		std::vector<TextureLoadTask> Textures;
+		bool Loaded = false;
+		// Textures of async load that are not created yet
+		uint32 PendingTextures = 0;
+	};
+
+	static bool ReadOrImportMesh(const FilePath& path, uint64 cacheKey, MeshCookedData& data)
+	{
+		FilePath cachePath = GetMeshCachePath(cacheKey);
+
+		if (FileSystem::Exists(cachePath) && ReadMeshCache(cachePath, cacheKey, data))
+		{
+			ATN_CORE_TRACE_TAG("StaticMesh", "Create static mesh from '{}' (cooked)", path);
+			return true;
+		}
+
+		data = MeshCookedData();
+		if (!ImportMesh(path, data))
+			return false;
+
+		WriteMeshCache(cachePath, cacheKey, data);
+		ATN_CORE_TRACE_TAG("StaticMesh", "Create static mesh from '{}'", path);
+
+		return true;
+	}
+
+	// Fills texture tasks and finds already loaded textures, decoding is done separately,
+	// so each texture can be created and its pixels released as soon as it is decoded
+	static void PrepareTextures(const FilePath& meshPath, const MeshCookedData& data, std::vector<TextureLoadTask>& textures)
+	{
+		textures.resize(data.Materials.size() * TEXTURE_SLOT_COUNT);
+		for (uint32 i = 0; i < textures.size(); ++i)
+		{
+			const MaterialTextureSlotInfo& slot = s_TextureSlots[i % TEXTURE_SLOT_COUNT];
+
+			textures[i].Source = &data.Materials[i / TEXTURE_SLOT_COUNT].Textures[i % TEXTURE_SLOT_COUNT];
+			textures[i].Options.sRGB = slot.sRGB;
+			textures[i].Options.Compression = slot.Compression;
+			textures[i].Options.GenerateMipMaps = true;
+			textures[i].Options.Streaming = true;
+		}
+
+		JobSystem::ParallelFor(textures.size(), 1, [&meshPath, &textures](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+				FindCachedTexture(textures[i], meshPath);
+		});
+
+		// Texture referenced by several materials is decoded once
+		std::unordered_map<uint64, uint32> uniqueTextures;
+		for (uint32 i = 0; i < textures.size(); ++i)
+		{
+			if (textures[i].Texture || textures[i].CacheKey == 0)
+				continue;
+
+			auto [iter, inserted] = uniqueTextures.try_emplace(textures[i].CacheKey, i);
+			if (!inserted)
+				textures[i].SharedTaskIndex = iter->second;
+		}
+	}
+
+	// Decodes in batches of one texture per thread and creates each batch right away,
+	// so only one batch of decoded images is kept in memory
+	static void DecodeAndCreateTextures(std::vector<TextureLoadTask>& textures)
+	{
+		std::vector<uint32> decodeTasks;
+		for (uint32 i = 0; i < textures.size(); ++i)
+		{
+			if (IsTextureDecodeNeeded(textures[i]))
+				decodeTasks.push_back(i);
+		}
+
+		const uint32 batchSize = Math::Max(JobSystem::GetThreadsCount(), 1u);
+		for (uint32 first = 0; first < decodeTasks.size(); first += batchSize)
+		{
+			uint32 count = Math::Min<uint32>(batchSize, decodeTasks.size() - first);
+
+			JobSystem::ParallelFor(count, 1, [&textures, &decodeTasks, first](uint32 begin, uint32 end)
+			{
+				for (uint32 i = begin; i < end; ++i)
+					DecodeTexture(textures[decodeTasks[first + i]]);
+			});
+
+			for (uint32 i = 0; i < count; ++i)
+				CreateTexture(textures[decodeTasks[first + i]]);
+		}
+	}
+
+	bool StaticMesh::Load(const FilePath& path, uint64 cacheKey, MeshLoadData& data)
+	{
+		ATN_PROFILE_FUNC();
+
+		if (!ReadOrImportMesh(path, cacheKey, data.Cooked))
+			return false;
+
+		PrepareTextures(path, data.Cooked, data.Textures);
+		return true;
+	}
+
+	void StaticMesh::CreateResources(MeshLoadData& loadData)
+	{
+		ATN_PROFILE_FUNC();
+
+		const MeshCookedData& data = loadData.Cooked;
+		std::vector<TextureLoadTask>& textures = loadData.Textures;
+
+		bool animated = !data.Bones.empty();
+
+		m_AABB = data.BoundingBox;
+
+		if (animated)
+			m_Skeleton = Skeleton::Create(data.Bones);
+
+		for (auto& task : textures)
+		{
+			if (task.SharedTaskIndex != UINT32_MAX)
+				task.Texture = textures[task.SharedTaskIndex].Texture;
+		}
+
+		for (uint32 i = 0; i < data.Materials.size(); ++i)
+			m_MaterialTable->Add(LoadMaterial(data.Materials[i], &textures[i * TEXTURE_SLOT_COUNT], animated));
+
+		m_SubMeshes.reserve(data.SubMeshes.size());
+		for (const auto& cookedSubMesh : data.SubMeshes)
+		{
+			SubMesh subMesh;
+			subMesh.Name = cookedSubMesh.Name;
+			subMesh.MaterialName = cookedSubMesh.MaterialName;
+			subMesh.BoundingBox = cookedSubMesh.BoundingBox;
+			subMesh.UVDensity = cookedSubMesh.UVDensity;
+			subMesh.VertexBuffer = LoadVertexBuffer(cookedSubMesh);
+
 			m_SubMeshes.push_back(subMesh);
 		}
 
-		for (uint32 i = 0; i < ainode->mNumChildren; ++i)
+		if (m_Skeleton)
 		{
-			ProcessNode(aiscene, ainode->mChildren[i], localTransform);
+			std::vector<Ref<Animation>> animations(data.Animations.size());
+
+			for (uint32 i = 0; i < data.Animations.size(); ++i)
+			{
+				AnimationCreateInfo info = data.Animations[i];
+				info.Skeleton = m_Skeleton;
+				animations[i] = Animation::Create(info);
+			}
+
+			m_Animator = Animator::Create(animations, m_Skeleton);
 		}
 	}
 
 	Ref<StaticMesh> StaticMesh::Create(const FilePath& path)
 	{
-		const unsigned int flags =
-			aiProcess_GenUVCoords |
-			aiProcess_CalcTangentSpace |
-			aiProcess_GenSmoothNormals |
-			aiProcess_FixInfacingNormals |
-			aiProcess_GenBoundingBoxes |
-			aiProcess_FindInvalidData | 
+		ATN_PROFILE_FUNC();
 
-			aiProcess_SortByPType |
-			aiProcess_FindDegenerates |
-			aiProcess_ImproveCacheLocality |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_LimitBoneWeights |
+		uint64 cacheKey = GetMeshCacheKey(path);
+		if (cacheKey == 0)
+		{
+			ATN_CORE_ERROR_TAG("StaticMesh", "Failed to load mesh from '{}', file does not exist", path);
+			return nullptr;
+		}
 
-			aiProcess_RemoveRedundantMaterials |
-			aiProcess_OptimizeGraph |
-			aiProcess_OptimizeMeshes |
+		MeshLoadData data;
+		if (!Load(path, cacheKey, data))
+			return nullptr;
 
-			aiProcess_Triangulate |
-			aiProcess_EmbedTextures |
-			aiProcess_FlipUVs;
+		DecodeAndCreateTextures(data.Textures);
+
+		Ref<StaticMesh> result = Ref<StaticMesh>::Create();
+		result->m_FilePath = path;
+		result->m_Name = path.stem().string();
+		result->m_MaterialTable = Ref<MaterialTable>::Create();
+		result->CreateResources(data);
 
-		const aiScene* aiscene = aiImportFile(path.string().c_str(), flags);
+		return result;
+	}
 
-		if (aiscene == nullptr)
+	Ref<StaticMesh> StaticMesh::CreateAsync(const FilePath& path)
+	{
+		// Cache key hashes whole file, so it is computed on loader thread
+		if (!FileSystem::Exists(path))
 		{
-			const char* error = aiGetErrorString();
-			ATN_CORE_ERROR_TAG("StaticMesh", "Failed to load mesh from '{}'", path);
-			ATN_CORE_INFO("Error: {}", error);
+			ATN_CORE_ERROR_TAG("StaticMesh", "Failed to load mesh from '{}', file does not exist", path);
 			return nullptr;
 		}
 
@@ -507,26 +1227,112 @@ namespace Athena
 		result->m_FilePath = path;
 		result->m_Name = path.stem().string();
 		result->m_MaterialTable = Ref<MaterialTable>::Create();
+		result->m_Loading = true;
 
-		ATN_CORE_TRACE_TAG("StaticMesh", "Create static mesh from '{}'", path);
-
-		result->m_Skeleton = LoadSkeleton(aiscene);
-		result->ProcessNode(aiscene, aiscene->mRootNode, Matrix4::Identity());
+		Ref<MeshLoadData> data = Ref<MeshLoadData>::Create();
 
-		if (result->m_Skeleton)
+		auto finishMesh = [path, data, result]()
 		{
-			std::vector<Ref<Animation>> animations(aiscene->mNumAnimations);
+			if (data->Loaded)
+				result->CreateResources(*data);
+			else
+				ATN_CORE_ERROR_TAG("StaticMesh", "Failed to load mesh from '{}'", path);
 
-			for (uint32 i = 0; i < aiscene->mNumAnimations; ++i)
+			result->m_Loading = false;
+
+			std::vector<StaticMesh*> copies = std::move(result->m_PendingCopies);
+			result->m_PendingCopies.clear();
+
+			for (StaticMesh* copy : copies)
 			{
-				animations[i] = LoadAnimation(aiscene->mAnimations[i], result->m_Skeleton);
+				copy->m_LoadingSource = nullptr;
+				copy->CopyResources(result);
 			}
+		};
 
-			result->m_Animator = Animator::Create(animations, result->m_Skeleton);
-		}
+		AssetLoader::Submit([path, data]()
+		{
+			uint64 cacheKey = GetMeshCacheKey(path);
+			data->Loaded = cacheKey != 0 && Load(path, cacheKey, *data);
+		},
+		[data, finishMesh]()
+		{
+			// Extra count is released after all requests are submitted, requests may finish synchronously
+			data->PendingTextures = 1;
+			auto textureFinished = [data, finishMesh]()
+			{
+				data->PendingTextures--;
+				if (data->PendingTextures == 0)
+					finishMesh();
+			};
+
+			// Each texture is a separate request, so it is created and its pixels released
+			// as soon as it is decoded, instead of keeping all decoded textures until mesh is finished
+			for (uint32 i = 0; i < data->Textures.size(); ++i)
+			{
+				if (!data->Loaded || !IsTextureDecodeNeeded(data->Textures[i]))
+					continue;
 
-		aiReleaseImport(aiscene);
+				data->PendingTextures++;
+
+				AssetLoader::Submit([data, i]()
+				{
+					DecodeTexture(data->Textures[i]);
+				},
+				[data, i, textureFinished]()
+				{
+					CreateTexture(data->Textures[i]);
+					textureFinished();
+				});
+			}
+
+			textureFinished();
+		});
+
+		return result;
+	}
+
+	Ref<StaticMesh> StaticMesh::Copy(const Ref<StaticMesh>& other)
+	{
+		Ref<StaticMesh> result = Ref<StaticMesh>::Create();
+		result->m_FilePath = other->m_FilePath;
+		result->m_Name = other->m_Name;
+		result->m_MaterialTable = Ref<MaterialTable>::Create();
+
+		// Copy receives resources when loading is finished, copies of loading copy are registered on the same source
+		if (other->m_Loading)
+		{
+			Ref<StaticMesh> source = other->m_LoadingSource ? other->m_LoadingSource : other;
 
+			result->m_Loading = true;
+			result->m_LoadingSource = source;
+			source->m_PendingCopies.push_back(result.Raw());
+			return result;
+		}
+
+		result->CopyResources(other);
 		return result;
 	}
+
+	StaticMesh::~StaticMesh()
+	{
+		if (m_LoadingSource)
+		{
+			auto& copies = m_LoadingSource->m_PendingCopies;
+			copies.erase(std::find(copies.begin(), copies.end(), this));
+		}
+	}
+
+	void StaticMesh::CopyResources(const Ref<StaticMesh>& other)
+	{
+		m_AABB = other->m_AABB;
+		m_SubMeshes = other->m_SubMeshes;
+		m_Skeleton = other->m_Skeleton;
+		// Materials can be edited per copy, e.g. in play mode
+		m_MaterialTable = MaterialTable::Copy(other->m_MaterialTable);
+		m_Loading = false;
+
+		if (other->m_Animator)
+			m_Animator = Animator::Copy(other->m_Animator);
+	}
 }
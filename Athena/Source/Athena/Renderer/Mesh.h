@@ -11,12 +11,10 @@
 #include <vector>
 
 
-class aiScene;
-class aiNode;
-
-
 namespace Athena
 {
+	struct MeshLoadData;
+
 	struct StaticVertex
 	{
 		Vector3 Position;
@@ -64,12 +62,23 @@ namespace Athena
 		String Name;
 		String MaterialName;
 		Ref<VertexBuffer> VertexBuffer;
+		// In mesh space
+		AABB BoundingBox;
+		// Uv units per mesh space unit, 0 if submesh has no texture coordinates
+		float UVDensity = 0.f;
 	};
 
 	class ATHENA_API StaticMesh : public RefCounted
 	{
 	public:
 		static Ref<StaticMesh> Create(const FilePath& path);
+		// Returns immediately, mesh is imported on AssetLoader thread and has no submeshes
+		// until its GPU resources are created at the beginning of frame
+		static Ref<StaticMesh> CreateAsync(const FilePath& path);
+		// Shares GPU buffers and animations with 'other', creates own materials and Animator
+		static Ref<StaticMesh> Copy(const Ref<StaticMesh>& other);
+
+		~StaticMesh();
 
 		const std::vector<SubMesh>& GetAllSubMeshes() const { return m_SubMeshes; }
 
@@ -81,9 +90,13 @@ namespace Athena
 		const Ref<Animator>& GetAnimator() { return m_Animator; }
 
 		bool HasAnimations() const { return m_Animator != nullptr; }
+		bool IsLoading() const { return m_Loading; }
 
 	private:
-		void ProcessNode(const aiScene* aiscene, const aiNode* ainode, const Matrix4& parentTransform);
+		// CPU part of loading without texture decoding, can be called from any thread
+		static bool Load(const FilePath& path, uint64 cacheKey, MeshLoadData& data);
+		void CreateResources(MeshLoadData& data);
+		void CopyResources(const Ref<StaticMesh>& other);
 
 	private:
 		FilePath m_FilePath;
@@ -94,5 +107,11 @@ namespace Athena
 
 		Ref<Skeleton> m_Skeleton;
 		Ref<Animator> m_Animator;
+
+		bool m_Loading = false;
+		// Copies created while mesh is loading, copy unregisters itself when destroyed
+		std::vector<StaticMesh*> m_PendingCopies;
+		// Loading mesh this copy is waiting for
+		Ref<StaticMesh> m_LoadingSource;
 	};
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <span>
+#include <vector>
+
+
+namespace Athena
+{
+	// Arrays in cache are aligned, so that views into mapped file are aligned too
+	inline uint64 AlignMeshCacheOffset(uint64 offset)
+	{
+		const uint64 alignment = 16;
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	// Appends values, strings and aligned arrays to memory buffer of mesh cache file
+	class MeshCacheWriter
+	{
+	public:
+		template <typename T>
+		void Write(const T& value)
+		{
+			WriteBytes(&value, sizeof(T));
+		}
+
+		void Write(const String& str)
+		{
+			Write<uint32>(str.size());
+			WriteBytes(str.data(), str.size());
+		}
+
+		template <typename T>
+		void WriteArray(std::span<const T> data)
+		{
+			Write<uint64>(data.size());
+			m_Buffer.resize(AlignMeshCacheOffset(m_Buffer.size()));
+			WriteBytes(data.data(), data.size_bytes());
+		}
+
+		void WriteBytes(const void* data, uint64 size)
+		{
+			const byte* bytes = (const byte*)data;
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+		}
+
+		const std::vector<byte>& GetBuffer() const { return m_Buffer; }
+
+	private:
+		std::vector<byte> m_Buffer;
+	};
+
+	// Reads data written by MeshCacheWriter, every read is checked against buffer size,
+	// so truncated or corrupted cache fails to load instead of reading out of bounds
+	class MeshCacheReader
+	{
+	public:
+		MeshCacheReader(const byte* data, uint64 size)
+			: m_Data(data), m_Size(size) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			if (!CanRead(sizeof(T)))
+				return false;
+
+			memcpy(&value, m_Data + m_Offset, sizeof(T));
+			m_Offset += sizeof(T);
+			return true;
+		}
+
+		bool Read(String& str)
+		{
+			uint32 size;
+			if (!Read(size) || !CanRead(size))
+				return false;
+
+			str.assign((const char*)m_Data + m_Offset, size);
+			m_Offset += size;
+			return true;
+		}
+
+		// Returns view into source memory, no copy
+		template <typename T>
+		bool ReadArray(std::span<const T>& view)
+		{
+			uint64 count;
+			if (!Read(count))
+				return false;
+
+			m_Offset = AlignMeshCacheOffset(m_Offset);
+			if (count > m_Size / sizeof(T) || !CanRead(count * sizeof(T)))
+				return false;
+
+			view = std::span<const T>((const T*)(m_Data + m_Offset), count);
+			m_Offset += count * sizeof(T);
+			return true;
+		}
+
+		template <typename T>
+		bool ReadArray(std::vector<T>& vec)
+		{
+			std::span<const T> view;
+			if (!ReadArray(view))
+				return false;
+
+			vec.assign(view.begin(), view.end());
+			return true;
+		}
+
+	private:
+		bool CanRead(uint64 size) const { return m_Offset <= m_Size && size <= m_Size - m_Offset; }
+
+	private:
+		const byte* m_Data;
+		uint64 m_Size;
+		uint64 m_Offset = 0;
+	};
+}
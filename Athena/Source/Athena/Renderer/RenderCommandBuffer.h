@@ -5,10 +5,14 @@
 
 namespace Athena
 {
+	class RenderPass;
+
 	enum class RenderCommandBufferUsage
 	{
 		PRESENT = 1,
-		IMMEDIATE = 2
+		IMMEDIATE = 2,
+		// Recorded inside render pass on any job system thread, executed from primary command buffer
+		SECONDARY = 3
 	};
 
 	struct RenderCommandBufferCreateInfo
@@ -28,6 +32,10 @@ namespace Athena
 
 		virtual void Submit() = 0;
 
+		// SECONDARY usage only, renderPass must be begun with RenderPassContents::SECONDARY_COMMAND_BUFFERS
+		virtual void BeginSecondary(const Ref<RenderPass>& renderPass) = 0;
+		virtual void ExecuteSecondary(const Ref<RenderCommandBuffer>& secondary) = 0;
+
 	protected:
 		RenderCommandBufferCreateInfo m_Info;
 	};
@@ -49,6 +49,13 @@ namespace Athena
 		uint32 StencilClearColor = 1.f;
 	};
 
+	enum class RenderPassContents
+	{
+		INLINE = 0,
+		// Only secondary command buffers can be executed inside render pass
+		SECONDARY_COMMAND_BUFFERS = 1
+	};
+
 	class RenderPass;
 
 	struct RenderPassCreateInfo
@@ -67,7 +74,7 @@ namespace Athena
 		static Ref<RenderPass> Create(const RenderPassCreateInfo& info);
 		virtual ~RenderPass() = default;
 
-		virtual void Begin(const Ref<RenderCommandBuffer>& commandBuffer) = 0;
+		virtual void Begin(const Ref<RenderCommandBuffer>& commandBuffer, RenderPassContents contents = RenderPassContents::INLINE) = 0;
 		virtual void End(const Ref<RenderCommandBuffer>& commandBuffer) = 0;
 
 		virtual void Resize(uint32 width, uint32 height) = 0;
@@ -0,0 +1,231 @@
+#include "RenderProxyRegistry.h"
+
+#include "Athena/Math/Common.h"
+#include "Athena/Renderer/Renderer.h"
+#include "Athena/Renderer/TextureStreamer.h"
+
+#include <algorithm>
+
+
+namespace Athena
+{
+	Ref<RenderProxyRegistry> RenderProxyRegistry::Create()
+	{
+		return Ref<RenderProxyRegistry>::Create();
+	}
+
+	RenderProxyID RenderProxyRegistry::AddStaticMesh(const Ref<StaticMesh>& mesh, const Matrix4& transform)
+	{
+		RenderProxyID id;
+		if (!m_FreeIDs.empty())
+		{
+			id = m_FreeIDs.back();
+			m_FreeIDs.pop_back();
+		}
+		else
+		{
+			id = m_Proxies.size();
+			m_Proxies.emplace_back();
+		}
+
+		Proxy& proxy = m_Proxies[id];
+		proxy.Mesh = mesh;
+		proxy.Transform = transform;
+		proxy.Alive = true;
+
+		m_BatchesDirty = true;
+
+		return id;
+	}
+
+	void RenderProxyRegistry::Remove(RenderProxyID id)
+	{
+		ATN_CORE_ASSERT(id < m_Proxies.size() && m_Proxies[id].Alive);
+
+		Proxy& proxy = m_Proxies[id];
+		proxy.Mesh = nullptr;
+		proxy.Alive = false;
+
+		m_FreeIDs.push_back(id);
+		m_BatchesDirty = true;
+	}
+
+	void RenderProxyRegistry::SetTransform(RenderProxyID id, const Matrix4& transform)
+	{
+		ATN_CORE_ASSERT(id < m_Proxies.size() && m_Proxies[id].Alive);
+
+		Proxy& proxy = m_Proxies[id];
+		proxy.Transform = transform;
+
+		// Slots will be written on rebuild
+		if (m_BatchesDirty)
+			return;
+
+		const auto& subMeshes = proxy.Mesh->GetAllSubMeshes();
+		for (uint32 i = 0; i < subMeshes.size(); ++i)
+		{
+			uint32 slot = m_ProxySlots[proxy.SlotsOffset + i];
+			WriteInstance(slot, transform, subMeshes[i]);
+
+			for (uint32 frame = 0; frame < m_DirtySlots.size(); ++frame)
+			{
+				if (!m_FullUpload[frame])
+					m_DirtySlots[frame].push_back(slot);
+			}
+		}
+	}
+
+	void RenderProxyRegistry::Flush()
+	{
+		ATN_PROFILE_FUNC();
+
+		const uint32 framesInFlight = Renderer::GetFramesInFlight();
+		if (m_DirtySlots.size() != framesInFlight)
+		{
+			m_DirtySlots.resize(framesInFlight);
+			m_FullUpload.assign(framesInFlight, true);
+		}
+
+		if (m_BatchesDirty)
+			RebuildBatches();
+
+		const uint64 requiredSize = Math::Max<uint64>(m_InstanceTransforms.size(), 1) * sizeof(InstanceTransformData);
+
+		if (!m_InstanceBuffer)
+		{
+			VertexBufferCreateInfo info;
+			info.Name = "RenderProxiesInstanceBuffer";
+			info.Size = requiredSize;
+			info.Flags = BufferMemoryFlags::CPU_WRITEABLE;
+
+			m_InstanceBuffer = VertexBuffer::Create(info);
+		}
+		else if (m_InstanceBuffer->GetSize() < requiredSize)
+		{
+			uint64 newSize = requiredSize * 2;
+
+			ATN_CORE_WARN_TAG("Renderer", "{} allocating from {} to {}", m_InstanceBuffer->GetName(),
+				Utils::MemoryBytesToString(m_InstanceBuffer->GetSize()), Utils::MemoryBytesToString(newSize));
+
+			// All frame copies are recreated
+			m_InstanceBuffer->Resize(newSize);
+			m_FullUpload.assign(framesInFlight, true);
+		}
+
+		const uint32 frameIndex = Renderer::GetCurrentFrameIndex();
+		std::vector<uint32>& dirtySlots = m_DirtySlots[frameIndex];
+
+		if (m_FullUpload[frameIndex])
+		{
+			m_InstanceBuffer->UploadData(m_InstanceTransforms.data(), m_InstanceTransforms.size() * sizeof(InstanceTransformData));
+			m_FullUpload[frameIndex] = false;
+			dirtySlots.clear();
+			return;
+		}
+
+		if (dirtySlots.empty())
+			return;
+
+		std::sort(dirtySlots.begin(), dirtySlots.end());
+		dirtySlots.erase(std::unique(dirtySlots.begin(), dirtySlots.end()), dirtySlots.end());
+
+		// Upload contiguous ranges of changed slots
+		uint32 rangeStart = dirtySlots[0];
+		uint32 rangeEnd = rangeStart + 1;
+
+		for (uint32 i = 1; i <= dirtySlots.size(); ++i)
+		{
+			if (i < dirtySlots.size() && dirtySlots[i] == rangeEnd)
+			{
+				rangeEnd++;
+				continue;
+			}
+
+			uint64 offset = rangeStart * sizeof(InstanceTransformData);
+			uint64 size = (rangeEnd - rangeStart) * sizeof(InstanceTransformData);
+			m_InstanceBuffer->UploadData(&m_InstanceTransforms[rangeStart], size, offset);
+
+			if (i < dirtySlots.size())
+			{
+				rangeStart = dirtySlots[i];
+				rangeEnd = rangeStart + 1;
+			}
+		}
+
+		dirtySlots.clear();
+	}
+
+	void RenderProxyRegistry::RebuildBatches()
+	{
+		ATN_PROFILE_FUNC();
+
+		m_SubMeshRefs.clear();
+		m_SortEntries.clear();
+		m_ProxySlots.clear();
+		m_Batches.clear();
+
+		for (uint32 proxyIndex = 0; proxyIndex < m_Proxies.size(); ++proxyIndex)
+		{
+			Proxy& proxy = m_Proxies[proxyIndex];
+			if (!proxy.Alive)
+				continue;
+
+			const auto& subMeshes = proxy.Mesh->GetAllSubMeshes();
+			const auto& materialTable = proxy.Mesh->GetMaterialTable();
+
+			proxy.SlotsOffset = m_ProxySlots.size();
+
+			for (uint32 i = 0; i < subMeshes.size(); ++i)
+			{
+				Ref<Material> material = materialTable->Get(subMeshes[i].MaterialName);
+				uint64 key = DrawSortEntry::MakeKey(material->GetID(), subMeshes[i].VertexBuffer->GetID(), 0);
+
+				m_SortEntries.push_back({ key, (uint32)m_SubMeshRefs.size() });
+				m_SubMeshRefs.push_back({ proxyIndex, i });
+				m_ProxySlots.push_back(0);
+			}
+		}
+
+		// Slots are laid out in sorted order, so each batch is a contiguous range
+		DrawSortEntry::RadixSort(m_SortEntries, m_SortBuffer);
+
+		const uint32 instancesCount = m_SortEntries.size();
+		m_InstanceTransforms.resize(instancesCount);
+		m_InstanceBounds.resize(instancesCount);
+		m_InstanceUVDensities.resize(instancesCount);
+
+		for (uint32 slot = 0; slot < instancesCount; ++slot)
+		{
+			const SubMeshRef& ref = m_SubMeshRefs[m_SortEntries[slot].Index];
+			const Proxy& proxy = m_Proxies[ref.ProxyIndex];
+			const SubMesh& subMesh = proxy.Mesh->GetAllSubMeshes()[ref.SubMeshIndex];
+			Ref<Material> material = proxy.Mesh->GetMaterialTable()->Get(subMesh.MaterialName);
+
+			m_ProxySlots[proxy.SlotsOffset + ref.SubMeshIndex] = slot;
+			WriteInstance(slot, proxy.Transform, subMesh);
+
+			if (m_Batches.empty() || m_Batches.back().VertexBuffer != subMesh.VertexBuffer || m_Batches.back().Material != material)
+				m_Batches.push_back({ subMesh.VertexBuffer, material, slot, 0 });
+
+			m_Batches.back().InstanceCount++;
+		}
+
+		m_BatchesDirty = false;
+		m_FullUpload.assign(m_FullUpload.size(), true);
+
+		for (auto& dirtySlots : m_DirtySlots)
+			dirtySlots.clear();
+	}
+
+	void RenderProxyRegistry::WriteInstance(uint32 slot, const Matrix4& transform, const SubMesh& subMesh)
+	{
+		InstanceTransformData& data = m_InstanceTransforms[slot];
+		data.TRow0 = transform[0];
+		data.TRow1 = transform[1];
+		data.TRow2 = transform[2];
+		data.TRow3 = transform[3];
+
+		m_InstanceBounds[slot] = subMesh.BoundingBox.Transform(transform);
+		m_InstanceUVDensities[slot] = TextureStreamer::GetWorldUVDensity(subMesh.UVDensity, transform);
+	}
+}
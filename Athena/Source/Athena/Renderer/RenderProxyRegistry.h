@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include "Athena/Math/Matrix.h"
+
+#include "Athena/Renderer/AABB.h"
+#include "Athena/Renderer/DrawList.h"
+#include "Athena/Renderer/GPUBuffer.h"
+#include "Athena/Renderer/Material.h"
+#include "Athena/Renderer/Mesh.h"
+
+#include <vector>
+
+
+namespace Athena
+{
+	using RenderProxyID = uint32;
+
+	// Contiguous range of instance slots that share vertex buffer and material
+	struct RenderProxyBatch
+	{
+		Ref<VertexBuffer> VertexBuffer;
+		Ref<Material> Material;
+		uint32 FirstInstance;
+		uint32 InstanceCount;
+	};
+
+	// Retained render state of static meshes. Every submesh of a proxy owns an instance slot,
+	// slots are grouped into batches and rebuilt only when proxies are added or removed.
+	// Changed transforms are uploaded to instance buffer in Flush.
+	class ATHENA_API RenderProxyRegistry : public RefCounted
+	{
+	public:
+		static constexpr RenderProxyID InvalidID = UINT32_MAX;
+
+		static Ref<RenderProxyRegistry> Create();
+
+		RenderProxyID AddStaticMesh(const Ref<StaticMesh>& mesh, const Matrix4& transform);
+		void Remove(RenderProxyID id);
+		void SetTransform(RenderProxyID id, const Matrix4& transform);
+
+		const Ref<StaticMesh>& GetMesh(RenderProxyID id) const { return m_Proxies[id].Mesh; }
+
+		// Must be called once per frame before rendering
+		void Flush();
+
+		Ref<VertexBuffer> GetInstanceBuffer() const { return m_InstanceBuffer; }
+		const std::vector<RenderProxyBatch>& GetBatches() const { return m_Batches; }
+		// World space bounds, indexed by instance slot
+		const std::vector<AABB>& GetInstanceBounds() const { return m_InstanceBounds; }
+		// Uv units per world unit, indexed by instance slot
+		const std::vector<float>& GetInstanceUVDensities() const { return m_InstanceUVDensities; }
+		uint32 GetInstancesCount() const { return m_InstanceTransforms.size(); }
+
+	private:
+		void RebuildBatches();
+		void WriteInstance(uint32 slot, const Matrix4& transform, const SubMesh& subMesh);
+
+	private:
+		struct Proxy
+		{
+			Ref<StaticMesh> Mesh;
+			Matrix4 Transform;
+			uint32 SlotsOffset = 0;
+			bool Alive = false;
+		};
+
+		struct SubMeshRef
+		{
+			uint32 ProxyIndex;
+			uint32 SubMeshIndex;
+		};
+
+	private:
+		std::vector<Proxy> m_Proxies;
+		std::vector<RenderProxyID> m_FreeIDs;
+		bool m_BatchesDirty = false;
+
+		// Slot of each submesh, indexed by Proxy::SlotsOffset + submesh index
+		std::vector<uint32> m_ProxySlots;
+		std::vector<RenderProxyBatch> m_Batches;
+		std::vector<InstanceTransformData> m_InstanceTransforms;
+		std::vector<AABB> m_InstanceBounds;
+		std::vector<float> m_InstanceUVDensities;
+
+		std::vector<SubMeshRef> m_SubMeshRefs;
+		std::vector<DrawSortEntry> m_SortEntries;
+		std::vector<DrawSortEntry> m_SortBuffer;
+
+		// Instance buffer has copy per frame in flight, so changes are tracked per frame
+		std::vector<std::vector<uint32>> m_DirtySlots;
+		std::vector<bool> m_FullUpload;
+		Ref<VertexBuffer> m_InstanceBuffer;
+	};
+}
@@ -2,11 +2,13 @@
 
 #include "Athena/Core/Application.h"
 #include "Athena/Core/FileSystem.h"
+#include "Athena/Asset/AssetLoader.h"
 #include "Athena/Renderer/Font.h"
 #include "Athena/Renderer/RendererAPI.h"
 #include "Athena/Renderer/Shader.h"
 #include "Athena/Renderer/ComputePass.h"
 #include "Athena/Renderer/TextureGenerator.h"
+#include "Athena/Renderer/TextureStreamer.h"
 
 
 namespace Athena
@@ -36,6 +38,8 @@ namespace Athena
 	{
 		ATN_CORE_VERIFY(s_Data.RendererAPI == nullptr, "Renderer already exists!");
 
+		Timer timer;
+
 		s_Data.Config = config;
 		s_Data.CurrentFrameIndex = config.MaxFramesInFlight - 1;
 		s_Data.CurrentResourceFreeQueueIndex = s_Data.CurrentFrameIndex;
@@ -92,12 +96,18 @@ namespace Athena
 		s_Data.FullscreenVertexBuffer = VertexBuffer::Create(vertexBufInfo);
 
 		TextureGenerator::Init();
+		TextureStreamer::Init();
 		Font::Init();
+		AssetLoader::Init();
+
+		ATN_CORE_TIMING_TAG("Renderer", "Renderer::Init took {}", timer.ElapsedTime());
 	}
 
 	void Renderer::Shutdown()
 	{
+		AssetLoader::Shutdown();
 		Font::Shutdown();
+		TextureStreamer::Shutdown();
 		TextureGenerator::Shutdown();
 
 		s_Data.FullscreenVertexBuffer.Release();
@@ -133,6 +143,10 @@ namespace Athena
 
 		s_Data.RendererAPI->OnUpdate();
 		s_Data.RenderCommandBuffer->Begin();
+
+		// Loaded assets create GPU resources and resident images of streamed textures are replaced only between frames
+		AssetLoader::Update();
+		TextureStreamer::Update();
 	}
 
 	void Renderer::EndFrame()
@@ -267,6 +281,11 @@ namespace Athena
 		return s_Data.RendererAPI->GetMemoryUsage();
 	}
 
+	uint64 Renderer::GetMemoryBudget()
+	{
+		return s_Data.RendererAPI->GetMemoryBudget();
+	}
+
 	CommandQueue& Renderer::GetResourceFreeQueue()
 	{
 		return s_Data.ResourceFreeQueues[s_Data.CurrentResourceFreeQueueIndex];
@@ -58,6 +58,10 @@ namespace Athena
 
 		bool TimestampComputeAndGraphics;
 		float TimestampPeriod;
+
+		bool TextureCompressionBC;
+		bool ShaderOutputLayer;
+		bool InheritedQueries;
 	};
 
 	enum ShaderDef
@@ -134,6 +138,7 @@ namespace Athena
 		static Ref<RenderCommandBuffer> GetRenderCommandBuffer();
 		static const RenderCapabilities& GetRenderCaps();
 		static uint64 GetMemoryUsage();
+		static uint64 GetMemoryBudget();
 
 		static const FilePath& GetShaderPackDirectory();
 		static const FilePath& GetShaderCacheDirectory();
@@ -149,5 +154,9 @@ namespace Athena
 	{
 		Renderer::API API = Renderer::API::Vulkan;
 		uint32 MaxFramesInFlight = 3;
+
+		bool TextureStreaming = true;
+		// Memory for mips of streamed textures, if 0 it is derived from VRAM budget
+		uint64 TextureStreamingBudget = 0;
 	};
 }
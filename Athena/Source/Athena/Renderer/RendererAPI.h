@@ -38,6 +38,7 @@ namespace Athena
 
 		virtual void GetRenderCapabilities(RenderCapabilities& caps) = 0;
 		virtual uint64 GetMemoryUsage() = 0;
+		virtual uint64 GetMemoryBudget() = 0;
 		virtual void WaitDeviceIdle() = 0;
 	};
 }
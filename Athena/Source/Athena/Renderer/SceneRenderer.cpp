@@ -1,13 +1,39 @@
 #include "SceneRenderer.h"
 
+#include "Athena/Core/JobSystem.h"
 #include "Athena/Math/Projections.h"
 #include "Athena/Math/Transforms.h"
 #include "Athena/Renderer/Renderer.h"
 #include "Athena/Renderer/TextureGenerator.h"
+#include "Athena/Renderer/TextureStreamer.h"
+
+#include <bit>
 
 
 namespace Athena
 {
+	// Calls 'func' for each contiguous range of batch slots, which visibility has any bit of 'mask'
+	template <typename Func>
+	static void ForEachVisibleRange(const RenderProxyBatch& batch, const std::vector<uint8>& visibility, uint8 mask, Func func)
+	{
+		const uint32 end = batch.FirstInstance + batch.InstanceCount;
+		uint32 slot = batch.FirstInstance;
+
+		while (slot < end)
+		{
+			while (slot < end && !(visibility[slot] & mask))
+				slot++;
+
+			uint32 first = slot;
+			while (slot < end && (visibility[slot] & mask))
+				slot++;
+
+			if (slot != first)
+				func(first, slot - first);
+		}
+	}
+
+
 	Ref<SceneRenderer> SceneRenderer::Create()
 	{
 		Ref<SceneRenderer> renderer = Ref<SceneRenderer>::Create();
@@ -30,6 +56,18 @@ namespace Athena
 		profilerInfo.MaxPipelineQueriesCount = 1;
 		m_Profiler = GPUProfiler::Create(profilerInfo);
 
+		RenderCommandBufferCreateInfo secondaryInfo;
+		secondaryInfo.Usage = RenderCommandBufferUsage::SECONDARY;
+
+		secondaryInfo.Name = "DirShadowMapCommandBuffer";
+		m_DirShadowMapCommandBuffer = RenderCommandBuffer::Create(secondaryInfo);
+
+		secondaryInfo.Name = "GBufferCommandBuffer";
+		m_GBufferCommandBuffer = RenderCommandBuffer::Create(secondaryInfo);
+
+		secondaryInfo.Name = "Render2DCommandBuffer";
+		m_Render2DCommandBuffer = RenderCommandBuffer::Create(secondaryInfo);
+
 		m_CameraUBO = UniformBuffer::Create("CameraUBO", sizeof(CameraData));
 		m_RendererUBO = UniformBuffer::Create("RendererUBO", sizeof(RendererData));
 		m_ShadowsUBO = UniformBuffer::Create("ShadowsUBO", sizeof(ShadowsData));
@@ -37,8 +75,10 @@ namespace Athena
 		m_SSR_UBO = UniformBuffer::Create("SSR-UBO", sizeof(SSRData));
 
 		m_BonesSBO = StorageBuffer::Create("BonesSBO", 1 * sizeof(Matrix4), BufferMemoryFlags::CPU_WRITEABLE);
+		m_BonesOffsetsSBO = StorageBuffer::Create("BonesOffsetsSBO", 1 * sizeof(uint32), BufferMemoryFlags::CPU_WRITEABLE);
 		m_LightSBO = StorageBuffer::Create("LightSBO", sizeof(LightData), BufferMemoryFlags::CPU_WRITEABLE);
 		m_VisibleLightsSBO = StorageBuffer::Create("VisibleLightsSBO", sizeof(TileVisibleLights) * 1, BufferMemoryFlags::GPU_ONLY);
+		m_EmptyIrradianceSHSBO = StorageBuffer::Create("EmptyIrradianceSHSBO", sizeof(IrradianceSH), BufferMemoryFlags::GPU_ONLY);
 
 		m_BonesDataOffset = 0;
 
@@ -100,10 +140,13 @@ namespace Athena
 			m_DirShadowMapPass->Bake();
 
 
+			// Without gl_Layer output from vertex shader, geometry shader selects cascade layer
+			const bool vertexLayerOutput = Renderer::GetRenderCaps().ShaderOutputLayer;
+
 			PipelineCreateInfo pipelineInfo;
 			pipelineInfo.Name = "DirShadowMapStatic";
 			pipelineInfo.RenderPass = m_DirShadowMapPass;
-			pipelineInfo.Shader = Renderer::GetShaderPack()->Get("DirShadowMap_Static");
+			pipelineInfo.Shader = Renderer::GetShaderPack()->Get(vertexLayerOutput ? "DirShadowMap_Static" : "DirShadowMap_Static_GS");
 			pipelineInfo.VertexLayout = StaticVertex::GetLayout();
 			pipelineInfo.InstanceLayout = instanceLayout;
 			pipelineInfo.Topology = Topology::TRIANGLE_LIST;
@@ -116,14 +159,19 @@ namespace Athena
 			m_DirShadowMapStaticPipeline->Bake();
 
 			pipelineInfo.Name = "DirShadowMapAnim";
-			pipelineInfo.Shader = Renderer::GetShaderPack()->Get("DirShadowMap_Anim");
+			pipelineInfo.Shader = Renderer::GetShaderPack()->Get(vertexLayerOutput ? "DirShadowMap_Anim" : "DirShadowMap_Anim_GS");
 			pipelineInfo.VertexLayout = AnimVertex::GetLayout();
 
 			m_DirShadowMapAnimPipeline = Pipeline::Create(pipelineInfo);
 			m_DirShadowMapAnimPipeline->SetInput("u_ShadowsData", m_ShadowsUBO);
 			m_DirShadowMapAnimPipeline->SetInput("u_BonesData", m_BonesSBO);
+			m_DirShadowMapAnimPipeline->SetInput("u_BonesOffsetsData", m_BonesOffsetsSBO);
 			m_DirShadowMapAnimPipeline->Bake();
 
+			// Only push constants are used, to select cascade
+			m_DirShadowMapStaticMaterial = Material::Create(m_DirShadowMapStaticPipeline->GetInfo().Shader, "DirShadowMapStatic");
+			m_DirShadowMapAnimMaterial = Material::Create(m_DirShadowMapAnimPipeline->GetInfo().Shader, "DirShadowMapAnim");
+
 			TextureViewCreateInfo viewInfo;
 			viewInfo.LayerCount = ShaderDef::SHADOW_CASCADES_COUNT;
 			viewInfo.OverrideSampler = true;
@@ -174,6 +222,7 @@ namespace Athena
 			m_AnimGeometryPipeline = Pipeline::Create(pipelineInfo);
 			m_AnimGeometryPipeline->SetInput("u_CameraData", m_CameraUBO);
 			m_AnimGeometryPipeline->SetInput("u_BonesData", m_BonesSBO);
+			m_AnimGeometryPipeline->SetInput("u_BonesOffsetsData", m_BonesOffsetsSBO);
 			m_AnimGeometryPipeline->Bake();
 		}
 
@@ -399,6 +448,7 @@ namespace Athena
 			m_DeferredLightingPipeline->SetInput("u_BRDF_LUT", TextureGenerator::GetBRDF_LUT());
 			m_DeferredLightingPipeline->SetInput("u_EnvironmentMap", TextureGenerator::GetBlackTextureCube());
 			m_DeferredLightingPipeline->SetInput("u_IrradianceMap", TextureGenerator::GetBlackTextureCube());
+			m_DeferredLightingPipeline->SetInput("u_IrradianceSHData", m_EmptyIrradianceSHSBO);
 
 			m_DeferredLightingPipeline->SetInput("u_SceneDepth", m_GBufferPass->GetOutput("SceneDepth"));
 			m_DeferredLightingPipeline->SetInput("u_SceneAlbedo", m_GBufferPass->GetOutput("SceneAlbedo"));
@@ -645,6 +695,7 @@ namespace Athena
 				m_JFSilhouetteAnimPipeline = Pipeline::Create(pipelineInfo);
 				m_JFSilhouetteAnimPipeline->SetInput("u_CameraData", m_CameraUBO);
 				m_JFSilhouetteAnimPipeline->SetInput("u_BonesData", m_BonesSBO);
+				m_JFSilhouetteAnimPipeline->SetInput("u_BonesOffsetsData", m_BonesOffsetsSBO);
 				m_JFSilhouetteAnimPipeline->Bake();
 			}
 
@@ -1002,11 +1053,11 @@ namespace Athena
 	{
 		if (mesh->HasAnimations())
 		{
-			SubmitAnimMesh(m_AnimGeometryList, mesh, mesh->GetAnimator(), transform);
+			SubmitAnimMesh(m_AnimGeometryList, mesh, mesh->GetAnimator(), transform, true);
 		}
 		else
 		{
-			SubmitStaticMesh(m_StaticGeometryList, mesh, transform);
+			SubmitStaticMesh(m_StaticGeometryList, mesh, transform, true);
 		}
 	}
 
@@ -1014,15 +1065,20 @@ namespace Athena
 	{
 		if (mesh->HasAnimations())
 		{
-			SubmitAnimMesh(m_SelectAnimGeometryList, mesh, mesh->GetAnimator(), transform);
+			SubmitAnimMesh(m_SelectAnimGeometryList, mesh, mesh->GetAnimator(), transform, false);
 		}
 		else
 		{
-			SubmitStaticMesh(m_SelectStaticGeometryList, mesh, transform);
+			SubmitStaticMesh(m_SelectStaticGeometryList, mesh, transform, false);
 		}
 	}
 
-	void SceneRenderer::SubmitStaticMesh(DrawListStatic& list, const Ref<StaticMesh>& mesh, const Matrix4& transform)
+	void SceneRenderer::SubmitRenderProxies(const Ref<RenderProxyRegistry>& proxies)
+	{
+		m_RenderProxies = proxies;
+	}
+
+	void SceneRenderer::SubmitStaticMesh(DrawListStatic& list, const Ref<StaticMesh>& mesh, const Matrix4& transform, bool cull)
 	{
 		const auto& subMeshes = mesh->GetAllSubMeshes();
 		const auto& materialTable = mesh->GetMaterialTable();
@@ -1036,15 +1092,58 @@ namespace Athena
 			drawCall.Transform = transform;
 			drawCall.Material = material;
 
-			list.Push(drawCall);
+			if (!cull)
+			{
+				list.Push(drawCall);
+				continue;
+			}
+
+			AABB boundingBox = subMeshes[i].BoundingBox.Transform(transform);
+
+			if (m_CameraFrustum.IsVisible(boundingBox))
+			{
+				list.Push(drawCall);
+				RequestTextureMips(material, boundingBox, subMeshes[i].UVDensity, transform);
+			}
+			else
+			{
+				m_CulledMeshes++;
+			}
+
+			if (material->GetFlag(MaterialFlag::CAST_SHADOWS))
+				m_StaticShadowCasters.push_back({ drawCall, boundingBox });
 		}
 	}
 
-	void SceneRenderer::SubmitAnimMesh(DrawListAnim& list, const Ref<StaticMesh>& mesh, const Ref<Animator>& animator, const Matrix4& transform)
+	void SceneRenderer::SubmitAnimMesh(DrawListAnim& list, const Ref<StaticMesh>& mesh, const Ref<Animator>& animator, const Matrix4& transform, bool cull)
 	{
 		const auto& subMeshes = mesh->GetAllSubMeshes();
 		const auto& materialTable = mesh->GetMaterialTable();
 
+		// Skinned vertices may leave their submesh bounds, so whole mesh bounds are tested
+		AABB boundingBox = mesh->GetBoundingBox().Transform(transform);
+		bool visible = !cull || m_CameraFrustum.IsVisible(boundingBox);
+
+		if (!visible)
+			m_CulledAnimMeshes += subMeshes.size();
+
+		// Bones are uploaded once per animator, all submeshes share them
+		uint32 bonesOffset;
+		auto iter = m_AnimatorBonesOffsets.find(animator.Raw());
+		if (iter != m_AnimatorBonesOffsets.end())
+		{
+			bonesOffset = iter->second;
+		}
+		else
+		{
+			const auto& bones = animator->GetBoneTransforms();
+			m_BonesSBO.Push(bones.data(), bones.size() * sizeof(Matrix4));
+
+			bonesOffset = m_BonesDataOffset;
+			m_BonesDataOffset += bones.size();
+			m_AnimatorBonesOffsets[animator.Raw()] = bonesOffset;
+		}
+
 		for (uint32 i = 0; i < subMeshes.size(); ++i)
 		{
 			Ref<Material> material = materialTable->Get(subMeshes[i].MaterialName);
@@ -1053,17 +1152,32 @@ namespace Athena
 			drawCall.VertexBuffer = subMeshes[i].VertexBuffer;
 			drawCall.Transform = transform;
 			drawCall.Material = material;
-			drawCall.BonesOffset = m_BonesDataOffset;
+			drawCall.BonesOffset = bonesOffset;
 
-			const auto& bones = animator->GetBoneTransforms();
-			m_BonesSBO.Push(bones.data(), bones.size() * sizeof(Matrix4));
+			if (visible)
+			{
+				list.Push(drawCall);
 
-			m_BonesDataOffset += bones.size();
+				if (cull)
+					RequestTextureMips(material, boundingBox, subMeshes[i].UVDensity, transform);
+			}
 
-			list.Push(drawCall);
+			if (cull && material->GetFlag(MaterialFlag::CAST_SHADOWS))
+				m_AnimShadowCasters.push_back({ drawCall, boundingBox });
 		}
 	}
 
+	void SceneRenderer::RequestTextureMips(const Ref<Material>& material, const AABB& boundingBox, float uvDensity, const Matrix4& transform)
+	{
+		if (material->GetStreamedTextures().empty())
+			return;
+
+		float worldUVDensity = TextureStreamer::GetWorldUVDensity(uvDensity, transform);
+		float screenSize = TextureStreamer::GetUVScreenSize(boundingBox, worldUVDensity, m_CameraData.Position, m_ProjectionScale);
+
+		TextureStreamer::RequestMaterial(material, screenSize);
+	}
+
 	void SceneRenderer::SubmitLightEnvironment(const LightEnvironment& lightEnv)
 	{
 		m_LightData.DirectionalLightCount = lightEnv.DirectionalLights.size();
@@ -1109,6 +1223,8 @@ namespace Athena
 			}
 		}
 
+		m_DirShadowsEnabled = castsShadows;
+
 		for (uint32 i = 0; i < m_LightData.PointLightCount; ++i)
 		{
 			m_LightData.PointLights[i] = lightEnv.PointLights[i];
@@ -1124,18 +1240,32 @@ namespace Athena
 		m_RendererData.EnvironmentIntensity = lightEnv.EnvironmentMapIntensity;
 		m_RendererData.EnvironmentLOD = lightEnv.EnvironmentMapLOD;
 
+		m_RendererData.EnvironmentIrradianceSH = 0;
+
 		if (lightEnv.EnvironmentMap)
 		{
-			auto irradianceMap = lightEnv.EnvironmentMap->GetIrradianceTexture();
 			auto environmentMap = lightEnv.EnvironmentMap->GetEnvironmentTexture();
 
-			m_DeferredLightingPipeline->SetInput("u_IrradianceMap", irradianceMap);
+			// Irradiance cubemap is not baked in SH mode
+			if (lightEnv.EnvironmentMap->GetIrradianceMode() == EnvironmentIrradianceMode::SPHERICAL_HARMONICS && !lightEnv.EnvironmentMap->IsEmpty())
+			{
+				m_RendererData.EnvironmentIrradianceSH = 1;
+				m_DeferredLightingPipeline->SetInput("u_IrradianceMap", TextureGenerator::GetBlackTextureCube());
+				m_DeferredLightingPipeline->SetInput("u_IrradianceSHData", lightEnv.EnvironmentMap->GetIrradianceSH());
+			}
+			else
+			{
+				m_DeferredLightingPipeline->SetInput("u_IrradianceMap", lightEnv.EnvironmentMap->GetIrradianceTexture());
+				m_DeferredLightingPipeline->SetInput("u_IrradianceSHData", m_EmptyIrradianceSHSBO);
+			}
+
 			m_DeferredLightingPipeline->SetInput("u_EnvironmentMap", environmentMap);
 			m_SkyboxPipeline->SetInput("u_EnvironmentMap", environmentMap);
 		}
 		else
 		{
 			m_DeferredLightingPipeline->SetInput("u_IrradianceMap", TextureGenerator::GetBlackTextureCube());
+			m_DeferredLightingPipeline->SetInput("u_IrradianceSHData", m_EmptyIrradianceSHSBO);
 			m_DeferredLightingPipeline->SetInput("u_EnvironmentMap", TextureGenerator::GetBlackTextureCube());
 			m_SkyboxPipeline->SetInput("u_EnvironmentMap", TextureGenerator::GetBlackTextureCube());
 		}
@@ -1156,6 +1286,8 @@ namespace Athena
 		m_CameraData.FarClip = cameraInfo.FarClip;
 		m_CameraData.FOV = cameraInfo.FOV;
 
+		m_CameraFrustum = Frustum(m_CameraData.ViewProjection);
+
 		float projX = m_CameraData.InverseProjection[0][0];
 		float projY = m_CameraData.InverseProjection[1][1];
 		m_CameraData.ProjInfo = Vector4(2.0, 2.0, -1.0, -1.0) * Vector4(projX, projY, projX, projY);
@@ -1183,6 +1315,7 @@ namespace Athena
 		m_HBAOData.BlurSharpness = m_Settings.AOSettings.BlurSharpness;
 
 		float projScale = float(m_ViewportSize.y) / (Math::Tan(cameraInfo.FOV * 0.5f) * 2.0f);
+		m_ProjectionScale = projScale;
 		float radius = m_Settings.AOSettings.Radius;
 		m_HBAOData.NegInvR2 = -1.f / (radius * radius);
 		m_HBAOData.RadiusToScreen = radius * 0.5f * projScale / 4.f;
@@ -1206,28 +1339,45 @@ namespace Athena
 		bool hasSelectedGeometry = m_SelectStaticGeometryList.Size() != 0 || m_SelectAnimGeometryList.Size() != 0;
 		Antialising antialising = GetAntialising();
 
+		// Geometry passes execute secondary command buffers, query can not be active without inherited queries
+		bool pipelineStatsQuery = Renderer::GetRenderCaps().InheritedQueries;
+
 		m_Profiler->Reset();
-		m_Profiler->BeginPipelineStatsQuery();
+		if (pipelineStatsQuery)
+			m_Profiler->BeginPipelineStatsQuery();
 
 		{
 			ATN_PROFILE_SCOPE("SceneRenderer::PreProcessMeshes");
 
-			m_StaticGeometryList.Sort();
-			m_AnimGeometryList.Sort();
+			m_StaticGeometryList.Sort(m_CameraData.Position);
+			m_AnimGeometryList.Sort(m_CameraData.Position);
 
-			m_SelectStaticGeometryList.Sort();
-			m_SelectAnimGeometryList.Sort();
+			m_SelectStaticGeometryList.Sort(m_CameraData.Position);
+			m_SelectAnimGeometryList.Sort(m_CameraData.Position);
+
+			CullShadowCasters();
 
 			CalculateInstanceTransforms();
+
+			if (m_RenderProxies)
+			{
+				m_RenderProxies->Flush();
+				CullRenderProxies();
+			}
 		}
 
 		{
 			ATN_PROFILE_SCOPE("SceneRenderer::UploadData");
 
 			m_BonesSBO.Flush();
+			m_BonesOffsetsSBO.Flush();
 			m_TransformsStorage.Flush();
 			Renderer::BindInstanceRateBuffer(m_RenderCommandBuffer, m_TransformsStorage.Get());
 
+			uint64 dynamicBuffersSize = m_BonesSBO.GetCapacity() + m_BonesOffsetsSBO.GetCapacity() + m_TransformsStorage.GetCapacity();
+			m_Statistics.DynamicBuffersMemory = dynamicBuffersSize * Renderer::GetFramesInFlight();
+			m_Statistics.DynamicBuffersUpload = m_BonesSBO.GetUploadedSize() + m_BonesOffsetsSBO.GetUploadedSize() + m_TransformsStorage.GetUploadedSize();
+
 			m_CameraUBO->UploadData(&m_CameraData, sizeof(CameraData));
 			m_RendererUBO->UploadData(&m_RendererData, sizeof(RendererData));
 			m_LightSBO->UploadData(&m_LightData, sizeof(LightData));
@@ -1236,6 +1386,20 @@ namespace Athena
 			m_SSR_UBO->UploadData(&m_SSRData, sizeof(SSRData));
 		}
 
+		{
+			ATN_PROFILE_SCOPE("SceneRenderer::RecordSecondaryCommandBuffers");
+
+			// Geometry passes are recorded on worker threads, 2D callback stays on this thread.
+			// Primary command buffer only begins passes and executes recorded commands.
+			JobCounter counter;
+			JobSystem::Schedule([this]() { RecordDirShadowMapPass(); }, &counter);
+			JobSystem::Schedule([this]() { RecordGBufferPass(); }, &counter);
+
+			RecordRender2DPass();
+
+			JobSystem::Wait(counter);
+		}
+
 		DirShadowMapPass();
 		GBufferPass();
 		HiZPass();
@@ -1265,16 +1429,41 @@ namespace Athena
 		else if (antialising == Antialising::SMAA)
 			SMAAPass();
 
-		m_Statistics.PipelineStats = m_Profiler->EndPipelineStatsQuery();
-		m_Statistics.Meshes = m_StaticGeometryList.Size();
-		m_Statistics.Instances = m_StaticGeometryList.GetInstancesCount();
+		if (pipelineStatsQuery)
+			m_Statistics.PipelineStats = m_Profiler->EndPipelineStatsQuery();
+		else
+			m_Statistics.PipelineStats = PipelineStatistics();
+
+		m_Statistics.Meshes += m_StaticGeometryList.Size();
+		m_Statistics.Instances += m_StaticGeometryList.GetInstancesCount() + m_AnimGeometryList.GetInstancesCount();
 		m_Statistics.AnimMeshes = m_AnimGeometryList.Size();
+		m_Statistics.CulledMeshes += m_CulledMeshes;
+		m_Statistics.CulledAnimMeshes = m_CulledAnimMeshes;
+
+		uint32 shadowCasters = 0;
+		for (uint32 i = 0; i < ShaderDef::SHADOW_CASCADES_COUNT; ++i)
+		{
+			shadowCasters += m_ShadowStaticGeometryLists[i].Size() + m_ShadowAnimGeometryLists[i].Size();
+
+			m_ShadowStaticGeometryLists[i].Clear();
+			m_ShadowAnimGeometryLists[i].Clear();
+		}
+
+		uint32 totalCasters = (m_StaticShadowCasters.size() + m_AnimShadowCasters.size()) * ShaderDef::SHADOW_CASCADES_COUNT;
+		m_Statistics.ShadowCasters += shadowCasters;
+		m_Statistics.CulledShadowCasters += m_DirShadowsEnabled ? totalCasters - shadowCasters : 0;
 
 		m_StaticGeometryList.Clear();
 		m_AnimGeometryList.Clear();
 		m_SelectStaticGeometryList.Clear();
 		m_SelectAnimGeometryList.Clear();
+		m_StaticShadowCasters.clear();
+		m_AnimShadowCasters.clear();
+		m_RenderProxies = nullptr;
 		m_BonesDataOffset = 0;
+		m_AnimatorBonesOffsets.clear();
+		m_CulledMeshes = 0;
+		m_CulledAnimMeshes = 0;
 	}
 
 	void SceneRenderer::DirShadowMapPass()
@@ -1282,22 +1471,8 @@ namespace Athena
 		auto commandBuffer = m_RenderCommandBuffer;
 
 		m_Profiler->BeginTimeQuery();
-		m_DirShadowMapPass->Begin(commandBuffer);
-
-		Renderer::BeginDebugRegion(commandBuffer, "StaticGeometry", { 0.8f, 0.4f, 0.2f, 1.f });
-		{
-			m_DirShadowMapStaticPipeline->Bind(commandBuffer);
-			m_StaticGeometryList.FlushNoMaterials(commandBuffer, m_DirShadowMapStaticPipeline, true);
-		}
-		Renderer::EndDebugRegion(commandBuffer);
-
-		Renderer::BeginDebugRegion(commandBuffer, "AnimatedGeometry", { 0.8f, 0.4f, 0.8f, 1.f });
-		{
-			m_DirShadowMapAnimPipeline->Bind(commandBuffer);
-			m_AnimGeometryList.FlushNoMaterials(commandBuffer, m_DirShadowMapAnimPipeline, true);
-		}
-		Renderer::EndDebugRegion(commandBuffer);
-
+		m_DirShadowMapPass->Begin(commandBuffer, RenderPassContents::SECONDARY_COMMAND_BUFFERS);
+		commandBuffer->ExecuteSecondary(m_DirShadowMapCommandBuffer);
 		m_DirShadowMapPass->End(commandBuffer);
 		m_Profiler->EndTimeQuery(&m_Statistics.DirShadowMapPass);
 	}
@@ -1307,22 +1482,8 @@ namespace Athena
 		auto commandBuffer = m_RenderCommandBuffer;
 
 		m_Profiler->BeginTimeQuery();
-		m_GBufferPass->Begin(commandBuffer);
-
-		Renderer::BeginDebugRegion(commandBuffer, "StaticGeometry", { 0.8f, 0.4f, 0.2f, 1.f });
-		{
-			m_StaticGeometryPipeline->Bind(commandBuffer);
-			m_StaticGeometryList.Flush(commandBuffer, m_StaticGeometryPipeline);
-		}
-		Renderer::EndDebugRegion(commandBuffer);
-
-		Renderer::BeginDebugRegion(commandBuffer, "AnimatedGeometry", { 0.8f, 0.4f, 0.8f, 1.f });
-		{
-			m_AnimGeometryPipeline->Bind(commandBuffer);
-			m_AnimGeometryList.Flush(commandBuffer, m_AnimGeometryPipeline);
-		}
-		Renderer::EndDebugRegion(commandBuffer);
-
+		m_GBufferPass->Begin(commandBuffer, RenderPassContents::SECONDARY_COMMAND_BUFFERS);
+		commandBuffer->ExecuteSecondary(m_GBufferCommandBuffer);
 		m_GBufferPass->End(commandBuffer);
 		m_Profiler->EndTimeQuery(&m_Statistics.GBufferPass);
 	}
@@ -1623,10 +1784,8 @@ namespace Athena
 		auto commandBuffer = m_RenderCommandBuffer;
 
 		m_Profiler->BeginTimeQuery();
-		m_Render2DPass->Begin(commandBuffer);
-		{
-			m_Render2DCallback();
-		}
+		m_Render2DPass->Begin(commandBuffer, RenderPassContents::SECONDARY_COMMAND_BUFFERS);
+		commandBuffer->ExecuteSecondary(m_Render2DCommandBuffer);
 		m_Render2DPass->End(commandBuffer);
 		m_Profiler->EndTimeQuery(&m_Statistics.Render2DPass);
 	}
@@ -1658,6 +1817,127 @@ namespace Athena
 		m_Profiler->EndTimeQuery(&m_Statistics.AAPass);
 	}
 
+	void SceneRenderer::RecordDirShadowMapPass()
+	{
+		ATN_PROFILE_FUNC();
+
+		auto commandBuffer = m_DirShadowMapCommandBuffer;
+
+		// Secondary command buffer does not inherit bound state
+		commandBuffer->BeginSecondary(m_DirShadowMapPass);
+		Renderer::BindInstanceRateBuffer(commandBuffer, m_TransformsStorage.Get());
+
+		// Cascade is passed in push constants, vertex (or geometry) shader writes it to gl_Layer
+		Renderer::BeginDebugRegion(commandBuffer, "StaticGeometry", { 0.8f, 0.4f, 0.2f, 1.f });
+		{
+			m_DirShadowMapStaticPipeline->Bind(commandBuffer);
+			for (uint32 i = 0; i < ShaderDef::SHADOW_CASCADES_COUNT; ++i)
+			{
+				m_DirShadowMapStaticMaterial->Set("u_CascadeIndex", i);
+				m_ShadowStaticGeometryLists[i].FlushShadows(commandBuffer, m_DirShadowMapStaticPipeline, m_DirShadowMapStaticMaterial);
+			}
+
+			if (m_RenderProxies)
+			{
+				Renderer::BindInstanceRateBuffer(commandBuffer, m_RenderProxies->GetInstanceBuffer());
+
+				for (uint32 i = 0; i < ShaderDef::SHADOW_CASCADES_COUNT; ++i)
+				{
+					m_DirShadowMapStaticMaterial->Set("u_CascadeIndex", i);
+
+					for (const auto& batch : m_RenderProxies->GetBatches())
+					{
+						if (!batch.Material->GetFlag(MaterialFlag::CAST_SHADOWS))
+							continue;
+
+						ForEachVisibleRange(batch, m_RenderProxyVisibility, 1 << (i + 1), [&](uint32 first, uint32 count)
+						{
+							Renderer::RenderGeometryInstanced(commandBuffer, m_DirShadowMapStaticPipeline, batch.VertexBuffer, m_DirShadowMapStaticMaterial, count, first);
+						});
+					}
+				}
+
+				Renderer::BindInstanceRateBuffer(commandBuffer, m_TransformsStorage.Get());
+			}
+		}
+		Renderer::EndDebugRegion(commandBuffer);
+
+		Renderer::BeginDebugRegion(commandBuffer, "AnimatedGeometry", { 0.8f, 0.4f, 0.8f, 1.f });
+		{
+			m_DirShadowMapAnimPipeline->Bind(commandBuffer);
+			for (uint32 i = 0; i < ShaderDef::SHADOW_CASCADES_COUNT; ++i)
+			{
+				m_DirShadowMapAnimMaterial->Set("u_CascadeIndex", i);
+				m_ShadowAnimGeometryLists[i].FlushShadows(commandBuffer, m_DirShadowMapAnimPipeline, m_DirShadowMapAnimMaterial);
+			}
+		}
+		Renderer::EndDebugRegion(commandBuffer);
+
+		commandBuffer->End();
+	}
+
+	void SceneRenderer::RecordGBufferPass()
+	{
+		ATN_PROFILE_FUNC();
+
+		auto commandBuffer = m_GBufferCommandBuffer;
+
+		commandBuffer->BeginSecondary(m_GBufferPass);
+		Renderer::BindInstanceRateBuffer(commandBuffer, m_TransformsStorage.Get());
+
+		Renderer::BeginDebugRegion(commandBuffer, "StaticGeometry", { 0.8f, 0.4f, 0.2f, 1.f });
+		{
+			m_StaticGeometryPipeline->Bind(commandBuffer);
+			m_StaticGeometryList.Flush(commandBuffer, m_StaticGeometryPipeline);
+
+			if (m_RenderProxies)
+			{
+				Renderer::BindInstanceRateBuffer(commandBuffer, m_RenderProxies->GetInstanceBuffer());
+
+				Ref<Material> boundMaterial;
+				for (const auto& batch : m_RenderProxies->GetBatches())
+				{
+					ForEachVisibleRange(batch, m_RenderProxyVisibility, 1, [&](uint32 first, uint32 count)
+					{
+						if (batch.Material != boundMaterial)
+						{
+							boundMaterial = batch.Material;
+							boundMaterial->Bind(commandBuffer);
+						}
+
+						Renderer::RenderGeometryInstanced(commandBuffer, m_StaticGeometryPipeline, batch.VertexBuffer, batch.Material, count, first);
+						m_Statistics.Instances++;
+					});
+				}
+
+				Renderer::BindInstanceRateBuffer(commandBuffer, m_TransformsStorage.Get());
+			}
+		}
+		Renderer::EndDebugRegion(commandBuffer);
+
+		Renderer::BeginDebugRegion(commandBuffer, "AnimatedGeometry", { 0.8f, 0.4f, 0.8f, 1.f });
+		{
+			m_AnimGeometryPipeline->Bind(commandBuffer);
+			m_AnimGeometryList.Flush(commandBuffer, m_AnimGeometryPipeline);
+		}
+		Renderer::EndDebugRegion(commandBuffer);
+
+		commandBuffer->End();
+	}
+
+	void SceneRenderer::RecordRender2DPass()
+	{
+		if (!m_Render2DCallback)
+			return;
+
+		ATN_PROFILE_FUNC();
+
+		// User callback records with SceneRenderer2D, which is bound to this command buffer
+		m_Render2DCommandBuffer->BeginSecondary(m_Render2DPass);
+		m_Render2DCallback();
+		m_Render2DCommandBuffer->End();
+	}
+
 	void SceneRenderer::CalculateCascadeLightSpaces(DirectionalLight& light)
 	{
 		float cameraNear = m_CameraData.NearClip;
@@ -1758,6 +2038,7 @@ namespace Athena
 			lightProjection[3] += roundOffset;
 
 			m_ShadowsData.DirLightViewProjection[layer] = lightView * lightProjection;
+			m_CascadeFrustums[layer] = Frustum(m_ShadowsData.DirLightViewProjection[layer]);
 
 			frustumSize = Math::Max(frustumSize, maxExtents.z - minExtents.z);
 
@@ -1771,20 +2052,148 @@ namespace Athena
 	void SceneRenderer::CalculateInstanceTransforms()
 	{
 		std::vector<InstanceTransformData> transformData;
+		std::vector<uint32> bonesOffsets;
 
 		m_StaticGeometryList.SetInstanceOffset(0);
 		m_StaticGeometryList.EmplaceInstanceTransforms(transformData);
 
 		m_AnimGeometryList.SetInstanceOffset(transformData.size());
-		m_AnimGeometryList.EmplaceInstanceTransforms(transformData);
+		m_AnimGeometryList.EmplaceInstanceTransforms(transformData, bonesOffsets);
 
 		m_SelectStaticGeometryList.SetInstanceOffset(transformData.size());
 		m_SelectStaticGeometryList.EmplaceInstanceTransforms(transformData);
 
 		m_SelectAnimGeometryList.SetInstanceOffset(transformData.size());
-		m_SelectAnimGeometryList.EmplaceInstanceTransforms(transformData);
+		m_SelectAnimGeometryList.EmplaceInstanceTransforms(transformData, bonesOffsets);
+
+		for (uint32 i = 0; i < ShaderDef::SHADOW_CASCADES_COUNT; ++i)
+		{
+			m_ShadowStaticGeometryLists[i].SetInstanceOffset(transformData.size());
+			m_ShadowStaticGeometryLists[i].EmplaceInstanceTransforms(transformData);
+
+			m_ShadowAnimGeometryLists[i].SetInstanceOffset(transformData.size());
+			m_ShadowAnimGeometryLists[i].EmplaceInstanceTransforms(transformData, bonesOffsets);
+		}
 
 		m_TransformsStorage.Push(transformData.data(), transformData.size() * sizeof(InstanceTransformData));
+		m_BonesOffsetsSBO.Push(bonesOffsets.data(), bonesOffsets.size() * sizeof(uint32));
+	}
+
+	void SceneRenderer::CullShadowCasters()
+	{
+		ATN_PROFILE_FUNC();
+
+		if (!m_DirShadowsEnabled)
+			return;
+
+		// Bit per cascade. Visibility is tested in parallel, but draw calls are pushed
+		// on this thread, because draw lists are not thread safe.
+		auto& staticMasks = m_StaticShadowCasterMasks;
+		auto& animMasks = m_AnimShadowCasterMasks;
+
+		staticMasks.resize(m_StaticShadowCasters.size());
+		animMasks.resize(m_AnimShadowCasters.size());
+
+		auto cullCasters = [this](const auto& casters, std::vector<uint8>& masks)
+		{
+			uint32 count = casters.size();
+			JobSystem::ParallelFor(count, JobSystem::GetBatchSize(count, 256), [this, &casters, &masks](uint32 begin, uint32 end)
+			{
+				for (uint32 i = begin; i < end; ++i)
+				{
+					uint8 mask = 0;
+					for (uint32 cascade = 0; cascade < ShaderDef::SHADOW_CASCADES_COUNT; ++cascade)
+					{
+						if (m_CascadeFrustums[cascade].IsVisible(casters[i].BoundingBox))
+							mask |= 1 << cascade;
+					}
+
+					masks[i] = mask;
+				}
+			});
+		};
+
+		cullCasters(m_StaticShadowCasters, staticMasks);
+		cullCasters(m_AnimShadowCasters, animMasks);
+
+		for (uint32 cascade = 0; cascade < ShaderDef::SHADOW_CASCADES_COUNT; ++cascade)
+		{
+			for (uint32 i = 0; i < m_StaticShadowCasters.size(); ++i)
+			{
+				if (staticMasks[i] & (1 << cascade))
+					m_ShadowStaticGeometryLists[cascade].Push(m_StaticShadowCasters[i].DrawCall);
+			}
+
+			for (uint32 i = 0; i < m_AnimShadowCasters.size(); ++i)
+			{
+				if (animMasks[i] & (1 << cascade))
+					m_ShadowAnimGeometryLists[cascade].Push(m_AnimShadowCasters[i].DrawCall);
+			}
+
+			m_ShadowStaticGeometryLists[cascade].Sort(m_CameraData.Position);
+			m_ShadowAnimGeometryLists[cascade].Sort(m_CameraData.Position);
+		}
+	}
+
+	void SceneRenderer::CullRenderProxies()
+	{
+		ATN_PROFILE_FUNC();
+
+		const auto& bounds = m_RenderProxies->GetInstanceBounds();
+		const auto& uvDensities = m_RenderProxies->GetInstanceUVDensities();
+		const uint32 count = bounds.size();
+		const bool cullCascades = m_DirShadowsEnabled;
+
+		m_RenderProxyVisibility.resize(count);
+		m_RenderProxyScreenSizes.resize(count);
+
+		JobSystem::ParallelFor(count, JobSystem::GetBatchSize(count, 256), [this, &bounds, &uvDensities, cullCascades](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+			{
+				uint8 mask = m_CameraFrustum.IsVisible(bounds[i]) ? 1 : 0;
+
+				m_RenderProxyScreenSizes[i] = mask ? TextureStreamer::GetUVScreenSize(bounds[i], uvDensities[i], m_CameraData.Position, m_ProjectionScale) : 0.f;
+
+				if (cullCascades)
+				{
+					for (uint32 cascade = 0; cascade < ShaderDef::SHADOW_CASCADES_COUNT; ++cascade)
+					{
+						if (m_CascadeFrustums[cascade].IsVisible(bounds[i]))
+							mask |= 1 << (cascade + 1);
+					}
+				}
+
+				m_RenderProxyVisibility[i] = mask;
+			}
+		});
+
+		for (const auto& batch : m_RenderProxies->GetBatches())
+		{
+			const bool castShadows = cullCascades && batch.Material->GetFlag(MaterialFlag::CAST_SHADOWS);
+			float screenSize = 0.f;
+
+			for (uint32 slot = batch.FirstInstance; slot < batch.FirstInstance + batch.InstanceCount; ++slot)
+			{
+				uint8 mask = m_RenderProxyVisibility[slot];
+				screenSize = Math::Max(screenSize, m_RenderProxyScreenSizes[slot]);
+
+				if (mask & 1)
+					m_Statistics.Meshes++;
+				else
+					m_Statistics.CulledMeshes++;
+
+				if (castShadows)
+				{
+					uint32 cascades = std::popcount(uint32(mask >> 1));
+					m_Statistics.ShadowCasters += cascades;
+					m_Statistics.CulledShadowCasters += ShaderDef::SHADOW_CASCADES_COUNT - cascades;
+				}
+			}
+
+			if (screenSize > 0.f)
+				TextureStreamer::RequestMaterial(batch.Material, screenSize);
+		}
 	}
 
 	void SceneRenderer::ResetStats()
@@ -15,8 +15,10 @@
 #include "Athena/Renderer/Material.h"
 #include "Athena/Renderer/Light.h"
 #include "Athena/Renderer/DrawList.h"
+#include "Athena/Renderer/Frustum.h"
 #include "Athena/Renderer/Pipeline.h"
 #include "Athena/Renderer/Mesh.h"
+#include "Athena/Renderer/RenderProxyRegistry.h"
 #include "Athena/Renderer/SceneRenderer2D.h"
 
 #include "Athena/Math/Matrix.h"
@@ -138,6 +140,7 @@ namespace Athena
 		float EnvironmentLOD;
 		int32 DebugShadowCascades;
 		int32 DebugLightComplexity;
+		int32 EnvironmentIrradianceSH;
 	};
 
 	struct LightData
@@ -224,6 +227,14 @@ namespace Athena
 		uint32 Meshes;
 		uint32 Instances;
 		uint32 AnimMeshes;
+		uint32 CulledMeshes;
+		uint32 CulledAnimMeshes;
+		uint32 ShadowCasters;
+		uint32 CulledShadowCasters;
+
+		// Instance transforms and bones, memory of all frames in flight
+		uint64 DynamicBuffersMemory;
+		uint64 DynamicBuffersUpload;
 	};
 
 	using Render2DCallback = std::function<void()>;
@@ -252,6 +263,9 @@ namespace Athena
 
 		void SubmitSelectionContext(const Ref<StaticMesh>& mesh, const Matrix4& transform = Matrix4::Identity());
 
+		// Retained static meshes, culled and drawn from their own instance buffer
+		void SubmitRenderProxies(const Ref<RenderProxyRegistry>& proxies);
+
 		void SetOnRender2DCallback(const Render2DCallback& callback);
 		void SetOnViewportResizeCallback(const OnViewportResizeCallback& callback);
 
@@ -261,6 +275,7 @@ namespace Athena
 
 		Ref<RenderPass> GetGBufferPass() { return m_GBufferPass; }
 		Ref<RenderPass> GetRender2DPass() { return m_Render2DPass; }
+		Ref<RenderCommandBuffer> GetRender2DCommandBuffer() { return m_Render2DCommandBuffer; }
 		Ref<RenderPass> GetAOPass() { return m_HBAOBlurYPass; }
 		Ref<Pipeline> GetSkyboxPipeline() { return m_SkyboxPipeline; }
 
@@ -284,13 +299,37 @@ namespace Athena
 		void FXAAPass();
 		void SMAAPass();
 
+		// Record contents of passes to secondary command buffers
+		void RecordDirShadowMapPass();
+		void RecordGBufferPass();
+		void RecordRender2DPass();
+
 		void CalculateInstanceTransforms();
 		void CalculateCascadeLightSpaces(DirectionalLight& light);
+		void CullShadowCasters();
+		void CullRenderProxies();
 
 		void ResetStats();
 
-		void SubmitStaticMesh(DrawListStatic& list, const Ref<StaticMesh>& mesh, const Matrix4& transform);
-		void SubmitAnimMesh(DrawListAnim& list, const Ref<StaticMesh>& mesh, const Ref<Animator>& animator, const Matrix4& transform);
+		// If 'cull' is true, submeshes are culled by camera frustum and recorded as shadow casters
+		void SubmitStaticMesh(DrawListStatic& list, const Ref<StaticMesh>& mesh, const Matrix4& transform, bool cull);
+		void SubmitAnimMesh(DrawListAnim& list, const Ref<StaticMesh>& mesh, const Ref<Animator>& animator, const Matrix4& transform, bool cull);
+		// Requests mips of streamed material textures for visible submesh
+		void RequestTextureMips(const Ref<Material>& material, const AABB& boundingBox, float uvDensity, const Matrix4& transform);
+
+	private:
+		// Bounding box is in world space
+		struct StaticShadowCaster
+		{
+			StaticDrawCall DrawCall;
+			AABB BoundingBox;
+		};
+
+		struct AnimShadowCaster
+		{
+			AnimDrawCall DrawCall;
+			AABB BoundingBox;
+		};
 
 	private:
 		const uint32 m_ShadowMapResolution = 2048;
@@ -306,12 +345,30 @@ namespace Athena
 		DrawListStatic m_SelectStaticGeometryList;
 		DrawListAnim m_SelectAnimGeometryList;
 
+		// Shadow casters are culled per cascade in EndScene, when light spaces are known
+		std::vector<StaticShadowCaster> m_StaticShadowCasters;
+		std::vector<AnimShadowCaster> m_AnimShadowCasters;
+		std::vector<uint8> m_StaticShadowCasterMasks;
+		std::vector<uint8> m_AnimShadowCasterMasks;
+		DrawListStatic m_ShadowStaticGeometryLists[ShaderDef::SHADOW_CASCADES_COUNT];
+		DrawListAnim m_ShadowAnimGeometryLists[ShaderDef::SHADOW_CASCADES_COUNT];
+
+		// Bit 0 - camera, bit (1 + i) - cascade i, indexed by instance slot
+		Ref<RenderProxyRegistry> m_RenderProxies;
+		std::vector<uint8> m_RenderProxyVisibility;
+		// Screen size of uv range for streamed textures, 0 for culled slots
+		std::vector<float> m_RenderProxyScreenSizes;
+
 		// Render Passes
 		Ref<RenderPass> m_DirShadowMapPass;
+		Ref<RenderCommandBuffer> m_DirShadowMapCommandBuffer;
 		Ref<Pipeline> m_DirShadowMapStaticPipeline;
 		Ref<Pipeline> m_DirShadowMapAnimPipeline;
+		Ref<Material> m_DirShadowMapStaticMaterial;
+		Ref<Material> m_DirShadowMapAnimMaterial;
 
 		Ref<RenderPass> m_GBufferPass;
+		Ref<RenderCommandBuffer> m_GBufferCommandBuffer;
 		Ref<Pipeline> m_StaticGeometryPipeline;
 		Ref<Pipeline> m_AnimGeometryPipeline;
 
@@ -371,6 +428,7 @@ namespace Athena
 		Ref<Material> m_JumpFloodCompositeMaterial;
 
 		Ref<RenderPass> m_Render2DPass;
+		Ref<RenderCommandBuffer> m_Render2DCommandBuffer;
 		Render2DCallback m_Render2DCallback;
 
 		Ref<Texture2D> m_PostProcessTextures[2];
@@ -393,18 +451,30 @@ namespace Athena
 		HBAOData m_HBAOData;
 		SSRData m_SSRData;
 		uint32 m_BonesDataOffset;
+		// Offset of each animator bones uploaded this frame
+		std::unordered_map<const Animator*, uint32> m_AnimatorBonesOffsets;
+		Frustum m_CameraFrustum;
+		// Pixels per world unit at distance 1
+		float m_ProjectionScale = 1.f;
+		Frustum m_CascadeFrustums[ShaderDef::SHADOW_CASCADES_COUNT];
+		bool m_DirShadowsEnabled = false;
+		uint32 m_CulledMeshes = 0;
+		uint32 m_CulledAnimMeshes = 0;
 
 		// GPU Data
 		Ref<UniformBuffer> m_CameraUBO;
 		Ref<UniformBuffer> m_RendererUBO;
 		Ref<StorageBuffer> m_LightSBO;
 		Ref<StorageBuffer> m_VisibleLightsSBO;
+		// Bound when environment has no SH irradiance, never read by shaders
+		Ref<StorageBuffer> m_EmptyIrradianceSHSBO;
 		Ref<UniformBuffer> m_ShadowsUBO;
 		Ref<UniformBuffer> m_HBAO_UBO;
 		Ref<UniformBuffer> m_SSR_UBO;
 		Ref<TextureView> m_ShadowMapSampler;
 
 		DynamicGPUBuffer<StorageBuffer> m_BonesSBO;
+		DynamicGPUBuffer<StorageBuffer> m_BonesOffsetsSBO;
 		DynamicGPUBuffer<VertexBuffer> m_TransformsStorage;
 
 		// Other
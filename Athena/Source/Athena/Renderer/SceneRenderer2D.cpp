@@ -12,10 +12,10 @@
 
 namespace Athena
 {
-	Ref<SceneRenderer2D> SceneRenderer2D::Create(const Ref<RenderPass>& renderPass)
+	Ref<SceneRenderer2D> SceneRenderer2D::Create(const Ref<RenderPass>& renderPass, const Ref<RenderCommandBuffer>& commandBuffer)
 	{
 		Ref<SceneRenderer2D> result = Ref<SceneRenderer2D>::Create();
-		result->Init(renderPass);
+		result->Init(renderPass, commandBuffer);
 
 		return result;
 	}
@@ -25,9 +25,9 @@ namespace Athena
 		Shutdown();
 	}
 
-	void SceneRenderer2D::Init(const Ref<RenderPass>& renderPass)
+	void SceneRenderer2D::Init(const Ref<RenderPass>& renderPass, const Ref<RenderCommandBuffer>& commandBuffer)
 	{
-		
+		m_RenderCommandBuffer = commandBuffer;
 		m_IndicesCount.resize(Renderer::GetFramesInFlight());
 
 		IndexBufferCreateInfo indexBufferInfo;
@@ -183,7 +183,6 @@ namespace Athena
 	void SceneRenderer2D::BeginScene(const Matrix4& viewMatrix, const Matrix4& projectionMatrix)
 	{
 		m_BeginScene = true;
-		m_RenderCommandBuffer = Renderer::GetRenderCommandBuffer();
 
 		Matrix4 viewProj = viewMatrix * projectionMatrix;
 
@@ -331,9 +330,15 @@ namespace Athena
 				offset += 4;
 			}
 
+			uint64 capacity = m_IndexBuffer.GetCapacity();
+
 			m_IndexBuffer.Push(indices, maxIndices * sizeof(uint32));
 			m_IndexBuffer.Flush();
 
+			// Buffers of other frames are recreated empty on reallocation
+			if (m_IndexBuffer.GetCapacity() != capacity)
+				std::fill(m_IndicesCount.begin(), m_IndicesCount.end(), 0);
+
 			delete[] indices;
 		}
 
@@ -103,10 +103,11 @@ namespace Athena
 	class ATHENA_API SceneRenderer2D : public RefCounted
 	{
 	public:
-		static Ref<SceneRenderer2D> Create(const Ref<RenderPass>& renderPass);
+		// Commands are recorded to 'commandBuffer' inside 'renderPass'
+		static Ref<SceneRenderer2D> Create(const Ref<RenderPass>& renderPass, const Ref<RenderCommandBuffer>& commandBuffer);
 		~SceneRenderer2D();
 
-		void Init(const Ref<RenderPass>& renderPass);
+		void Init(const Ref<RenderPass>& renderPass, const Ref<RenderCommandBuffer>& commandBuffer);
 		void Shutdown();
 
 		void OnViewportResize(uint32 width, uint32 height);
@@ -1,5 +1,7 @@
 #include "Shader.h"
 
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Core/Time.h"
 #include "Athena/Renderer/Renderer.h"
 
 #include "Athena/Platform/Vulkan/VulkanShader.h"
@@ -31,6 +33,17 @@ namespace Athena
 		return nullptr;
 	}
 
+	Ref<Shader> Shader::CreateDeferred(const FilePath& path, const String& name)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case Renderer::API::Vulkan: return Ref<VulkanShader>::Create(path, name, false);
+		case Renderer::API::None: return nullptr;
+		}
+
+		return nullptr;
+	}
+
 	void Shader::AddOnReloadCallback(uint64 hash, const std::function<void()>& callback)
 	{
 		ATN_CORE_ASSERT(!m_OnReloadCallbacks.contains(hash));
@@ -53,20 +66,45 @@ namespace Athena
 	}
 
 	void ShaderPack::LoadDirectory(const FilePath& path)
+	{
+		ATN_PROFILE_FUNC();
+
+		Timer timer;
+
+		std::vector<FilePath> paths;
+		CollectShaderPaths(path, paths);
+
+		std::vector<Ref<Shader>> shaders(paths.size());
+		for (uint32 i = 0; i < paths.size(); ++i)
+			shaders[i] = Shader::CreateDeferred(paths[i], paths[i].stem().string());
+
+		// Compilation and reflection do not touch Vulkan objects
+		JobSystem::ParallelFor(shaders.size(), 1, [&shaders](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+				shaders[i]->Compile(false);
+		});
+
+		for (const auto& shader : shaders)
+		{
+			shader->Bake();
+			Add(shader->GetName(), shader);
+		}
+
+		ATN_CORE_TIMING_TAG("Renderer", "Loaded {} shaders from '{}' in {}", shaders.size(), path, timer.ElapsedTime());
+	}
+
+	void ShaderPack::CollectShaderPaths(const FilePath& path, std::vector<FilePath>& paths)
 	{
 		for (const auto& dirEntry : std::filesystem::directory_iterator(path))
 		{
 			const FilePath& path = dirEntry.path();
 
 			if (dirEntry.is_directory())
-				LoadDirectory(path);
+				CollectShaderPaths(path, paths);
 
 			if (path.extension() == ".glsl" || path.extension() == ".hlsl")
-			{
-				String name = path.stem().string();
-				Ref<Shader> shader = Shader::Create(path, name);
-				Add(name, shader);
-			}
+				paths.push_back(path);
 		}
 	}
 
@@ -103,8 +141,33 @@ namespace Athena
 
 	void ShaderPack::Reload()
 	{
+		ATN_PROFILE_FUNC();
+
+		Timer timer;
+
+		std::vector<Ref<Shader>> shaders;
+		shaders.reserve(m_Shaders.size());
 		for (const auto& [key, shader] : m_Shaders)
-			shader->Reload();
+			shaders.push_back(shader);
+
+		std::vector<uint8> needBake(shaders.size());
+		JobSystem::ParallelFor(shaders.size(), 1, [&shaders, &needBake](uint32 begin, uint32 end)
+		{
+			for (uint32 i = begin; i < end; ++i)
+				needBake[i] = shaders[i]->Compile(false);
+		});
+
+		uint32 reloadedCount = 0;
+		for (uint32 i = 0; i < shaders.size(); ++i)
+		{
+			if (!needBake[i])
+				continue;
+
+			shaders[i]->Bake();
+			reloadedCount++;
+		}
+
+		ATN_CORE_TIMING_TAG("Renderer", "Reloaded {} of {} shaders in {}", reloadedCount, shaders.size(), timer.ElapsedTime());
 	}
 
 	bool ShaderPack::IsCompiled() const
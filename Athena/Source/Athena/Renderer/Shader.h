@@ -87,9 +87,16 @@ namespace Athena
 	public:
 		static Ref<Shader> Create(const FilePath& path);
 		static Ref<Shader> Create(const FilePath& path, const String& name);
+		// Shader is not compiled, Compile can be called from any thread, then Bake from main thread
+		static Ref<Shader> CreateDeferred(const FilePath& path, const String& name);
 
 		virtual ~Shader() = default;
 
+		// Returns false if baked shader is up to date with its sources and nothing has to be baked
+		virtual bool Compile(bool forceCompile) = 0;
+		virtual void Bake() = 0;
+
+		// Recompiles only if shader file, its includes or global macroses have changed
 		virtual void Reload() = 0;
 		virtual bool IsCompute() = 0;
 
@@ -132,6 +139,7 @@ namespace Athena
 
 	private:
 		void LoadDirectory(const FilePath& path);
+		void CollectShaderPaths(const FilePath& path, std::vector<FilePath>& paths);
 
 	private:
 		std::map<String, Ref<Shader>> m_Shaders;
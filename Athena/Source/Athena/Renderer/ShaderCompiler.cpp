@@ -3,11 +3,13 @@
 #include "Athena/Core/FileSystem.h"
 #include "Athena/Core/Time.h"
 #include "Athena/Renderer/Renderer.h"
-
-#include <xhash>
+#include "Athena/Utils/HashUtils.h"
 
 #include <shaderc/shaderc.hpp>
 #include <spirv_cross/spirv_cross.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
 
 
 namespace Athena
@@ -19,6 +21,13 @@ namespace Athena
 	ATN_CORE_ERROR_TAG("Renderer", "Shader '{}'({}) compilation failed, error message:\n{}\n", name, Utils::ShaderStageToString(stage), errorMsg)
 
 
+	// Bump when cache layout changes, invalidates all manifests
+	static constexpr uint32 s_ShaderCacheVersion = 1;
+
+	// Must be kept in sync with options in CompileAndWriteToCache
+	static constexpr std::string_view s_CompileOptionsSignature = "vulkan1.3;spirv1.6;optimization_performance;debug_info;hlsl_auto_sampled_textures";
+
+
 	namespace Utils
 	{
 		static shaderc_shader_kind ShaderStageToShaderCKind(ShaderStage stage)
@@ -275,35 +284,80 @@ namespace Athena
 		if (m_Language == ShaderLanguage::NONE)
 			return false;
 
-		Timer compilationTimer;
+		const uint64 environmentHash = GetEnvironmentHash();
+
+		CacheManifest oldManifest;
+		bool hasManifest = ReadManifest(oldManifest);
+
+		// Nothing changed since last compilation, skip include processing
+		if (!forceCompile && hasManifest && IsManifestValid(oldManifest, environmentHash))
+		{
+			bool readResult = true;
+			for (const auto& [stage, cachePath] : oldManifest.Stages)
+			{
+				readResult = ReadFromCache(stage, cachePath);
+				if (!readResult)
+					break;
+			}
+
+			if (readResult)
+				return true;
+
+			m_SPIRVBinaries.clear();
+		}
 
 		PreProcessResult result = PreProcess();
 
 		if (!result.ParseResult)
 			return false;
 
-		bool compiled = true;
-		result.NeedRecompile |= forceCompile;
+		for (auto& stageDesc : result.StageDescriptions)
+			stageDesc.NeedRecompile = forceCompile || !FileSystem::Exists(stageDesc.FilePathToCache);
 
-		if (result.NeedRecompile)
-		{
-			compiled = CompileAndWriteToCache(result);
-		}
-		else
+		if (!CompileAndWriteToCache(result))
+			return false;
+
+		CacheManifest manifest;
+		manifest.EnvironmentHash = environmentHash;
+
+		for (const auto& dependency : result.Dependencies)
+			manifest.Dependencies.push_back({ dependency, FileSystem::GetLastWriteTime(dependency) });
+
+		for (const auto& stageDesc : result.StageDescriptions)
+			manifest.Stages.push_back({ stageDesc.Stage, stageDesc.FilePathToCache });
+
+		// Binaries from previous compilation are not referenced anymore
+		if (hasManifest)
 		{
-			ReadFromCache(result);
+			for (const auto& [_, oldCachePath] : oldManifest.Stages)
+			{
+				auto iter = std::find_if(manifest.Stages.begin(), manifest.Stages.end(),
+					[&oldCachePath](const auto& stage) { return stage.second == oldCachePath; });
+
+				if (iter == manifest.Stages.end() && FileSystem::Exists(oldCachePath))
+					FileSystem::Remove(oldCachePath);
+			}
 		}
 
-		if (result.NeedRecompile)
-			ATN_CORE_INFO_TAG("Renderer", "Shader '{}' compilation took {}", m_Name, compilationTimer.ElapsedTime());
+		WriteManifest(manifest);
+
+		return true;
+	}
+
+	bool ShaderCompiler::IsCacheUpToDate()
+	{
+		if (m_Language == ShaderLanguage::NONE)
+			return false;
+
+		CacheManifest manifest;
+		if (!ReadManifest(manifest))
+			return false;
 
-		return compiled;
+		return IsManifestValid(manifest, GetEnvironmentHash());
 	}
 
 	bool ShaderCompiler::CompileAndWriteToCache(const PreProcessResult& result)
 	{
-		bool compiled = true;
-
 		shaderc::Compiler compiler;
 		shaderc::CompileOptions options;
 		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
@@ -327,8 +381,12 @@ namespace Athena
 			options.AddMacroDefinition(name, value);
 		}
 
-		for (const auto& [stage, cachePath, source] : result.StageDescriptions)
+		for (const auto& [stage, cachePath, source, needRecompile] : result.StageDescriptions)
 		{
+			// Other stages could have been changed by includes
+			if (!needRecompile && ReadFromCache(stage, cachePath))
+				continue;
+
 			String filePathStr = m_FilePath.string();
 
 			shaderc::PreprocessedSourceCompilationResult preResult =
@@ -337,8 +395,7 @@ namespace Athena
 			if (preResult.GetCompilationStatus() != shaderc_compilation_status_success)
 			{
 				COMPILATION_STAGE_FAILED_LOG(m_Name, stage, preResult.GetErrorMessage());
-				compiled = false;
-				break;
+				return false;
 			}
 
 			String preProcessedSource = String(preResult.begin(), preResult.end());
@@ -349,8 +406,7 @@ namespace Athena
 			if (module.GetCompilationStatus() != shaderc_compilation_status_success)
 			{
 				COMPILATION_STAGE_FAILED_LOG(m_Name, stage, module.GetErrorMessage());
-				compiled = false;
-				break;
+				return false;
 			}
 
 			m_SPIRVBinaries[stage] = std::vector<uint32>(module.cbegin(), module.cend());
@@ -360,18 +416,27 @@ namespace Athena
 			FileSystem::WriteFile(cachePath, (const char*)data.data(), data.size() * sizeof(uint32));
 		}
 
-		return compiled;
+		return true;
 	}
 
-	void ShaderCompiler::ReadFromCache(const PreProcessResult& result)
+	bool ShaderCompiler::ReadFromCache(ShaderStage stage, const FilePath& cachePath)
 	{
-		for (const auto& [stage, cachePath, source] : result.StageDescriptions)
-		{
-			Buffer bytes = FileSystem::ReadFileBinary(cachePath);
+		if (!FileSystem::Exists(cachePath))
+			return false;
+
+		Buffer bytes = FileSystem::ReadFileBinary(cachePath);
 
-			m_SPIRVBinaries[stage] = std::vector<uint32>(bytes.Size() / sizeof(uint32));
-			memcpy(m_SPIRVBinaries[stage].data(), bytes.Data(), bytes.Size());
+		if (bytes.Size() == 0 || bytes.Size() % sizeof(uint32) != 0)
+		{
+			bytes.Release();
+			return false;
 		}
+
+		m_SPIRVBinaries[stage] = std::vector<uint32>(bytes.Size() / sizeof(uint32));
+		memcpy(m_SPIRVBinaries[stage].data(), bytes.Data(), bytes.Size());
+
+		bytes.Release();
+		return true;
 	}
 
 	ShaderCompiler::PreProcessResult ShaderCompiler::PreProcess()
@@ -390,7 +455,8 @@ namespace Athena
 
 		result.StageDescriptions = ParseShaderStages();
 		result.ParseResult = !result.StageDescriptions.empty();
-		result.NeedRecompile = false;
+
+		const uint64 environmentHash = GetEnvironmentHash();
 
 		for (auto& stageDesc : result.StageDescriptions)
 		{
@@ -399,23 +465,17 @@ namespace Athena
 			if (includeResult == false)
 			{
 				result.ParseResult = false;
-				result.NeedRecompile = true;
 				break;
 			}
 
-			stageDesc.FilePathToCache = GetCacheFilePath(m_FilePath, stageDesc.Stage, stageDesc.Source);
-		}
-
-		if (result.ParseResult)
-		{
-			for (const auto& [_, path, __] : result.StageDescriptions)
+			for (const auto& includedFile : m_Includer.GetIncludedFiles())
 			{
-				if (!FileSystem::Exists(path))
-				{
-					result.NeedRecompile = true;
-					break;
-				}
+				if (std::find(result.Dependencies.begin(), result.Dependencies.end(), includedFile) == result.Dependencies.end())
+					result.Dependencies.push_back(includedFile);
 			}
+
+			// Source has includes resolved, so key covers whole include graph
+			stageDesc.FilePathToCache = GetCacheFilePath(stageDesc.Stage, stageDesc.Source, environmentHash);
 		}
 
 		return result;
@@ -496,9 +556,30 @@ namespace Athena
 		return result;
 	}
 
-	FilePath ShaderCompiler::GetCacheFilePath(const FilePath& path, ShaderStage stage, const String& source)
+	uint64 ShaderCompiler::GetEnvironmentHash() const
+	{
+		uint64 hash = Utils::HashFNV1a(s_CompileOptionsSignature);
+		hash = Utils::HashFNV1a(&m_Language, sizeof(m_Language), hash);
+
+		// Sort macroses to get same hash regardless of map iteration order
+		const auto& globalMacroses = Renderer::GetGlobalShaderMacroses();
+		std::vector<std::pair<String, String>> macroses(globalMacroses.begin(), globalMacroses.end());
+		std::sort(macroses.begin(), macroses.end());
+
+		for (const auto& [name, value] : macroses)
+		{
+			hash = Utils::HashFNV1a(name, hash);
+			hash = Utils::HashFNV1a("=", hash);
+			hash = Utils::HashFNV1a(value, hash);
+			hash = Utils::HashFNV1a(";", hash);
+		}
+
+		return hash;
+	}
+
+	FilePath ShaderCompiler::GetCacheFilePath(ShaderStage stage, const String& source, uint64 environmentHash) const
 	{
-		FilePath relativeToShaderPack = std::filesystem::relative(path, Renderer::GetShaderPackDirectory());
+		FilePath relativeToShaderPack = std::filesystem::relative(m_FilePath, Renderer::GetShaderPackDirectory());
 		FilePath cachedPath = Renderer::GetShaderCacheDirectory() / relativeToShaderPack;
 
 		switch (stage)
@@ -510,14 +591,104 @@ namespace Athena
 		default: ATN_CORE_ASSERT(false); return "";
 		}
 
-		size_t hash = std::hash<std::string>()(source);
-		String hashString = std::to_string(hash);
+		uint64 hash = Utils::HashFNV1a(&stage, sizeof(stage), environmentHash);
+		hash = Utils::HashFNV1a(source, hash);
 
-		cachedPath += hashString;
+		cachedPath += Utils::HashToString(hash);
 
 		return cachedPath;
 	}
 
+	FilePath ShaderCompiler::GetManifestPath() const
+	{
+		FilePath relativeToShaderPack = std::filesystem::relative(m_FilePath, Renderer::GetShaderPackDirectory());
+		FilePath manifestPath = Renderer::GetShaderCacheDirectory() / relativeToShaderPack;
+		manifestPath += L".manifest";
+
+		return manifestPath;
+	}
+
+	bool ShaderCompiler::ReadManifest(CacheManifest& manifest)
+	{
+		FilePath manifestPath = GetManifestPath();
+		if (!FileSystem::Exists(manifestPath))
+			return false;
+
+		try
+		{
+			YAML::Node data = YAML::LoadFile(manifestPath.string());
+
+			if (!data["Version"] || data["Version"].as<uint32>() != s_ShaderCacheVersion)
+				return false;
+
+			manifest.EnvironmentHash = data["Environment"].as<uint64>();
+
+			for (const auto& dependency : data["Dependencies"])
+				manifest.Dependencies.push_back({ dependency["Path"].as<String>(), dependency["WriteTime"].as<int64>() });
+
+			for (const auto& stage : data["Stages"])
+				manifest.Stages.push_back({ (ShaderStage)stage["Stage"].as<uint32>(), stage["CachePath"].as<String>() });
+		}
+		catch (const YAML::Exception& ex)
+		{
+			ATN_CORE_WARN_TAG("Renderer", "Failed to read shader cache manifest '{}', error: {}", manifestPath, ex.what());
+			return false;
+		}
+
+		return true;
+	}
+
+	void ShaderCompiler::WriteManifest(const CacheManifest& manifest)
+	{
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Version" << YAML::Value << s_ShaderCacheVersion;
+		out << YAML::Key << "Environment" << YAML::Value << manifest.EnvironmentHash;
+
+		out << YAML::Key << "Dependencies" << YAML::Value << YAML::BeginSeq;
+		for (const auto& [path, writeTime] : manifest.Dependencies)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Path" << YAML::Value << path.string();
+			out << YAML::Key << "WriteTime" << YAML::Value << writeTime;
+			out << YAML::EndMap;
+		}
+		out << YAML::EndSeq;
+
+		out << YAML::Key << "Stages" << YAML::Value << YAML::BeginSeq;
+		for (const auto& [stage, cachePath] : manifest.Stages)
+		{
+			out << YAML::BeginMap;
+			out << YAML::Key << "Stage" << YAML::Value << (uint32)stage;
+			out << YAML::Key << "CachePath" << YAML::Value << cachePath.string();
+			out << YAML::EndMap;
+		}
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		FileSystem::WriteFile(GetManifestPath(), out.c_str(), out.size());
+	}
+
+	bool ShaderCompiler::IsManifestValid(const CacheManifest& manifest, uint64 environmentHash)
+	{
+		if (manifest.EnvironmentHash != environmentHash || manifest.Stages.empty())
+			return false;
+
+		for (const auto& [path, writeTime] : manifest.Dependencies)
+		{
+			if (FileSystem::GetLastWriteTime(path) != writeTime)
+				return false;
+		}
+
+		for (const auto& [_, cachePath] : manifest.Stages)
+		{
+			if (!FileSystem::Exists(cachePath))
+				return false;
+		}
+
+		return true;
+	}
+
 	void ShaderCompiler::GetLanguageAndEntryPoints()
 	{
 		String extension = m_FilePath.extension().string();
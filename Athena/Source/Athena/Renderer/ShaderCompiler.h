@@ -16,6 +16,9 @@ namespace Athena
 		bool ProcessIncludes(String& source, ShaderStage stage);
 		void AddIncludeDir(const FilePath& path);
 
+		// Files included by last ProcessIncludes call, including shader file itself
+		const std::vector<FilePath>& GetIncludedFiles() const { return m_IncludedFiles; }
+
 	private:
 		bool ProcessIncludesRecursive(String& source, const FilePath& workingDir, bool* noIncludes);
 		bool IsFileAlreadyIncluded(const FilePath& path);
@@ -44,6 +47,8 @@ namespace Athena
 		ShaderCompiler(const FilePath& filepath, const String& name);
 
 		bool CompileOrGetFromCache(bool forceCompile = false);
+		// Checks manifest without preprocessing, true if cached binaries match current sources and macroses
+		bool IsCacheUpToDate();
 
 		std::string_view GetEntryPoint(ShaderStage stage) const;
 		const ShaderBinaries& GetBinaries() const { return m_SPIRVBinaries; }
@@ -56,25 +61,41 @@ namespace Athena
 			ShaderStage Stage;
 			FilePath FilePathToCache;
 			String Source;
+			bool NeedRecompile = false;
 		};
 
 		struct PreProcessResult
 		{
 			std::vector<StageDescription> StageDescriptions;
+			std::vector<FilePath> Dependencies;
 			bool ParseResult;
-			bool NeedRecompile;
+		};
+
+		// Describes cache state of all stages, stored next to cached binaries
+		struct CacheManifest
+		{
+			uint64 EnvironmentHash = 0;
+			std::vector<std::pair<FilePath, int64>> Dependencies;
+			std::vector<std::pair<ShaderStage, FilePath>> Stages;
 		};
 
 	private:
 		bool CompileAndWriteToCache(const PreProcessResult& result);
-		void ReadFromCache(const PreProcessResult& result);
+		bool ReadFromCache(ShaderStage stage, const FilePath& cachePath);
 
 		PreProcessResult PreProcess();
 		std::vector<StageDescription> ParseShaderStages();
 		std::vector<StageDescription> GetHLSLStageDescriptions();
 		std::vector<StageDescription> GetGLSLStageDescriptions();
 
-		FilePath GetCacheFilePath(const FilePath& path, ShaderStage stage, const String& source);
+		uint64 GetEnvironmentHash() const;
+		FilePath GetCacheFilePath(ShaderStage stage, const String& source, uint64 environmentHash) const;
+		FilePath GetManifestPath() const;
+
+		bool ReadManifest(CacheManifest& manifest);
+		void WriteManifest(const CacheManifest& manifest);
+		bool IsManifestValid(const CacheManifest& manifest, uint64 environmentHash);
+
 		void GetLanguageAndEntryPoints();
 
 	private:
@@ -1,6 +1,8 @@
 #include "Texture.h"
 
+#include "Athena/Asset/TextureCache.h"
 #include "Athena/Renderer/Renderer.h"
+#include "Athena/Renderer/TextureStreamer.h"
 #include "Athena/Platform/Vulkan/VulkanTexture2D.h"
 #include "Athena/Platform/Vulkan/VulkanTextureCube.h"
 #include "Athena/Platform/Vulkan/VulkanTextureView.h"
@@ -105,6 +107,15 @@ namespace Athena
 		return nullptr;
 	}
 
+	Texture2D::~Texture2D()
+	{
+		if (m_CacheKey != 0)
+			TextureCache::Remove(m_CacheKey, this);
+
+		if (m_Streamed)
+			TextureStreamer::Unregister(this);
+	}
+
 	Ref<TextureCube> TextureCube::Create(const TextureCreateInfo& info, Buffer data)
 	{
 		switch (Renderer::GetAPI())
@@ -32,6 +32,16 @@ namespace Athena
 		RGBA16F,
 		RGBA32F,
 
+		// Block compressed, 4x4 pixels per block
+		BC1,
+		BC1_SRGB,
+		BC3,
+		BC3_SRGB,
+		BC4,
+		BC5,
+		BC7,
+		BC7_SRGB,
+
 		//Depth/Stencil
 		DEPTH16,
 		DEPTH24STENCIL8,
@@ -164,6 +174,10 @@ namespace Athena
 		uint32 Height = 1;
 		uint32 Layers = 1;
 		bool GenerateMipMap = false;
+		// Initial data contains all mip levels one after another, so they are not generated on GPU
+		bool PrecomputedMips = false;
+		// Used with PrecomputedMips, image is allocated only for mips starting from this level, see TextureStreamer
+		uint32 FirstResidentMip = 0;
 		TextureSamplerCreateInfo Sampler;
 	};
 
@@ -177,7 +191,8 @@ namespace Athena
 		virtual void Resize(uint32 width, uint32 height) = 0;
 		virtual void SetSampler(const TextureSamplerCreateInfo& samplerInfo) = 0;
 
-		virtual void WriteContentToBuffer(Buffer* dstBuffer) = 0;
+		// Data contains mip levels [baseMip, baseMip + mipCount) one after another, each level contains all layers
+		virtual void WriteContentToBuffer(Buffer* dstBuffer, uint32 baseMip = 0, uint32 mipCount = 1) = 0;
 		virtual uint32 GetImageLayerCount() const = 0;
 
 		Vector2u GetMipSize(uint32 mip) const;
@@ -201,7 +216,11 @@ namespace Athena
 		static bool IsStencilFormat(TextureFormat format);
 		static bool IsColorFormat(TextureFormat format);
 		static bool IsHDRFormat(TextureFormat format);
+		static bool IsCompressedFormat(TextureFormat format);
 		static uint32 BytesPerPixel(TextureFormat format);
+		// Bytes per 4x4 block for compressed formats
+		static uint32 BytesPerBlock(TextureFormat format);
+		static uint64 GetImageSize(TextureFormat format, uint32 width, uint32 height);
 		static uint32 ChannelsNum(TextureFormat format);
 
 	protected:
@@ -214,6 +233,7 @@ namespace Athena
 	{
 	public:
 		static Ref<Texture2D> Create(const TextureCreateInfo& info, Buffer data = Buffer());
+		virtual ~Texture2D();
 
 		virtual TextureType GetType() const override { return TextureType::TEXTURE_2D; }
 
@@ -223,11 +243,38 @@ namespace Athena
 		virtual uint32 GetImageLayerCount() const override { return m_Info.Layers; }
 		const FilePath& GetFilePath() const { return m_FilePath; }
 
+		// Data contains mip levels [baseMip, baseMip + mipCount) one after another, can be called from any thread
+		virtual void UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount = 1) = 0;
+
+		// Streamed textures are registered in TextureStreamer, their resident mips depend on screen size
+		bool IsStreamed() const { return m_Streamed; }
+		// GPU image contains only mips starting from this level, mip indices of image and views are relative to it
+		uint32 GetResidentMip() const { return m_ResidentMip; }
+		// Replaces image with one that contains mips [mip, GetMipLevelsCount()), data contains these mips one after another.
+		// Main thread only, must not be called while command buffers are recorded
+		virtual void SetResidentMips(uint32 mip, const void* data, uint64 size) = 0;
+
+	protected:
+		uint32 m_ResidentMip = 0;
+
+	private:
+		// Replaces image and create info, used by TextureImporter::LoadAsync to swap placeholder image with loaded one.
+		// Main thread only, must not be called while command buffers are recorded
+		virtual void Recreate(const TextureCreateInfo& info, Buffer data) = 0;
+
 	private:
 		friend class TextureImporter;
+		friend class TextureCache;
+		friend class TextureStreamer;
 
 	private:
 		FilePath m_FilePath;
+		// Non zero if texture is registered in TextureCache
+		uint64 m_CacheKey = 0;
+		// Set if texture is registered in TextureStreamer
+		bool m_Streamed = false;
+		// Largest screen size of [0, 1] uv range requested since last TextureStreamer::Update
+		float m_RequestedScreenSize = 0.f;
 	};
 
 	class ATHENA_API TextureCube: public Texture
@@ -241,6 +288,9 @@ namespace Athena
 		virtual const String& GetName() const override { return m_Info.Name; }
 
 		virtual uint32 GetImageLayerCount() const override { return m_Info.Layers * 6; }
+
+		// Data contains mip levels [baseMip, baseMip + mipCount) one after another, each level contains all faces
+		virtual void UploadMips(const void* data, uint64 size, uint32 baseMip, uint32 mipCount = 1) = 0;
 	};
 
 	class ATHENA_API Texture2DInstance
@@ -308,6 +358,49 @@ namespace Athena
 		return false;
 	}
 
+	inline bool Texture::IsCompressedFormat(TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1:	  return true;
+		case TextureFormat::BC1_SRGB: return true;
+		case TextureFormat::BC3:	  return true;
+		case TextureFormat::BC3_SRGB: return true;
+		case TextureFormat::BC4:	  return true;
+		case TextureFormat::BC5:	  return true;
+		case TextureFormat::BC7:	  return true;
+		case TextureFormat::BC7_SRGB: return true;
+		}
+
+		return false;
+	}
+
+	inline uint32 Texture::BytesPerBlock(TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1:	  return 8;
+		case TextureFormat::BC1_SRGB: return 8;
+		case TextureFormat::BC3:	  return 16;
+		case TextureFormat::BC3_SRGB: return 16;
+		case TextureFormat::BC4:	  return 8;
+		case TextureFormat::BC5:	  return 16;
+		case TextureFormat::BC7:	  return 16;
+		case TextureFormat::BC7_SRGB: return 16;
+		}
+
+		ATN_CORE_ASSERT(false);
+		return 0;
+	}
+
+	inline uint64 Texture::GetImageSize(TextureFormat format, uint32 width, uint32 height)
+	{
+		if (IsCompressedFormat(format))
+			return (uint64)((width + 3) / 4) * ((height + 3) / 4) * BytesPerBlock(format);
+
+		return (uint64)width * height * BytesPerPixel(format);
+	}
+
 	inline uint32 Texture::BytesPerPixel(TextureFormat format)
 	{
 		switch (format)
@@ -345,12 +438,14 @@ namespace Athena
 		case TextureFormat::R8:			   
 		case TextureFormat::R8_SRGB:
 		case TextureFormat::R32F:
+		case TextureFormat::BC4:
 		case TextureFormat::DEPTH16:
 		case TextureFormat::DEPTH32F: 
 			return 1;
 		case TextureFormat::RG8:
 		case TextureFormat::RG8_SRGB:
 		case TextureFormat::RG16F:
+		case TextureFormat::BC5:
 		case TextureFormat::DEPTH24STENCIL8: 
 			return 2;
 		case TextureFormat::RGB8:
@@ -363,6 +458,12 @@ namespace Athena
 		case TextureFormat::RGBA8_SRGB:
 		case TextureFormat::RGBA16F:
 		case TextureFormat::RGBA32F:
+		case TextureFormat::BC1:
+		case TextureFormat::BC1_SRGB:
+		case TextureFormat::BC3:
+		case TextureFormat::BC3_SRGB:
+		case TextureFormat::BC7:
+		case TextureFormat::BC7_SRGB:
 			return 4;
 		}
 
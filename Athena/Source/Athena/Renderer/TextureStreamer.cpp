@@ -0,0 +1,358 @@
+#include "TextureStreamer.h"
+
+#include "Athena/Core/JobSystem.h"
+#include "Athena/Math/Common.h"
+#include "Athena/Math/Exponential.h"
+#include "Athena/Renderer/Renderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+
+namespace Athena
+{
+	// Mips of this size or smaller are always resident
+	static constexpr uint32 TailMipSize = 128;
+	// Mips that are not requested anymore stay resident for this number of frames, unless budget is exceeded
+	static constexpr uint64 EvictionDelayFrames = 120;
+	static constexpr uint32 MaxPendingLoads = 16;
+	// Limits staging memory and main thread time spent on uploads
+	static constexpr uint64 MaxLoadSizePerFrame = 32 * 1024 * 1024;
+	static constexpr uint32 MaxMipBias = 16;
+	// Part of VRAM budget that can be used when RendererConfig::TextureStreamingBudget is 0
+	static constexpr float VRAMBudgetFraction = 0.9f;
+
+	// Filled by job, applied to texture on main thread
+	struct MipLoadRequest : public RefCounted
+	{
+		uint32 FirstMip = 0;
+		std::vector<byte> Data;
+		std::atomic<bool> Done = false;
+	};
+
+	struct StreamedTexture
+	{
+		Texture2D* Texture = nullptr;
+		Ref<MappedFile> File;
+		std::vector<std::span<const byte>> Mips;
+		// Size of mips [i, mipLevels)
+		std::vector<uint64> MipChainSizes;
+		uint32 TailMip = 0;
+		uint32 RequestedMip = 0;
+		// Last frame when all resident mips were requested
+		uint64 LastUsedFrame = 0;
+		Ref<MipLoadRequest> PendingLoad;
+	};
+
+	struct TextureStreamerData
+	{
+		// Texture removes itself from map in destructor
+		std::unordered_map<Texture2D*, StreamedTexture> Textures;
+		std::mutex Mutex;
+		JobCounter Jobs;
+		uint64 FrameIndex = 0;
+		TextureStreamingStats Stats;
+	};
+
+	static TextureStreamerData s_Data;
+
+	using AcquiredTexture = std::pair<Ref<Texture2D>, StreamedTexture*>;
+
+	// Acquired textures can not be destroyed, so their entries stay valid after mutex is unlocked.
+	// References must be released without lock, because texture destructor locks it.
+	static void AcquireTextures(std::vector<AcquiredTexture>& textures)
+	{
+		std::unique_lock lock(s_Data.Mutex);
+
+		textures.reserve(s_Data.Textures.size());
+		for (auto& [texture, entry] : s_Data.Textures)
+		{
+			if (Ref<Texture2D> acquired = Ref<Texture2D>::TryAcquire(texture))
+				textures.emplace_back(acquired, &entry);
+		}
+	}
+
+	static uint32 GetRequestedMip(const Texture2D* texture, const StreamedTexture& entry, float screenSize)
+	{
+		// Not drawn since last update
+		if (screenSize <= 0.f)
+			return entry.TailMip;
+
+		// Mip with one texel per pixel
+		float textureSize = Math::Max(texture->GetWidth(), texture->GetHeight());
+		float mip = Math::Log2(textureSize / screenSize);
+
+		if (mip <= 0.f)
+			return 0;
+
+		return Math::Min((uint32)mip, entry.TailMip);
+	}
+
+	static uint64 GetBudget(uint64 residentMemory)
+	{
+		uint64 budget = Renderer::GetConfig().TextureStreamingBudget;
+		if (budget != 0)
+			return budget;
+
+		// Streamed mips can use memory that is left by other resources
+		uint64 vramBudget = Renderer::GetMemoryBudget() * VRAMBudgetFraction;
+		uint64 usage = Renderer::GetMemoryUsage();
+		uint64 otherUsage = usage > residentMemory ? usage - residentMemory : 0;
+
+		return vramBudget > otherUsage ? vramBudget - otherUsage : 0;
+	}
+
+	static void ScheduleLoad(StreamedTexture& entry, uint32 firstMip)
+	{
+		Ref<MipLoadRequest> request = Ref<MipLoadRequest>::Create();
+		request->FirstMip = firstMip;
+		entry.PendingLoad = request;
+
+		std::vector<std::span<const byte>> mips(entry.Mips.begin() + firstMip, entry.Mips.end());
+		uint64 size = entry.MipChainSizes[firstMip];
+
+		// Reading mapped file may block on page faults, so mips are copied outside of main thread
+		JobSystem::Schedule([request, file = entry.File, mips = std::move(mips), size]()
+		{
+			ATN_PROFILE_SCOPE("TextureStreamer::LoadMips");
+
+			request->Data.resize(size);
+
+			uint64 offset = 0;
+			for (const auto& mip : mips)
+			{
+				memcpy(request->Data.data() + offset, mip.data(), mip.size());
+				offset += mip.size();
+			}
+
+			request->Done.store(true, std::memory_order_release);
+		}, &s_Data.Jobs);
+	}
+
+	void TextureStreamer::Init()
+	{
+		s_Data.FrameIndex = 0;
+		s_Data.Stats = TextureStreamingStats();
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		JobSystem::Wait(s_Data.Jobs);
+
+		std::unique_lock lock(s_Data.Mutex);
+		s_Data.Textures.clear();
+	}
+
+	bool TextureStreamer::IsEnabled()
+	{
+		return Renderer::GetConfig().TextureStreaming;
+	}
+
+	uint32 TextureStreamer::GetTailMip(uint32 width, uint32 height, uint32 mipLevels)
+	{
+		uint32 size = Math::Max(width, height);
+
+		uint32 mip = 0;
+		while ((size >> mip) > TailMipSize && mip + 1 < mipLevels)
+			mip++;
+
+		return mip;
+	}
+
+	void TextureStreamer::Register(const Ref<Texture2D>& texture, const Ref<MappedFile>& file, const std::vector<std::span<const byte>>& mips)
+	{
+		StreamedTexture entry;
+		entry.Texture = texture.Raw();
+		entry.File = file;
+		entry.Mips = mips;
+		entry.TailMip = GetTailMip(texture->GetWidth(), texture->GetHeight(), mips.size());
+		entry.RequestedMip = entry.TailMip;
+
+		entry.MipChainSizes.resize(mips.size() + 1, 0);
+		for (int32 mip = mips.size() - 1; mip >= 0; --mip)
+			entry.MipChainSizes[mip] = entry.MipChainSizes[mip + 1] + mips[mip].size();
+
+		std::unique_lock lock(s_Data.Mutex);
+		s_Data.Textures[texture.Raw()] = std::move(entry);
+		texture->m_Streamed = true;
+	}
+
+	void TextureStreamer::Unregister(Texture2D* texture)
+	{
+		std::unique_lock lock(s_Data.Mutex);
+		s_Data.Textures.erase(texture);
+	}
+
+	void TextureStreamer::RequestMaterial(const Ref<Material>& material, float screenSize)
+	{
+		for (const auto& [name, texture] : material->GetStreamedTextures())
+			texture->m_RequestedScreenSize = Math::Max(texture->m_RequestedScreenSize, screenSize);
+	}
+
+	void TextureStreamer::Update()
+	{
+		ATN_PROFILE_FUNC();
+
+		if (!IsEnabled())
+			return;
+
+		s_Data.FrameIndex++;
+
+		std::vector<AcquiredTexture> textures;
+		AcquireTextures(textures);
+
+		uint64 residentMemory = 0;
+		uint32 pendingLoads = 0;
+
+		for (auto& [texture, entry] : textures)
+		{
+			if (entry->PendingLoad && entry->PendingLoad->Done.load(std::memory_order_acquire))
+			{
+				const auto& data = entry->PendingLoad->Data;
+				texture->SetResidentMips(entry->PendingLoad->FirstMip, data.data(), data.size());
+				entry->PendingLoad = nullptr;
+			}
+
+			if (entry->PendingLoad)
+				pendingLoads++;
+
+			entry->RequestedMip = GetRequestedMip(texture.Raw(), *entry, texture->m_RequestedScreenSize);
+			texture->m_RequestedScreenSize = 0.f;
+
+			if (entry->RequestedMip <= texture->GetResidentMip())
+				entry->LastUsedFrame = s_Data.FrameIndex;
+
+			residentMemory += entry->MipChainSizes[texture->GetResidentMip()];
+		}
+
+		const uint64 budget = GetBudget(residentMemory);
+
+		// Requested mips of all textures are lowered equally until they fit into budget
+		uint32 mipBias = 0;
+		uint64 requestedMemory = 0;
+		for (; mipBias <= MaxMipBias; ++mipBias)
+		{
+			uint64 memory = 0;
+			for (const auto& [texture, entry] : textures)
+				memory += entry->MipChainSizes[Math::Min(entry->RequestedMip + mipBias, entry->TailMip)];
+
+			if (mipBias == 0)
+				requestedMemory = memory;
+
+			if (memory <= budget)
+				break;
+		}
+
+		mipBias = Math::Min(mipBias, MaxMipBias);
+
+		const bool overBudget = residentMemory > budget;
+		const uint64 currentResidentMemory = residentMemory;
+
+		// Evictions read only small mips, so they are not limited
+		std::vector<std::pair<uint32, uint32>> loads;
+		for (uint32 i = 0; i < textures.size(); ++i)
+		{
+			auto& [texture, entry] = textures[i];
+			if (entry->PendingLoad)
+				continue;
+
+			uint32 targetMip = Math::Min(entry->RequestedMip + mipBias, entry->TailMip);
+			uint32 residentMip = texture->GetResidentMip();
+
+			if (targetMip > residentMip)
+			{
+				if (overBudget || s_Data.FrameIndex - entry->LastUsedFrame > EvictionDelayFrames)
+				{
+					ScheduleLoad(*entry, targetMip);
+					pendingLoads++;
+				}
+			}
+			else if (targetMip < residentMip)
+			{
+				loads.push_back({ residentMip - targetMip, i });
+			}
+		}
+
+		// The most blurred textures are loaded first
+		std::sort(loads.begin(), loads.end(), [](const auto& left, const auto& right) { return left.first > right.first; });
+
+		uint64 scheduledSize = 0;
+		for (const auto& [missingMips, index] : loads)
+		{
+			if (pendingLoads >= MaxPendingLoads || scheduledSize >= MaxLoadSizePerFrame)
+				break;
+
+			auto& [texture, entry] = textures[index];
+			uint32 targetMip = texture->GetResidentMip() - missingMips;
+			uint64 extraMemory = entry->MipChainSizes[targetMip] - entry->MipChainSizes[texture->GetResidentMip()];
+
+			if (residentMemory + extraMemory > budget)
+				continue;
+
+			ScheduleLoad(*entry, targetMip);
+
+			residentMemory += extraMemory;
+			scheduledSize += entry->MipChainSizes[targetMip];
+			pendingLoads++;
+		}
+
+		s_Data.Stats.Budget = budget;
+		s_Data.Stats.ResidentMemory = currentResidentMemory;
+		s_Data.Stats.RequestedMemory = requestedMemory;
+		s_Data.Stats.TexturesCount = textures.size();
+		s_Data.Stats.PendingLoads = pendingLoads;
+		s_Data.Stats.MipBias = mipBias;
+	}
+
+	float TextureStreamer::GetUVScreenSize(const AABB& bounds, float uvDensity, const Vector3& cameraPosition, float projectionScale)
+	{
+		if (uvDensity <= 0.f)
+			return 0.f;
+
+		// Nearest point of bounds has the largest texels on screen
+		Vector3 nearestPoint = Math::Clamp(cameraPosition, bounds.GetMinPoint(), bounds.GetMaxPoint());
+		float distance = Math::Max((nearestPoint - cameraPosition).Length(), 0.001f);
+
+		// Pixels per world unit divided by uv units per world unit
+		return projectionScale / (distance * uvDensity);
+	}
+
+	float TextureStreamer::GetWorldUVDensity(float uvDensity, const Matrix4& transform)
+	{
+		// With non uniform scale the most stretched axis needs the highest resolution
+		float scale = 0.f;
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			Vector3 axis = transform[i];
+			scale = Math::Max(scale, axis.Length());
+		}
+
+		return scale > 0.f ? uvDensity / scale : 0.f;
+	}
+
+	TextureStreamingStats TextureStreamer::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+	void TextureStreamer::GetTexturesInfo(std::vector<StreamedTextureInfo>& info)
+	{
+		std::vector<AcquiredTexture> textures;
+		AcquireTextures(textures);
+
+		info.clear();
+		info.reserve(textures.size());
+
+		for (const auto& [texture, entry] : textures)
+		{
+			StreamedTextureInfo& textureInfo = info.emplace_back();
+			textureInfo.Name = texture->GetName();
+			textureInfo.Size = texture->GetSize();
+			textureInfo.MipLevels = entry->Mips.size();
+			textureInfo.ResidentMip = texture->GetResidentMip();
+			textureInfo.RequestedMip = entry->RequestedMip;
+			textureInfo.ResidentMemory = entry->MipChainSizes[textureInfo.ResidentMip];
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+#include "Athena/Core/FileSystem.h"
+#include "Athena/Math/Matrix.h"
+#include "Athena/Renderer/AABB.h"
+#include "Athena/Renderer/Material.h"
+#include "Athena/Renderer/Texture.h"
+
+#include <span>
+
+
+namespace Athena
+{
+	struct TextureStreamingStats
+	{
+		uint64 Budget = 0;
+		uint64 ResidentMemory = 0;
+		// Memory that requested mips would take without budget
+		uint64 RequestedMemory = 0;
+		uint32 TexturesCount = 0;
+		uint32 PendingLoads = 0;
+		// Added to requested mip of every texture to fit into budget
+		uint32 MipBias = 0;
+	};
+
+	struct StreamedTextureInfo
+	{
+		String Name;
+		Vector2u Size;
+		uint32 MipLevels = 0;
+		uint32 ResidentMip = 0;
+		uint32 RequestedMip = 0;
+		uint64 ResidentMemory = 0;
+	};
+
+	// Keeps in GPU memory only mips of streamed textures that are visible on screen.
+	// Draws request screen size of material textures, mips are read from mapped files on job system
+	// and images are replaced at the beginning of frame, while resident mips fit into budget.
+	class ATHENA_API TextureStreamer
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static bool IsEnabled();
+		// Smallest mips are always resident, texture is created with them
+		static uint32 GetTailMip(uint32 width, uint32 height, uint32 mipLevels);
+
+		// Mips point into 'file' and contain full mip chain. Can be called from any thread
+		static void Register(const Ref<Texture2D>& texture, const Ref<MappedFile>& file, const std::vector<std::span<const byte>>& mips);
+
+		// 'screenSize' - size in pixels of [0, 1] uv range on screen. Main thread only
+		static void RequestMaterial(const Ref<Material>& material, float screenSize);
+		// Applies loaded mips and schedules new loads and evictions, called by Renderer at the beginning of frame
+		static void Update();
+
+		// 'uvDensity' - uv units per world unit of surface inside 'bounds'
+		static float GetUVScreenSize(const AABB& bounds, float uvDensity, const Vector3& cameraPosition, float projectionScale);
+		static float GetWorldUVDensity(float uvDensity, const Matrix4& transform);
+
+		static TextureStreamingStats GetStats();
+		static void GetTexturesInfo(std::vector<StreamedTextureInfo>& info);
+
+	private:
+		static void Unregister(Texture2D* texture);
+
+		friend class Texture2D;
+	};
+}
@@ -36,13 +36,25 @@ namespace Athena
 		Quaternion Rotation = { 1.f, 0.f, 0.f, 0.f };
 		Vector3 Scale = { 1.f, 1.f, 1.f };
 
+		// Cached composition of Translation, Rotation and Scale,
+		// updated by Scene only when transform changes
+		Matrix4 Transform = Matrix4::Identity();
+
 		WorldTransformComponent() = default;
 		WorldTransformComponent(const Vector3& position)
-			: Translation(position) {}
+			: Translation(position) 
+		{
+			UpdateMatrix();
+		}
 
-		Matrix4 AsMatrix() const
+		const Matrix4& AsMatrix() const
 		{
-			return Math::ConstructTransform(Translation, Scale, Rotation);
+			return Transform;
+		}
+
+		void UpdateMatrix()
+		{
+			Transform = Math::ConstructTransform(Translation, Scale, Rotation);
 		}
 	};
 
@@ -61,6 +73,16 @@ namespace Athena
 			return Math::ConstructTransform(Translation, Scale, Rotation);
 		}
 
+		bool operator==(const TransformComponent& other) const
+		{
+			return Translation == other.Translation && Rotation == other.Rotation && Scale == other.Scale;
+		}
+
+		bool operator!=(const TransformComponent& other) const
+		{
+			return !(*this == other);
+		}
+
 		TransformComponent& UpdateLocalTransform(const WorldTransformComponent& newWorldTransform, const WorldTransformComponent& oldWorldTransform)
 		{
 			TransformComponent parentTransform;
@@ -123,24 +145,6 @@ namespace Athena
 		bool Shadowing = false;
 		float ShadowDistance = 1.f;
 		LinearColor ShadowColor = LinearColor::Black;
-
-		TextComponent() = default;
-		TextComponent(TextComponent&& other) = default;
-		TextComponent& operator=(TextComponent&& other) noexcept = default;
-
-		TextComponent(const TextComponent& other)
-		{
-			Font = Font::Create(other.Font->GetFilePath());
-			Text = other.Text;
-			Space = other.Space;
-			Color = other.Color;
-			MaxWidth = other.MaxWidth;
-			Kerning = other.Kerning;
-			LineSpacing = other.LineSpacing;
-			Shadowing = other.Shadowing;
-			ShadowDistance = other.ShadowDistance;
-			ShadowColor = other.ShadowColor;
-		}
 	};
 
 	struct CameraComponent
@@ -203,9 +207,10 @@ namespace Athena
 		StaticMeshComponent(StaticMeshComponent&& other) = default;
 		StaticMeshComponent& operator=(StaticMeshComponent&& other) noexcept = default;
 
+		// Mesh data is shared, only animation state is copied
 		StaticMeshComponent(const StaticMeshComponent& other)
 		{
-			Mesh = StaticMesh::Create(other.Mesh->GetFilePath());
+			Mesh = StaticMesh::Copy(other.Mesh);
 			Visible = other.Visible;
 		}
 	};
@@ -247,20 +252,12 @@ namespace Athena
 			EnvironmentMap = EnvironmentMap::Create(256);
 		}
 
+		// Settings are copied, baked textures are shared
 		SkyLightComponent(const SkyLightComponent& other)
 		{
+			EnvironmentMap = EnvironmentMap::Copy(other.EnvironmentMap);
 			LOD = other.LOD;
 			Intensity = other.Intensity;
-
-			const auto& otherEnv = other.EnvironmentMap;
-
-			EnvironmentMap = EnvironmentMap::Create(otherEnv->GetResolution());
-			EnvironmentMap->SetType(otherEnv->GetType());
-			EnvironmentMap->SetFilePath(otherEnv->GetFilePath());
-			float turbidity = otherEnv->GetTurbidity();
-			float azimuth = otherEnv->GetAzimuth();
-			float inclination = otherEnv->GetInclination();
-			EnvironmentMap->SetPreethamParams(turbidity, azimuth, inclination);
 		}
 
 		SkyLightComponent(SkyLightComponent&& other) noexcept
@@ -312,6 +309,12 @@ namespace Athena
 		camera.Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
 	}
 
+	template <>
+	inline void Scene::OnComponentRemove<StaticMeshComponent>(Entity entity, StaticMeshComponent& component)
+	{
+		RemoveRenderProxy(entity);
+	}
+
 	template <>
 	inline void Scene::OnComponentRemove<ScriptComponent>(Entity entity, ScriptComponent& component)
 	{
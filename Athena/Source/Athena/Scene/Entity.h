@@ -58,6 +58,15 @@ namespace Athena
 			m_Scene->m_Registry.remove<T>(m_EntityHandle);
 		}
 
+		// Must be called after component is modified in place, so scene can react to changes
+		template <typename T>
+		void PatchComponent()
+		{
+			ATN_CORE_ASSERT(HasComponent<T>(), "Entity does not have this component!");
+
+			m_Scene->m_Registry.patch<T>(m_EntityHandle);
+		}
+
 		template <typename T>
 		T& GetComponent()
 		{
@@ -1,5 +1,7 @@
 #include "Scene.h"
 
+#include "Athena/Core/JobSystem.h"
+
 #include "Athena/Renderer/Animation.h"
 #include "Athena/Renderer/Light.h"
 #include "Athena/Renderer/Material.h"
@@ -68,6 +70,14 @@ namespace Athena
 	}
 
 
+	// Links entity with its render proxy, is not copied with other components
+	struct RenderProxyComponent
+	{
+		RenderProxyID ID = RenderProxyRegistry::InvalidID;
+		const StaticMesh* Mesh = nullptr;
+	};
+
+
 	static b2BodyType AthenaRigidBody2DTypeToBox2D(Rigidbody2DComponent::BodyType type)
 	{
 		switch (type)
@@ -101,7 +111,10 @@ namespace Athena
 	Scene::Scene(const String& name)
 		: m_Name(name)
 	{
-		
+		m_RenderProxies = RenderProxyRegistry::Create();
+
+		m_Registry.on_construct<StaticMeshComponent>().connect<&Scene::OnStaticMeshChanged>(this);
+		m_Registry.on_update<StaticMeshComponent>().connect<&Scene::OnStaticMeshChanged>(this);
 	}
 
 	Scene::~Scene()
@@ -129,6 +142,21 @@ namespace Athena
 
 		CopyComponent(AllComponents{}, dstSceneRegistry, srcSceneRegistry, newScene->m_EntityMap);
 
+		// Copied relationships still point to entities of source scene
+		auto parents = dstSceneRegistry.view<ParentComponent>();
+		for (auto entity : parents)
+		{
+			Entity& parent = parents.get<ParentComponent>(entity).Parent;
+			parent = newScene->GetEntityByUUID(parent.GetID());
+		}
+
+		auto children = dstSceneRegistry.view<ChildComponent>();
+		for (auto entity : children)
+		{
+			for (Entity& child : children.get<ChildComponent>(entity).Children)
+				child = newScene->GetEntityByUUID(child.GetID());
+		}
+
 		return newScene;
 	}
 
@@ -141,6 +169,7 @@ namespace Athena
 		entity.AddComponent<WorldTransformComponent>();
 
 		m_EntityMap[id] = entity;
+		m_TransformHierarchy.Dirty = true;
 
 		return entity;
 	}
@@ -178,8 +207,11 @@ namespace Athena
 			DeleteFromChildren(parentChildren, parent, entity);
 		}
 
+		RemoveRenderProxy(entity);
+
 		m_EntityMap.erase(entity.GetID());
 		m_Registry.destroy(entity);
+		m_TransformHierarchy.Dirty = true;
 	}
 
 	Entity Scene::DuplicateEntity(Entity entity)
@@ -238,6 +270,8 @@ namespace Athena
 
 		auto& children = parent.GetComponent<ChildComponent>().Children;
 		children.push_back(child);
+
+		m_TransformHierarchy.Dirty = true;
 	}
 
 	void Scene::MakeOrphan(Entity child)
@@ -249,6 +283,8 @@ namespace Athena
 
 			DeleteFromChildren(parentChildren, parent, child);
 			child.RemoveComponent<ParentComponent>();
+
+			m_TransformHierarchy.Dirty = true;
 		}
 	}
 
@@ -426,46 +462,124 @@ namespace Athena
 		return Entity{};
 	}
 
-	void Scene::UpdateWorldTransforms()
+	void Scene::RebuildTransformHierarchy()
 	{
 		ATN_PROFILE_FUNC();
 
+		TransformHierarchy& hierarchy = m_TransformHierarchy;
+		hierarchy.Entities.clear();
+		hierarchy.ParentIndices.clear();
+		hierarchy.LevelOffsets.clear();
+
 		auto baseEntities = m_Registry.view<WorldTransformComponent, TransformComponent>(entt::exclude<ParentComponent>);
-		for (auto entt : baseEntities)
+		for (auto entity : baseEntities)
 		{
-			const TransformComponent& transform = baseEntities.get<TransformComponent>(entt);
-			WorldTransformComponent& worldTransform = baseEntities.get<WorldTransformComponent>(entt);
+			hierarchy.Entities.push_back(entity);
+			hierarchy.ParentIndices.push_back(TransformHierarchy::NoParent);
+		}
 
-			worldTransform.Translation = transform.Translation;
-			worldTransform.Rotation = transform.Rotation;
-			worldTransform.Scale = transform.Scale;
+		// Breadth-first traversal, each pass appends next level
+		uint32 levelStart = 0;
+		while (levelStart < hierarchy.Entities.size())
+		{
+			uint32 levelEnd = hierarchy.Entities.size();
+			hierarchy.LevelOffsets.push_back(levelStart);
 
-			Entity entity = { entt, this };
-			if (entity.HasComponent<ChildComponent>())
+			for (uint32 i = levelStart; i < levelEnd; ++i)
 			{
-				const std::vector<Entity>& children = entity.GetComponent<ChildComponent>().Children;
+				const ChildComponent* childComponent = m_Registry.try_get<ChildComponent>(hierarchy.Entities[i]);
+				if (!childComponent)
+					continue;
 
-				for(auto& child: children)
-					UpdateWorldTransform(child, worldTransform);
+				for (Entity child : childComponent->Children)
+				{
+					hierarchy.Entities.push_back(child);
+					hierarchy.ParentIndices.push_back(i);
+				}
 			}
+
+			levelStart = levelEnd;
 		}
+
+		hierarchy.LevelOffsets.push_back(hierarchy.Entities.size());
+		hierarchy.WorldTransforms.resize(hierarchy.Entities.size());
+		hierarchy.LocalTransforms.resize(hierarchy.Entities.size());
+		hierarchy.ChangedFlags.resize(hierarchy.Entities.size());
+		hierarchy.Dirty = false;
+		hierarchy.ForceUpdate = true;
 	}
 
-	void Scene::UpdateWorldTransform(Entity entity, const WorldTransformComponent& parentTransform)
+	void Scene::UpdateWorldTransforms()
 	{
-		const TransformComponent& localTransform = entity.GetComponent<TransformComponent>();
-		WorldTransformComponent& worldTransform = entity.GetComponent<WorldTransformComponent>();
+		ATN_PROFILE_FUNC();
 
-		worldTransform.Translation = parentTransform.Translation + parentTransform.Rotation * localTransform.Translation;
-		worldTransform.Rotation = parentTransform.Rotation * localTransform.Rotation;
-		worldTransform.Scale = parentTransform.Scale * localTransform.Scale;
+		if (m_TransformHierarchy.Dirty)
+			RebuildTransformHierarchy();
 
-		if (entity.HasComponent<ChildComponent>())
+		TransformHierarchy& hierarchy = m_TransformHierarchy;
+		auto& localTransforms = m_Registry.storage<TransformComponent>();
+		auto& worldTransforms = m_Registry.storage<WorldTransformComponent>();
+
+		const bool forceUpdate = hierarchy.ForceUpdate;
+
+		// Levels are processed in order, entities inside one level are independent
+		for (uint32 level = 0; level + 1 < hierarchy.LevelOffsets.size(); ++level)
 		{
-			const std::vector<Entity>& children = entity.GetComponent<ChildComponent>().Children;
+			const uint32 levelStart = hierarchy.LevelOffsets[level];
+			const uint32 levelSize = hierarchy.LevelOffsets[level + 1] - levelStart;
 
-			for (auto& child : children)
-				UpdateWorldTransform(child, worldTransform);
+			JobSystem::ParallelFor(levelSize, JobSystem::GetBatchSize(levelSize, 256), [&](uint32 begin, uint32 end)
+			{
+				for (uint32 i = levelStart + begin; i < levelStart + end; ++i)
+				{
+					entt::entity entity = hierarchy.Entities[i];
+					const TransformComponent& localTransform = localTransforms.get(entity);
+					const uint32 parentIndex = hierarchy.ParentIndices[i];
+
+					bool changed = forceUpdate || localTransform != hierarchy.LocalTransforms[i];
+					if (parentIndex != TransformHierarchy::NoParent)
+						changed = changed || hierarchy.ChangedFlags[parentIndex];
+
+					hierarchy.ChangedFlags[i] = changed;
+
+					if (!changed)
+						continue;
+
+					hierarchy.LocalTransforms[i] = localTransform;
+					WorldTransformComponent& worldTransform = hierarchy.WorldTransforms[i];
+
+					if (parentIndex == TransformHierarchy::NoParent)
+					{
+						worldTransform.Translation = localTransform.Translation;
+						worldTransform.Rotation = localTransform.Rotation;
+						worldTransform.Scale = localTransform.Scale;
+					}
+					else
+					{
+						const WorldTransformComponent& parentTransform = hierarchy.WorldTransforms[parentIndex];
+
+						worldTransform.Translation = parentTransform.Translation + parentTransform.Rotation * localTransform.Translation;
+						worldTransform.Rotation = parentTransform.Rotation * localTransform.Rotation;
+						worldTransform.Scale = parentTransform.Scale * localTransform.Scale;
+					}
+
+					worldTransform.UpdateMatrix();
+					worldTransforms.get(entity) = worldTransform;
+				}
+			});
+		}
+
+		hierarchy.ForceUpdate = false;
+
+		auto& renderProxies = m_Registry.storage<RenderProxyComponent>();
+		if (renderProxies.empty())
+			return;
+
+		for (uint32 i = 0; i < hierarchy.Entities.size(); ++i)
+		{
+			entt::entity entity = hierarchy.Entities[i];
+			if (hierarchy.ChangedFlags[i] && renderProxies.contains(entity))
+				m_RenderProxies->SetTransform(renderProxies.get(entity).ID, hierarchy.WorldTransforms[i].AsMatrix());
 		}
 	}
 
@@ -547,6 +661,10 @@ namespace Athena
 			Vector3 eulerAngles = oldWorldTransform.Rotation.AsEulerAngles();
 			eulerAngles.z = body->GetAngle();
 			newWorldTransform.Rotation = Quaternion(eulerAngles);
+			newWorldTransform.UpdateMatrix();
+
+			if (const RenderProxyComponent* proxy = m_Registry.try_get<RenderProxyComponent>(entity))
+				m_RenderProxies->SetTransform(proxy->ID, newWorldTransform.AsMatrix());
 
 			rigidBodies2D.get<TransformComponent>(entity).UpdateLocalTransform(newWorldTransform, oldWorldTransform);
 		}
@@ -634,13 +752,17 @@ namespace Athena
 
 		renderer->BeginScene(cameraInfo);
 
+		SyncRenderProxies();
+		renderer->SubmitRenderProxies(m_RenderProxies);
+
+		// Animated meshes are submitted every frame
 		auto staticMeshes = GetAllEntitiesWith<StaticMeshComponent, WorldTransformComponent>();
 		for (auto entity : staticMeshes)
 		{
 			const auto& transform = staticMeshes.get<WorldTransformComponent>(entity);
 			const auto& meshComponent = staticMeshes.get<StaticMeshComponent>(entity);
 
-			if (meshComponent.Visible)
+			if (meshComponent.Visible && meshComponent.Mesh->HasAnimations())
 			{
 				renderer->Submit(meshComponent.Mesh, transform.AsMatrix());
 			}
@@ -718,4 +840,62 @@ namespace Athena
 
 		renderer->EndScene();
 	}
+
+	void Scene::SyncRenderProxies()
+	{
+		ATN_PROFILE_FUNC();
+
+		if (m_ChangedStaticMeshes.empty())
+			return;
+
+		std::vector<entt::entity> changed;
+		changed.swap(m_ChangedStaticMeshes);
+
+		std::sort(changed.begin(), changed.end());
+		changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+		for (auto entity : changed)
+		{
+			// Entity or component could be removed after change
+			if (!m_Registry.valid(entity) || !m_Registry.all_of<StaticMeshComponent, WorldTransformComponent>(entity))
+				continue;
+
+			const auto& meshComponent = m_Registry.get<StaticMeshComponent>(entity);
+			RenderProxyComponent* proxy = m_Registry.try_get<RenderProxyComponent>(entity);
+
+			// Proxy of loading mesh is added when its submeshes are created
+			if (meshComponent.Mesh && meshComponent.Mesh->IsLoading())
+				m_ChangedStaticMeshes.push_back(entity);
+
+			bool retained = meshComponent.Visible && meshComponent.Mesh && !meshComponent.Mesh->IsLoading() && !meshComponent.Mesh->HasAnimations();
+
+			if (proxy && (!retained || proxy->Mesh != meshComponent.Mesh.Raw()))
+			{
+				RemoveRenderProxy(entity);
+				proxy = nullptr;
+			}
+
+			if (retained && !proxy)
+			{
+				const auto& transform = m_Registry.get<WorldTransformComponent>(entity);
+				RenderProxyID id = m_RenderProxies->AddStaticMesh(meshComponent.Mesh, transform.AsMatrix());
+
+				m_Registry.emplace<RenderProxyComponent>(entity, id, meshComponent.Mesh.Raw());
+			}
+		}
+	}
+
+	void Scene::RemoveRenderProxy(entt::entity entity)
+	{
+		if (const RenderProxyComponent* proxy = m_Registry.try_get<RenderProxyComponent>(entity))
+		{
+			m_RenderProxies->Remove(proxy->ID);
+			m_Registry.remove<RenderProxyComponent>(entity);
+		}
+	}
+
+	void Scene::OnStaticMeshChanged(entt::registry& registry, entt::entity entity)
+	{
+		m_ChangedStaticMeshes.push_back(entity);
+	}
 }
@@ -5,6 +5,7 @@
 #include "Athena/Core/UUID.h"
 
 #include "Athena/Renderer/EditorCamera.h"
+#include "Athena/Renderer/RenderProxyRegistry.h"
 #include "Athena/Renderer/SceneRenderer.h"
 
 #include "Athena/Scene/SceneCamera.h"
@@ -85,14 +86,19 @@ namespace Athena
 		}
 
 	private:
+		void RebuildTransformHierarchy();
 		void UpdateWorldTransforms();
-		void UpdateWorldTransform(Entity entity, const WorldTransformComponent& parentTransform);
 
 		void OnPhysics2DStart();
 		void UpdatePhysics(Time frameTime);
 
 		void RenderScene(const Ref<SceneRenderer>& renderer, const CameraInfo& cameraInfo);
 
+		// Adds, replaces or removes render proxies of changed static meshes
+		void SyncRenderProxies();
+		void RemoveRenderProxy(entt::entity entity);
+		void OnStaticMeshChanged(entt::registry& registry, entt::entity entity);
+
 		template <typename T>
 		void OnComponentAdd(Entity entity, T& component);
 
@@ -105,6 +111,34 @@ namespace Athena
 		entt::registry m_Registry;
 		std::unordered_map<UUID, entt::entity> m_EntityMap;
 
+		// Entities sorted by depth in hierarchy, parents always placed before children.
+		// Rebuilt only when relationships change.
+		struct TransformHierarchy
+		{
+			static constexpr uint32 NoParent = UINT32_MAX;
+
+			std::vector<entt::entity> Entities;
+			std::vector<uint32> ParentIndices;
+			// First index of each level, last element is Entities.size()
+			std::vector<uint32> LevelOffsets;
+			std::vector<WorldTransformComponent> WorldTransforms;
+
+			// Local transforms from last update, used to detect changes
+			std::vector<TransformComponent> LocalTransforms;
+			// Set if entity or any of its parents changed this frame
+			std::vector<uint8> ChangedFlags;
+
+			bool Dirty = true;
+			bool ForceUpdate = true;
+		};
+
+		TransformHierarchy m_TransformHierarchy;
+
+		// Static meshes are kept between frames, only changes are sent to renderer
+		Ref<RenderProxyRegistry> m_RenderProxies;
+		// Entities with added or patched StaticMeshComponent, loading meshes stay here until loaded
+		std::vector<entt::entity> m_ChangedStaticMeshes;
+
 		std::unique_ptr<b2World> m_PhysicsWorld;
 
 		uint32 m_ViewportWidth = 0, m_ViewportHeight = 0;
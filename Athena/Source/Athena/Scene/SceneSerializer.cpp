@@ -306,7 +306,7 @@ namespace Athena
 						const auto& path = FilePath(textureNode.as<String>());
 						if (!path.empty())
 						{
-							Ref<Texture2D> texture = TextureImporter::Load(path, true);
+							Ref<Texture2D> texture = TextureImporter::LoadAsync(path, true);
 							sprite.Texture = Texture2DInstance(texture, texCoords);
 						}
 						else
@@ -401,7 +401,7 @@ namespace Athena
 
 						FilePath path = staticMeshComponentNode["FilePath"].as<String>();
 
-						meshComp.Mesh = StaticMesh::Create(path);
+						meshComp.Mesh = StaticMesh::CreateAsync(path);
 						meshComp.Visible = staticMeshComponentNode["Visible"].as<bool>();
 					}
 				}
@@ -456,6 +456,9 @@ namespace Athena
 						envMap->SetType((EnvironmentMapType)skyLightComponent["Type"].as<uint32>());
 						envMap->SetFilePath(skyLightComponent["FilePath"].as<String>());
 
+						if (skyLightComponent["IrradianceMode"])
+							envMap->SetIrradianceMode((EnvironmentIrradianceMode)skyLightComponent["IrradianceMode"].as<uint32>());
+
 						float turbidity = skyLightComponent["Turbidity"].as<float>();
 						float azimuth = skyLightComponent["Azimuth"].as<float>();
 						float inclination = skyLightComponent["Inclination"].as<float>();
@@ -701,6 +704,7 @@ namespace Athena
 				output << YAML::Key << "Resolution" << envMap->GetResolution();
 				output << YAML::Key << "Type" << (int)envMap->GetType();
 				output << YAML::Key << "FilePath" << envMap->GetFilePath().string();
+				output << YAML::Key << "IrradianceMode" << (int)envMap->GetIrradianceMode();
 				output << YAML::Key << "Turbidity" << envMap->GetTurbidity();
 				output << YAML::Key << "Azimuth" << envMap->GetAzimuth();
 				output << YAML::Key << "Inclination" << envMap->GetInclination();
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Athena/Core/Core.h"
+
+#include <string_view>
+
+
+namespace Athena::Utils
+{
+	constexpr uint64 FNV1aOffsetBasis = 0xcbf29ce484222325;
+	constexpr uint64 FNV1aPrime = 0x100000001b3;
+
+	// Stable across runs and platforms, unlike std::hash, so it can be used for on-disk caches
+	inline uint64 HashFNV1a(const void* data, uint64 size, uint64 seed = FNV1aOffsetBasis)
+	{
+		const uint8* bytes = (const uint8*)data;
+
+		uint64 hash = seed;
+		for (uint64 i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FNV1aPrime;
+		}
+
+		return hash;
+	}
+
+	inline uint64 HashFNV1a(std::string_view str, uint64 seed = FNV1aOffsetBasis)
+	{
+		return HashFNV1a(str.data(), str.size(), seed);
+	}
+
+	inline String HashToString(uint64 hash)
+	{
+		return std::format("{:016x}", hash);
+	}
+}
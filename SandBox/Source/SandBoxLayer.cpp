@@ -13,7 +13,7 @@ void SandBoxLayer::OnAttach()
 {
 	m_SceneRenderer = SceneRenderer::Create();
 
-	m_Renderer2D = SceneRenderer2D::Create(m_SceneRenderer->GetRender2DPass());
+	m_Renderer2D = SceneRenderer2D::Create(m_SceneRenderer->GetRender2DPass(), m_SceneRenderer->GetRender2DCommandBuffer());
 	m_SceneRenderer->SetOnRender2DCallback(
 		[this]() { OnRender2D(); });
 	m_SceneRenderer->SetOnViewportResizeCallback(